@@ -0,0 +1,40 @@
+#version 330
+
+// Draws the level's tiles from the tilemap texture, which has one pixel per cell:
+// the tile type in the red channel (0 for no tile) and its rotation, in steps of 90 degrees, in the green.
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;         // the tilemap
+uniform vec4 colDiffuse;
+
+uniform sampler2D u_atlas;          // the atlas page with the tiles' sprites
+uniform vec2 u_atlas_size;          // in pixels
+uniform vec2 u_map_size;            // in cells
+uniform vec4 u_tile_sources[16];    // each tile type's region in the atlas, in pixels
+
+out vec4 finalColor;
+
+void main() {
+
+    vec2 cell_pos = fragTexCoord * u_map_size;
+    vec4 cell = texelFetch(texture0, ivec2(floor(cell_pos)), 0);
+
+    int tile = int(cell.r * 255.0 + 0.5);
+    if (tile == 0) discard;
+
+    int rotation = int(cell.g * 255.0 + 0.5);
+
+    // Where in the cell, turned back as the sprite is turned clockwise
+    vec2 local = fract(cell_pos);
+    vec2 uv = local;
+    if (rotation == 1)      uv = vec2(local.y, 1.0 - local.x);
+    else if (rotation == 2) uv = vec2(1.0 - local.x, 1.0 - local.y);
+    else if (rotation == 3) uv = vec2(1.0 - local.y, local.x);
+
+    vec4 source = u_tile_sources[tile - 1];
+    vec2 atlas_pos = source.xy + uv * source.zw;
+
+    finalColor = texture(u_atlas, atlas_pos / u_atlas_size) * colDiffuse * fragColor;
+}
@@ -2114,9 +2114,11 @@ int GuiToggleSprite(Rectangle bounds, Sprite *sprite, Vector2 pos, bool *active)
     }
 
     // Centralizes the sprite inside the button
-    pos.x += (bounds.width - (sprite->sprite.width * sprite->scale)) / 2;
-    pos.y += (bounds.height - (sprite->sprite.height * sprite->scale)) / 2;
-    DrawTextureEx(sprite->sprite, pos, 0, sprite->scale, WHITE);
+    pos.x += (bounds.width - (sprite->source.width * sprite->scale)) / 2;
+    pos.y += (bounds.height - (sprite->source.height * sprite->scale)) / 2;
+    DrawTexturePro(sprite->atlas, sprite->source,
+                    (Rectangle){ pos.x, pos.y, sprite->source.width * sprite->scale, sprite->source.height * sprite->scale },
+                    (Vector2){ 0, 0 }, 0, WHITE);
 
     if (state == STATE_FOCUSED) GuiTooltip(bounds);
     //--------------------------------------------------------------------
@@ -2,7 +2,7 @@
 
 #include <vector>
 
-#include "assets.hpp"
+#include "sprites.hpp"
 
 
 namespace Animation {
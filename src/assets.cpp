@@ -3,47 +3,29 @@
 
 #include "assets.hpp"
 #include "render.hpp"
+#include "sprite_atlas.hpp"
+#include "background.hpp"
 #include "text_bank.hpp"
 #include "level/textbox.hpp"
+#include "level/tilemap.hpp"
 
 
 struct SoundBank *SOUNDS = 0;
 
-struct SpriteBank *SPRITES = 0;
-
 // Shaders
 Shader ShaderLevelTransition;
 
 Shader ShaderCRT;
 
+Shader ShaderTilemap;
 
-static inline Sprite normalSizeSprite(std::string texturePath) {
-    return {
-        LoadTexture(texturePath.c_str()),
-        1
-    };
-}
 
-static inline Sprite doubleSizeSprite(std::string texturePath) {
-    return {
-        LoadTexture(texturePath.c_str()),
-        2
-    };
-}
-
-// Unload the resources loaded by each asset
-static void unloadAssets() {
+// Unload the sounds and shaders. The sprites live in the atlas, which reloads itself.
+static void unloadSoundsAndShaders() {
 
     // TODO this is awful. Assets should exist in a hashmap.
 
 
-    Sprite *sprites = (Sprite *) SPRITES;
-    for (int idx = 0; idx < (int) (sizeof(SpriteBank)/sizeof(Sprite)); idx++) {
-        UnloadTexture(sprites[idx].sprite);
-    }
-    TraceLog(LOG_INFO, "Sprites unloaded.");
-
-
     Sound *sound = (Sound *) SOUNDS;
     for (int idx = 0; idx < (int) (sizeof(SoundBank)/sizeof(Sound)); idx++) {
         UnloadSound(sound[idx]);
@@ -53,76 +35,11 @@ static void unloadAssets() {
 
     UnloadShader(ShaderLevelTransition);
     UnloadShader(ShaderCRT);
+    UnloadShader(ShaderTilemap);
     TraceLog(LOG_INFO, "Shaders unloaded.");
 }
 
-// Load the resources for each asset
-static void loadAssets() {
-
-    SpriteBank *sp = SPRITES;
-
-    // Editor
-    sp->Eraser = doubleSizeSprite("../assets/eraser_1.png");
-
-    // In Level
-    sp->PlayerDefault = doubleSizeSprite("../assets/player_default_1.png");
-    sp->PlayerWalking1 = doubleSizeSprite("../assets/player_walking_1.png");
-    sp->PlayerWalking2 = doubleSizeSprite("../assets/player_walking_2.png");
-    sp->PlayerRunning1 = doubleSizeSprite("../assets/player_running_1.png");
-    sp->PlayerRunning2 = doubleSizeSprite("../assets/player_running_2.png");
-    sp->PlayerSkidding = doubleSizeSprite("../assets/player_skidding_1.png");
-    sp->PlayerJumpingUp = doubleSizeSprite("../assets/player_jumping_up.png");
-    sp->PlayerJumpingDown = doubleSizeSprite("../assets/player_jumping_down.png");
-    sp->PlayerGlideDefault1 = doubleSizeSprite("../assets/player_glide_default_1.png");
-    sp->PlayerGlideDefault2 = doubleSizeSprite("../assets/player_glide_default_2.png");
-    sp->PlayerGlideGliding1 = doubleSizeSprite("../assets/player_glide_gliding_1.png");
-    sp->PlayerGlideGliding2 = doubleSizeSprite("../assets/player_glide_gliding_2.png");
-    sp->PlayerSwinging = doubleSizeSprite("../assets/player_swinging_1.png");
-    sp->PlayerSwingingForwards = doubleSizeSprite("../assets/player_swinging_forwards.png");
-    sp->PlayerSwingingBackwards = doubleSizeSprite("../assets/player_swinging_backwards.png");
-    sp->Enemy = doubleSizeSprite("../assets/enemy_default_1.png");
-    sp->EnemyDummySpike = doubleSizeSprite("../assets/enemy_dummy_spike_1.png");
-    sp->EnemyDummySpikePoppingOut1 = doubleSizeSprite("../assets/enemy_dummy_spike_popping_out_1.png");
-    sp->EnemyDummySpikePoppingOut2 = doubleSizeSprite("../assets/enemy_dummy_spike_popping_out_2.png");
-    sp->EnemyDummySpikePoppingOut3 = doubleSizeSprite("../assets/enemy_dummy_spike_popping_out_3.png");
-    sp->EnemyDummySpikePoppedOut = doubleSizeSprite("../assets/enemy_dummy_spike_popped_out.png");
-    sp->LevelEndOrb = doubleSizeSprite("../assets/level_end_orb_1.png");
-    sp->LevelCheckpointFlag = doubleSizeSprite("../assets/player_child_1.png");
-    sp->LevelCheckpointPickup1 = doubleSizeSprite("../assets/egg_1.png");
-    sp->LevelCheckpointPickup2 = doubleSizeSprite("../assets/egg_2.png");
-    sp->LevelCheckpointPickup3 = doubleSizeSprite("../assets/egg_3.png");
-    sp->MovingPlatform = normalSizeSprite("../assets/moving_platform.png");
-    sp->Block1Side = normalSizeSprite("../assets/floor_tile_1_side.png");
-    sp->Block0Sides = normalSizeSprite("../assets/floor_tile_0_sides.png");
-    sp->Block2SidesOpp = normalSizeSprite("../assets/floor_tile_2_sides_opposite.png");
-    sp->Block2SidesAdj = normalSizeSprite("../assets/floor_tile_2_sides_adjacent.png");
-    sp->Block3Sides = normalSizeSprite("../assets/floor_tile_3_sides.png");
-    sp->Block4Sides = normalSizeSprite("../assets/floor_tile_4_sides.png");
-    sp->Acid = normalSizeSprite("../assets/acid_tile_1.png");
-    sp->GlideItem = normalSizeSprite("../assets/glide_item.png");
-    sp->TextboxButton = normalSizeSprite("../assets/textbox_button.png");
-    sp->TextboxDevButton = normalSizeSprite("../assets/textbox_dev_button.png");
-    sp->TextboxButtonPlaying = normalSizeSprite("../assets/textbox_button_playing.png");
-    sp->PrincessDefault1 = doubleSizeSprite("../assets/princess_default_1.png");
-    sp->PrincessEditorIcon = doubleSizeSprite("../assets/princess_editor_icon.png");
-    sp->Coin1 = normalSizeSprite("../assets/coin_1.png");
-    sp->Coin2 = normalSizeSprite("../assets/coin_2.png");
-    sp->Coin3 = normalSizeSprite("../assets/coin_3.png");
-
-    // Overworld
-    sp->OverworldCursor = doubleSizeSprite("../assets/cursor_default_1.png");
-    sp->LevelDot = doubleSizeSprite("../assets/level_dot_1.png");
-    sp->PathTileJoin = doubleSizeSprite("../assets/path_tile_join_vertical.png");
-    sp->PathTileStraight = doubleSizeSprite("../assets/path_tile_straight_vertical.png");
-    sp->PathTileInL = doubleSizeSprite("../assets/path_tile_L.png");
-
-    // Background
-    sp->Nightclub = doubleSizeSprite("../assets/nightclub_1.png");
-    sp->BGHouse = doubleSizeSprite("../assets/bg_house_1.png");
-
-    TraceLog(LOG_INFO, "Sprites loaded.");
-
-    //
+static void loadSoundsAndShaders() {
 
     SoundBank *sn = SOUNDS;
 
@@ -137,7 +54,7 @@ static void loadAssets() {
     //
 
     /*
-        !! ATTENTION !!  Each new shader added must be individually unloaded in unloadAssets()
+        !! ATTENTION !!  Each new shader added must be individually unloaded in unloadSoundsAndShaders()
     */
 
     // ShaderDefault = (Shader) { rlGetShaderIdDefault(), rlGetShaderLocsDefault() };
@@ -150,24 +67,35 @@ static void loadAssets() {
     while (!IsShaderReady(ShaderCRT)) {
         TraceLog(LOG_INFO, "Waiting for ShaderCRT...");
     }
+    ShaderTilemap = LoadShader(0, "../assets/shaders/tilemap.fs");
+    while (!IsShaderReady(ShaderTilemap)) {
+        TraceLog(LOG_INFO, "Waiting for ShaderTilemap...");
+    }
 
     TraceLog(LOG_INFO, "Shaders loaded.");
 }
 
 void AssetsInitialize() {
 
-    SPRITES = (SpriteBank *) MemAlloc(sizeof(SpriteBank));
     SOUNDS = (SoundBank *) MemAlloc(sizeof(SoundBank));
 
-    loadAssets();
+    SpritesInitialize(SpriteAtlas::Add);
+    SpriteAtlas::Build();
+    TraceLog(LOG_INFO, "Sprites loaded.");
+
+    loadSoundsAndShaders();
 
     TraceLog(LOG_INFO, "Assets initialized.");
 }
 
 void AssetsHotReload() {
 
-    unloadAssets();
-    loadAssets();
+    unloadSoundsAndShaders();
+    loadSoundsAndShaders();
+
+    SpriteAtlas::Reload();
+
+    Background::Reload();
 
     TextBank::LoadFromDisk();
 
@@ -176,42 +104,6 @@ void AssetsHotReload() {
     Render::PrintSysMessage("Assets recarregados");
 }
 
-Dimensions SpriteScaledDimensions(Sprite *s) {
-    return {
-        s->sprite.width * s->scale,
-        s->sprite.height * s->scale
-    };
-}
-
-Vector2 SpritePosMiddlePoint(Vector2 pos, Sprite *sprite) {
-    Dimensions dimensions = SpriteScaledDimensions(sprite);
-
-    return {
-        pos.x + (dimensions.width / 2),
-        pos.y + (dimensions.height / 2),
-    };
-}
-
-Rectangle SpriteHitboxFromEdge(Sprite *sprite, Vector2 origin) {
-    Dimensions dimensions = SpriteScaledDimensions(sprite);
-    return {
-        origin.x,
-        origin.y,
-        dimensions.width,
-        dimensions.height
-    };
-}
-
-Rectangle SpriteHitboxFromMiddle(Sprite *sprite, Vector2 middlePoint) {
-    Dimensions dimensions = SpriteScaledDimensions(sprite);
-    return {
-        middlePoint.x - (dimensions.width / 2),
-        middlePoint.y - (dimensions.height / 2),
-        dimensions.width,
-        dimensions.height
-    };
-}
-
 void ShaderLevelTransitionSetUniforms(
     Vector2 resolution, Vector2 focusPoint, float duration, float currentTime, int isClose) {
     
@@ -252,15 +144,14 @@ void ShaderLevelTransitionSetUniforms(
     SetShaderValue(ShaderLevelTransition, isCloseLoc, &isClose, SHADER_UNIFORM_INT);
 }
 
-void ShaderCrtSetUniforms() {
+void ShaderCrtSetUniforms(Vector2 resolution) {
 
     int resolutionLoc = GetShaderLocation(ShaderCRT, "u_resolution");
     if (resolutionLoc == -1) {
         TraceLog(LOG_ERROR, "Couldn't find location for uniform u_resolution in ShaderCRT");
         return;
     }
-    Vector2 res = { (float) GetScreenWidth(), (float) GetScreenHeight() };
-    SetShaderValue(ShaderCRT, resolutionLoc, &res, SHADER_UNIFORM_VEC2);
+    SetShaderValue(ShaderCRT, resolutionLoc, &resolution, SHADER_UNIFORM_VEC2);
 
     int timeLoc = GetShaderLocation(ShaderCRT, "u_time");
     if (timeLoc == -1) {
@@ -270,3 +161,37 @@ void ShaderCrtSetUniforms() {
     double time = GetTime();
     SetShaderValue(ShaderCRT, timeLoc, &time, SHADER_UNIFORM_INT);
 }
+
+void ShaderTilemapSetUniforms(Texture2D atlas, Vector2 mapSize, Sprite *const *tileSprites, int tileCount) {
+
+    int atlasLoc = GetShaderLocation(ShaderTilemap, "u_atlas");
+    if (atlasLoc == -1) {
+        TraceLog(LOG_ERROR, "Couldn't find location for uniform u_atlas in ShaderTilemap");
+        return;
+    }
+    SetShaderValueTexture(ShaderTilemap, atlasLoc, atlas);
+
+    int atlasSizeLoc = GetShaderLocation(ShaderTilemap, "u_atlas_size");
+    if (atlasSizeLoc == -1) {
+        TraceLog(LOG_ERROR, "Couldn't find location for uniform u_atlas_size in ShaderTilemap");
+        return;
+    }
+    Vector2 atlasSize = { (float) atlas.width, (float) atlas.height };
+    SetShaderValue(ShaderTilemap, atlasSizeLoc, &atlasSize, SHADER_UNIFORM_VEC2);
+
+    int mapSizeLoc = GetShaderLocation(ShaderTilemap, "u_map_size");
+    if (mapSizeLoc == -1) {
+        TraceLog(LOG_ERROR, "Couldn't find location for uniform u_map_size in ShaderTilemap");
+        return;
+    }
+    SetShaderValue(ShaderTilemap, mapSizeLoc, &mapSize, SHADER_UNIFORM_VEC2);
+
+    int tileSourcesLoc = GetShaderLocation(ShaderTilemap, "u_tile_sources");
+    if (tileSourcesLoc == -1) {
+        TraceLog(LOG_ERROR, "Couldn't find location for uniform u_tile_sources in ShaderTilemap");
+        return;
+    }
+    Rectangle sources[TILEMAP_MAX_TILE_TYPES];
+    for (int i = 0; i < tileCount; i++) sources[i] = tileSprites[i]->source;
+    SetShaderValueV(ShaderTilemap, tileSourcesLoc, sources, SHADER_UNIFORM_VEC4, tileCount);
+}
@@ -5,78 +5,8 @@
 
 #include <raylib.h>
 
-#include "core.hpp"
-
-
-typedef struct Sprite {
-    Texture2D sprite;
-    float scale;
-} Sprite;
-
-struct SpriteBank {
-
-    // TODO make it a hashmap
-
-    // Editor
-    Sprite Eraser;
-
-    // In Level
-    Sprite PlayerDefault;
-    Sprite PlayerWalking1;
-    Sprite PlayerWalking2;
-    Sprite PlayerRunning1;
-    Sprite PlayerRunning2;
-    Sprite PlayerSkidding;
-    Sprite PlayerJumpingUp;
-    Sprite PlayerJumpingDown;
-    Sprite PlayerGlideDefault1;
-    Sprite PlayerGlideDefault2;
-    Sprite PlayerGlideGliding1;
-    Sprite PlayerGlideGliding2;
-    Sprite PlayerSwinging;
-    Sprite PlayerSwingingForwards;
-    Sprite PlayerSwingingBackwards;
-    Sprite Enemy;
-    Sprite EnemyDummySpike;
-    Sprite EnemyDummySpikePoppingOut1;
-    Sprite EnemyDummySpikePoppingOut2;
-    Sprite EnemyDummySpikePoppingOut3;
-    Sprite EnemyDummySpikePoppedOut;
-    Sprite Block0Sides;
-    Sprite Block1Side;
-    Sprite Block2SidesOpp;
-    Sprite Block2SidesAdj;
-    Sprite Block3Sides;
-    Sprite Block4Sides;
-    Sprite Acid;
-    Sprite LevelEndOrb;
-    Sprite LevelCheckpointFlag;
-    Sprite LevelCheckpointPickup1;
-    Sprite LevelCheckpointPickup2;
-    Sprite LevelCheckpointPickup3;
-    Sprite MovingPlatform;
-    Sprite GlideItem;
-    Sprite TextboxButton;
-    Sprite TextboxDevButton;
-    Sprite TextboxButtonPlaying;
-    Sprite PrincessDefault1;
-    Sprite PrincessEditorIcon;
-    Sprite Coin1;
-    Sprite Coin2;
-    Sprite Coin3;
-
-    // Overworld
-    Sprite OverworldCursor;
-    Sprite LevelDot;
-    Sprite PathTileJoin;
-    Sprite PathTileStraight;
-    Sprite PathTileInL;
-
-    // Background
-    Sprite Nightclub;
-    Sprite BGHouse;
+#include "sprites.hpp"
 
-};
 
 struct SoundBank {
 
@@ -87,30 +17,17 @@ struct SoundBank {
 };
 
 
-extern struct SpriteBank *SPRITES;
-
 extern struct SoundBank *SOUNDS;
 
 // Shaders
 extern Shader ShaderLevelTransition;
 extern Shader ShaderCRT;
+extern Shader ShaderTilemap;
 
 void AssetsInitialize();
 
 void AssetsHotReload();
 
-// Get a Sprite's dimensions, scaled
-Dimensions SpriteScaledDimensions(Sprite *sprite);
-
-// Get a sprite's middle point given its position
-Vector2 SpritePosMiddlePoint(Vector2 pos, Sprite *sprite);
-
-// Returns a hitbox in the shape of sprite.
-Rectangle SpriteHitboxFromEdge(Sprite *sprite, Vector2 origin);
-
-// Returns a hitbox in the shape of sprite, centered around middlePoint.
-Rectangle SpriteHitboxFromMiddle(Sprite *sprite, Vector2 middlePoint);
-
 /*
     Configures the uniforms ShaderLevelTransition will use in each execution.
     
@@ -123,6 +40,17 @@ Rectangle SpriteHitboxFromMiddle(Sprite *sprite, Vector2 middlePoint);
 void ShaderLevelTransitionSetUniforms(
     Vector2 resolution, Vector2 focusPoint, float duration, float currentTime, int isClose);
 
-void ShaderCrtSetUniforms();
+// resolution: The resolution of what's being drawn with ShaderCRT.
+void ShaderCrtSetUniforms(Vector2 resolution);
+
+/*
+    Configures the uniforms ShaderTilemap will use in its next execution. Must be called in its shader mode.
+
+    atlas: The atlas page with the tiles' sprites.
+    mapSize: The dimensions, in cells, of the tilemap texture being drawn.
+    tileSprites: The sprite of each tile type, in the order the tilemap refers to them.
+    tileCount: How many tile types there are.
+*/
+void ShaderTilemapSetUniforms(Texture2D atlas, Vector2 mapSize, Sprite *const *tileSprites, int tileCount);
 
 #endif // _ASSETS_H_INCLUDED_
@@ -0,0 +1,109 @@
+#include <raylib.h>
+#include <stdio.h>
+
+#include "background.hpp"
+
+
+#define LAYER_PERSISTENCE_ID    "background"
+
+
+namespace Background {
+
+
+static std::vector<Layer> layers;
+
+static long version = 0;
+
+
+static const char *repeatName(LayerRepeat repeat) {
+
+    switch (repeat) {
+    case LAYER_REPEAT_X:    return "x";
+    case LAYER_REPEAT_XY:   return "xy";
+    default:                return "none";
+    }
+}
+
+static LayerRepeat repeatFromName(std::string_view name) {
+
+    if (name == "x")    return LAYER_REPEAT_X;
+    if (name == "xy")   return LAYER_REPEAT_XY;
+    if (name != "none") TraceLog(LOG_WARNING, "Unknown background layer repeat '%.*s'.", (int) name.size(), name.data());
+
+    return LAYER_REPEAT_NONE;
+}
+
+void Layer::PersistanceSerialize(std::string *line) {
+
+    char buffer[20];
+
+    persistanceAddValue(line, "image", image);
+    persistanceAddValue(line, "x", pos.x);
+    persistanceAddValue(line, "y", pos.y);
+    persistanceAddValue(line, "scale", scale);
+    persistanceAddValue(line, "parallax", parallax);
+
+    snprintf(buffer, sizeof(buffer), "%02x%02x%02x%02x", tint.r, tint.g, tint.b, tint.a);
+    persistanceAddValue(line, "tint", buffer);
+
+    persistanceAddValue(line, "repeat", repeatName(repeat));
+}
+
+bool Layer::PersistenceParse(const PersistenceFields &fields) {
+
+    unsigned int rgba;
+    std::string_view repeatValue;
+
+    if (!fields.ReadString("image", &image) ||
+        !fields.ReadFloat("x", &pos.x) ||
+        !fields.ReadFloat("y", &pos.y) ||
+        !fields.ReadFloat("scale", &scale) ||
+        !fields.ReadFloat("parallax", &parallax) ||
+        !fields.ReadHex("tint", &rgba)) return false;
+
+    tint = { (unsigned char) (rgba >> 24), (unsigned char) (rgba >> 16), (unsigned char) (rgba >> 8), (unsigned char) rgba };
+
+    // Optional, as most layers don't repeat
+    repeat = fields.Get("repeat", &repeatValue) ? repeatFromName(repeatValue) : LAYER_REPEAT_NONE;
+
+    return true;
+}
+
+std::string_view Layer::PersitenceEntityID() {
+    return LAYER_PERSISTENCE_ID;
+}
+
+bool AddFromPersistence(const PersistenceFields &fields) {
+
+    Layer layer;
+    if (!layer.PersistenceParse(fields)) return false;
+
+    layers.push_back(layer);
+    version++;
+
+    return true;
+}
+
+const std::vector<Layer> &Layers() {
+    return layers;
+}
+
+long Version() {
+    return version;
+}
+
+void Clear() {
+
+    layers.clear();
+    version++;
+}
+
+void Reload() {
+
+    version++;
+
+    TraceLog(LOG_INFO, "Background reloading %d layers.", (int) layers.size());
+}
+
+
+} // namespace
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+#include "persistence.hpp"
+
+
+// Where the layers' images are
+#define BACKGROUND_IMAGES_DIR   "../assets/"
+
+
+namespace Background {
+
+
+typedef enum LayerRepeat {
+    LAYER_REPEAT_NONE,
+    LAYER_REPEAT_X,     // Repeats sideways, covering the view's width
+    LAYER_REPEAT_XY     // Repeats in every direction, covering the whole view
+} LayerRepeat;
+
+
+/*
+    A layer of the level's background, declared in the level file as a "background" line:
+
+        background:image=nightclub_1.png;x=875;y=175;scale=1.4;parallax=0.4;tint=ffffff88;repeat=none;
+
+    The renderer bakes its image, already scaled and tinted, into a texture that repeats,
+    so the whole layer is drawn as a single quad.
+*/
+class Layer : public IPersistable {
+
+public:
+
+    // The image file, in BACKGROUND_IMAGES_DIR
+    std::string image;
+
+    // Where the image is, in the layer's own coordinates, that move at the parallax speed
+    Vector2 pos;
+
+    float scale;
+
+    // How fast the layer moves relative to the scene, e.g. 0.5 is half as fast
+    float parallax;
+
+    Color tint;
+
+    LayerRepeat repeat;
+
+
+    void PersistanceSerialize(std::string *line) override;
+    bool PersistenceParse(const PersistenceFields &fields) override;
+    std::string_view PersitenceEntityID() override;
+};
+
+
+// Adds a layer from its persisted fields, in front of the ones already added.
+// Returns 'false', adding nothing, if the fields couldn't be parsed.
+bool AddFromPersistence(const PersistenceFields &fields);
+
+// The layers, from the back to the front
+const std::vector<Layer> &Layers();
+
+// Changes whenever the layers or their images do, so the renderer knows to bake them again
+long Version();
+
+// Removes all layers
+void Clear();
+
+// Has the layers baked again, from the images on disk
+void Reload();
+
+
+} // namespace
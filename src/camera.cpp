@@ -25,6 +25,10 @@ static bool isPanned = false;
 static Vector2 panningCameraOrigin;
 static Vector2 panningCursorLastFrame;
 
+// Where the camera was before and after the last tick
+static Vector2 lastTickStartPos;
+static Vector2 lastTickEndPos;
+
 
 // Total stretching that should be applied when converting to scene to screen positions
 static float renderStretch() {
@@ -78,28 +82,50 @@ void CameraInitialize() {
     CAMERA = (MyCamera *) MemAlloc(sizeof(MyCamera));
 
     CAMERA->pos = { 0, 0 };
+    CAMERA->renderPos = { 0, 0 };
     CAMERA->zoom = 1;
     CAMERA->fullscreenStretch = 1;
     CAMERA->sceneXOffset = 0;
+    CAMERA->screen = { SCREEN_WIDTH, SCREEN_HEIGHT };
 
     TraceLog(LOG_INFO, "Camera initialized.");
 }
 
 void CameraTick() {
 
-    if (isPanned) return;
-    if (EDITOR_STATE->isEnabled) return;
+    lastTickStartPos = CAMERA->pos;
 
-    switch (GAME_STATE->mode)
-    {
-    case MODE_OVERWORLD:
-        tickOverworldCamera();
-        break;
+    if (!isPanned && !EDITOR_STATE->isEnabled) {
 
-    case MODE_IN_LEVEL:
-        tickLevelCamera();
-        break;
+        switch (GAME_STATE->mode)
+        {
+        case MODE_OVERWORLD:
+            tickOverworldCamera();
+            break;
+
+        case MODE_IN_LEVEL:
+            tickLevelCamera();
+            break;
+        }
     }
+
+    lastTickEndPos = CAMERA->pos;
+}
+
+void CameraInterpolate() {
+
+    // Moved outside of a tick (e.g. panning, zooming, centralizing), so there's nothing to interpolate
+    if (CAMERA->pos.x != lastTickEndPos.x || CAMERA->pos.y != lastTickEndPos.y) {
+        CAMERA->renderPos = CAMERA->pos;
+        return;
+    }
+
+    const float t = GetTickInterpolation();
+
+    CAMERA->renderPos = {
+        lastTickStartPos.x + (lastTickEndPos.x - lastTickStartPos.x) * t,
+        lastTickStartPos.y + (lastTickEndPos.y - lastTickStartPos.y) * t
+    };
 }
 
 void CameraFollow() {
@@ -183,8 +209,8 @@ void CameraZoomIn() {
     CAMERA->zoom += ZOOM_STEP;
     if (CAMERA->zoom >= ZOOM_MAX) CAMERA->zoom = ZOOM_MAX;
 
-    CAMERA->pos.x += ((GetScreenWidth() / zoomBefore) - (GetScreenWidth() / CAMERA->zoom)) / 2;
-    CAMERA->pos.y += ((GetScreenHeight() / zoomBefore) - (GetScreenHeight() / CAMERA->zoom)) / 2;
+    CAMERA->pos.x += ((CAMERA->screen.width / zoomBefore) - (CAMERA->screen.width / CAMERA->zoom)) / 2;
+    CAMERA->pos.y += ((CAMERA->screen.height / zoomBefore) - (CAMERA->screen.height / CAMERA->zoom)) / 2;
 
     isPanned = true;
 }
@@ -196,48 +222,65 @@ void CameraZoomOut() {
     CAMERA->zoom -= ZOOM_STEP;
     if (CAMERA->zoom <= ZOOM_MIN) CAMERA->zoom = ZOOM_MIN;
 
-    CAMERA->pos.x -= ((GetScreenWidth() / CAMERA->zoom) - (GetScreenWidth() / zoomBefore)) / 2;
-    CAMERA->pos.y -= ((GetScreenHeight() / CAMERA->zoom) - (GetScreenHeight() / zoomBefore)) / 2;
+    CAMERA->pos.x -= ((CAMERA->screen.width / CAMERA->zoom) - (CAMERA->screen.width / zoomBefore)) / 2;
+    CAMERA->pos.y -= ((CAMERA->screen.height / CAMERA->zoom) - (CAMERA->screen.height / zoomBefore)) / 2;
 
     isPanned = true;
 }
 
 void CameraAdjustForFullscreen(bool isFullscreen) {
     if (isFullscreen) {
-        CAMERA->fullscreenStretch = (float) GetScreenHeight() / (float) SCREEN_HEIGHT;
-        CAMERA->sceneXOffset = ((float) GetScreenWidth() - ((float) SCREEN_WIDTH * CAMERA->fullscreenStretch)) / 2;
+        CAMERA->fullscreenStretch = (float) CAMERA->screen.height / (float) SCREEN_HEIGHT;
+        CAMERA->sceneXOffset = ((float) CAMERA->screen.width - ((float) SCREEN_WIDTH * CAMERA->fullscreenStretch)) / 2;
     } else {
         CAMERA->fullscreenStretch = 1;
         CAMERA->sceneXOffset = 0;
     }
 }
 
+void CameraScreenSizeSet(Dimensions screen) {
+    CAMERA->screen = screen;
+}
+
 /*
     Zooming works by keeping the 0,0 pinned and then streching around
     -- which means it streches towards the botttom right of the screen.
 */
 
-Vector2 PosInScreenToScene(Vector2 pos) {
+Rectangle CameraSceneView() {
     return {
-        (pos.x - CAMERA->sceneXOffset) / renderStretch() + CAMERA->pos.x,
-        pos.y / renderStretch() + CAMERA->pos.y
+        CAMERA->renderPos.x - CAMERA->sceneXOffset / renderStretch(),
+        CAMERA->renderPos.y,
+        CAMERA->screen.width / renderStretch(),
+        CAMERA->screen.height / renderStretch()
     };
 }
 
-Vector2 PosInSceneToScreen(Vector2 pos) {
+Vector2 PosInScreenToScene(Vector2 pos) {
     return {
-        (pos.x - CAMERA->pos.x) * renderStretch() + CAMERA->sceneXOffset,
-        (pos.y - CAMERA->pos.y) * renderStretch()
+        (pos.x - CAMERA->sceneXOffset) / renderStretch() + CAMERA->renderPos.x,
+        pos.y / renderStretch() + CAMERA->renderPos.y
     };
 }
 
-Vector2 PosInSceneToScreenParallax(Vector2 pos, float parallaxSpeed) {
+Vector2 PosInSceneToScreen(Vector2 pos) {
     return {
-        (pos.x - (CAMERA->pos.x * parallaxSpeed)) * renderStretch() + CAMERA->sceneXOffset,
-        (pos.y - (CAMERA->pos.y * parallaxSpeed)) * renderStretch()
+        (pos.x - CAMERA->renderPos.x) * renderStretch() + CAMERA->sceneXOffset,
+        (pos.y - CAMERA->renderPos.y) * renderStretch()
     };
 }
 
+Camera2D CameraSceneCamera2D(float parallaxSpeed) {
+
+    Camera2D camera;
+    camera.offset = { (float) CAMERA->sceneXOffset, 0 };
+    camera.target = { CAMERA->renderPos.x * parallaxSpeed, CAMERA->renderPos.y * parallaxSpeed };
+    camera.rotation = 0;
+    camera.zoom = renderStretch();
+
+    return camera;
+}
+
 float ScaleInSceneToScreen(float value) {
     return value * renderStretch();
 }
@@ -12,6 +12,9 @@ typedef struct MyCamera {
     // The position (origin) of the camera in the scene
     Vector2 pos;
 
+    // Where the scene is rendered from, between the camera's position before and after the last tick
+    Vector2 renderPos;
+
     // The zoom the player applied to the scene
     float zoom;
 
@@ -29,6 +32,9 @@ typedef struct MyCamera {
 
     // How much to vertically offset the rendering frame to centralize it, in case of wider resolutions
     int sceneXOffset;
+
+    // The size of the screen the scene is rendered to, as the renderer last set it
+    Dimensions screen;
 } MyCamera;
 
 
@@ -39,6 +45,9 @@ void CameraInitialize();
 
 void CameraTick();
 
+// Updates the camera's renderPos. To be called once every frame, before rendering.
+void CameraInterpolate();
+
 // Ask camera to follow the controlled entity
 void CameraFollow();
 
@@ -63,15 +72,22 @@ void CameraZoomOut();
 
 void CameraAdjustForFullscreen(bool isFullscreen);
 
+// Sets the size of the screen. To be called by the renderer every frame, before rendering.
+void CameraScreenSizeSet(Dimensions screen);
+
+// The area of the scene that's on the screen, where it's rendered from
+Rectangle CameraSceneView();
+
 // Converts position from the screen coordinates to in game coordinates
 Vector2 PosInScreenToScene(Vector2 pos);
 
 // Converts position from in game coordinates to the screen coordinates
 Vector2 PosInSceneToScreen(Vector2 pos);
 
-// Converts position from in game coordinates to the screen coordinates,
-// applying parallax speed
-Vector2 PosInSceneToScreenParallax(Vector2 pos, float parallaxSpeed);
+// The camera for BeginMode2D(), so what's drawn in it can use in game coordinates. The zoom and
+// fullscreen stretch and offset are applied by the GPU, the same way PosInSceneToScreen() does.
+// The parallaxSpeed is how fast the scene moves relative to the camera, for background layers.
+Camera2D CameraSceneCamera2D(float parallaxSpeed = 1);
 
 // Converts a scale from in game to the screen according to the zoom level
 float ScaleInSceneToScreen(float value);
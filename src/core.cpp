@@ -2,23 +2,21 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <time.h>
 
 #include "core.hpp"
 #include "overworld.hpp"
 #include "camera.hpp"
 #include "level/level.hpp"
-#include "editor.hpp"
-#include "render.hpp"
 #include "debug.hpp"
-#include "text_bank.hpp"
-#include "input.hpp"
-#include "sounds.hpp"
 
 
 GameState *GAME_STATE = 0;
 
-static size_t mouseEnabledReferences = 0;
+// How many ticks were simulated since the game started
+static unsigned long long simulationTicks = 0;
+
+// Time that passed but that wasn't simulated yet, always less than a tick
+static double tickAccumulator = 0;
 
 
 static inline float snapToGrid(float value, float length) {
@@ -39,18 +37,6 @@ static inline float distanceFromGrid(float value, float length) {
     }
 }
 
-void windowTitleUpdate() {
-
-    char title[LEVEL_NAME_BUFFER_SIZE + 20];
-
-    if (Level::STATE->levelName[0] != '\0')
-        sprintf(title, "%s - %d FPS", Level::STATE->levelName, GetFPS());  
-    else
-        sprintf(title, "Jogo de Plataforma - %d FPS", GetFPS());  
-
-    SetWindowTitle(title);
-}
-
 void GameStateInitialize() {
 
     GAME_STATE = (GameState *) MemAlloc(sizeof(GameState));
@@ -75,32 +61,9 @@ void GameStateReset() {
 
     GAME_STATE->coinsCollected = 0;
 
-    EditorDisable();
-    DebugHudDisable();
-    MouseCursorDisable();
-
     TraceLog(LOG_INFO, "Game state reset.");
 }
 
-void SystemsInitialize() {
-
-    srand(time(NULL));
-
-    InitAudioDevice();
-    // while (!IsAudioDeviceReady()) {}
-
-    Input::Initialize();
-    AssetsInitialize();
-    GameStateInitialize();
-    CameraInitialize();
-    EditorInitialize();
-    OverworldInitialize();
-    Level::Initialize();
-    Render::Initialize();
-    Sounds::Initialize();
-    TextBank::LoadFromDisk();
-}
-
 void GameUpdate() {
 
     if (GAME_STATE->mode == MODE_IN_LEVEL)
@@ -108,65 +71,35 @@ void GameUpdate() {
     else if (GAME_STATE->mode == MODE_OVERWORLD)
         OverworldTick();
 
-    if (EDITOR_STATE->isEnabled)
-        EditorTick();
-
-    Sounds::Tick();
-    windowTitleUpdate();
+    simulationTicks++;
 }
 
-void GameExit() {
+void GameUpdateFrame(double frameDuration) {
 
-    TraceLog(LOG_INFO, "Exiting game.");
-    exit(0);
-}
-
-LinkedList::Node *GetEntityListHead() {
-
-    if (GAME_STATE->mode == MODE_IN_LEVEL) return Level::STATE->listHead;
-    else if (GAME_STATE->mode == MODE_OVERWORLD) return OW_STATE->listHead;
-    else return 0;
-}
+    if (frameDuration > MAX_FRAME_DURATION) frameDuration = MAX_FRAME_DURATION;
 
-void DebugHudEnable() {
+    tickAccumulator += frameDuration;
 
-    GAME_STATE->showDebugHUD = true;
-    MouseCursorEnable();
-    TraceLog(LOG_TRACE, "Debug hud enabled.");
+    while (tickAccumulator >= TICK_DURATION) {
+        GameUpdate();
+        tickAccumulator -= TICK_DURATION;
+    }
 }
 
-void DebugHudDisable() {
-
-    GAME_STATE->showDebugHUD = false;
-    MouseCursorDisable();
-    CameraPanningReset();
-    TraceLog(LOG_TRACE, "Debug hud disabled.");
+float GetTickInterpolation() {
+    return tickAccumulator / TICK_DURATION;
 }
 
-void MouseCursorDisable() {
-
-    if (mouseEnabledReferences > 0) mouseEnabledReferences--;
-    if (mouseEnabledReferences == 0) HideCursor();
-    TraceLog(LOG_TRACE, "Mouse enabled references down to %d.", mouseEnabledReferences);
+double GetSimulationTime() {
+    return simulationTicks * TICK_DURATION;
 }
 
-void MouseCursorEnable() {
+void GameExit() {
 
-    mouseEnabledReferences++;
-    ShowCursor();
-    TraceLog(LOG_TRACE, "Mouse enabled references increased to %d.", mouseEnabledReferences);
+    TraceLog(LOG_INFO, "Exiting game.");
+    exit(0);
 }
 
-void DebugHudToggle() {
-
-    if (GAME_STATE->showDebugHUD) {
-        DebugEntityStopAll();
-        DebugHudDisable();
-    }
-    else {
-        DebugHudEnable();
-    }
-}
 
 void ToggleDevTextbox() {
     GAME_STATE->showDevTextbox = !GAME_STATE->showDevTextbox;
@@ -176,22 +109,6 @@ bool IsDevTextboxEnabled() {
     return GAME_STATE->showDevTextbox;
 }
 
-bool IsInMouseArea(Vector2 pos) {
-
-    float w = GetScreenWidth();
-    float h = GetScreenHeight();
-
-    if (EDITOR_STATE->isEnabled) {
-        auto bar = EditorBarGetRect();
-        w -= bar.width;
-    }
-    
-    return pos.x >= 0 &&
-            pos.x <= w &&
-            pos.y >= 0 &&
-            pos.y <= h;
-}
-
 Vector2 SnapToGrid(Vector2 coords, Dimensions grid) {
 
     return {
@@ -222,6 +139,40 @@ void RectangleSetDimensions(Rectangle *rect, Dimensions dims) {
     rect->height = dims.height;
 }
 
+bool RectanglesCollide(Rectangle rec1, Rectangle rec2) {
+
+    return rec1.x < rec2.x + rec2.width && rec1.x + rec1.width > rec2.x &&
+            rec1.y < rec2.y + rec2.height && rec1.y + rec1.height > rec2.y;
+}
+
+bool PointInRectangle(Vector2 point, Rectangle rec) {
+
+    return point.x >= rec.x && point.x < rec.x + rec.width &&
+            point.y >= rec.y && point.y < rec.y + rec.height;
+}
+
+Rectangle RectanglesOverlap(Rectangle rec1, Rectangle rec2) {
+
+    float left = fmaxf(rec1.x, rec2.x);
+    float right = fminf(rec1.x + rec1.width, rec2.x + rec2.width);
+    float top = fmaxf(rec1.y, rec2.y);
+    float bottom = fminf(rec1.y + rec1.height, rec2.y + rec2.height);
+
+    if (left >= right || top >= bottom) return { 0, 0, 0, 0 };
+
+    return { left, top, right - left, bottom - top };
+}
+
+Rectangle RectanglesUnion(Rectangle rec1, Rectangle rec2) {
+
+    float left = fminf(rec1.x, rec2.x);
+    float right = fmaxf(rec1.x + rec1.width, rec2.x + rec2.width);
+    float top = fminf(rec1.y, rec2.y);
+    float bottom = fmaxf(rec1.y + rec1.height, rec2.y + rec2.height);
+
+    return { left, top, right - left, bottom - top };
+}
+
 void ExitGame() {
     exit(0);
 }
@@ -10,6 +10,13 @@
 #define SCREEN_WIDTH 1920
 #define SCREEN_HEIGHT 1080
 
+// How many times per second the game is simulated, independently of how often it's rendered
+#define TICKS_PER_SECOND        60
+#define TICK_DURATION           (1.0 / TICKS_PER_SECOND)
+
+// The longest frame the simulation catches up with, so a hitch doesn't snowball into more hitches
+#define MAX_FRAME_DURATION      0.25
+
 
 class Menu;
 
@@ -84,34 +91,21 @@ void GameStateInitialize();
 
 void GameStateReset();
 
-// Initialize the game's core systems
-void SystemsInitialize();
-
-// Updates the logic of the game. To be called once every frame.
+// Updates the logic of the game by one tick
 void GameUpdate();
 
-void GameExit();
-
-// The area of the screen that's interactable
-bool IsInMouseArea(Vector2 pos);
-
-// Returns the entity list's head for the current selected game mode
-LinkedList::Node *GetEntityListHead();
-
-// Enables the debug HUD
-void DebugHudEnable();
+// Runs as many ticks as fit in the time that passed since the last frame,
+// carrying the remainder over to the next frame. To be called once every frame.
+void GameUpdateFrame(double frameDuration);
 
-// Disables the debug HUD
-void DebugHudDisable();
+// How much of a tick passed since the last one, from 0 to 1, for rendering between ticks
+float GetTickInterpolation();
 
-// Disables mouse cursor, if not in use
-void MouseCursorDisable();
+// Seconds simulated since the game started. Gameplay should use it instead of GetTime(),
+// so it advances exactly one TICK_DURATION per tick.
+double GetSimulationTime();
 
-// Enables the mouse cursor
-void MouseCursorEnable();
-
-// Toggles the debug HUD between 'enabled' and 'disabled'
-void DebugHudToggle();
+void GameExit();
 
 void ToggleDevTextbox();
 
@@ -132,6 +126,19 @@ void RectangleSetPos(Rectangle *rect, Vector2 pos);
 // Sets the width and height of a rectangle according to a Dimensions
 void RectangleSetDimensions(Rectangle *rect, Dimensions dims);
 
+// If two rectangles overlap. The same as raylib's CheckCollisionRecs(),
+// which the simulation can't link to without linking the whole of raylib.
+bool RectanglesCollide(Rectangle rec1, Rectangle rec2);
+
+// If a point is inside a rectangle, the same as raylib's CheckCollisionPointRec()
+bool PointInRectangle(Vector2 point, Rectangle rec);
+
+// The overlap between two rectangles, the same as raylib's GetCollisionRec()
+Rectangle RectanglesOverlap(Rectangle rec1, Rectangle rec2);
+
+// The smallest rectangle covering both rectangles
+Rectangle RectanglesUnion(Rectangle rec1, Rectangle rec2);
+
 void ExitGame();
 
 
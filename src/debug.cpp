@@ -7,46 +7,71 @@
 #include "linked_list.hpp"
 
 
-std::vector<LinkedList::Node *> DEBUG_ENTITY_INFO_HEAD = std::vector<LinkedList::Node *>();
+std::vector<Level::EntityHandle> DEBUG_ENTITY_INFO_HEAD = std::vector<Level::EntityHandle>();
 
+std::vector<LinkedList::Node *> DEBUG_OW_ENTITY_INFO_HEAD = std::vector<LinkedList::Node *>();
 
-void DebugEntityToggle(Vector2 pos) {
 
-    LinkedList::Node *entity;
-    switch (GAME_STATE->mode) {
-    case MODE_IN_LEVEL:
-        entity = Level::EntityGetAt(pos); break;
-    case MODE_OVERWORLD:
-        entity = OverworldEntityGetAt(pos); break;
-    default:
-        return;
-    }
-    
-    if (!entity) return;
+// Adds the entity to the list if it's not there, or removes it if it is
+template <typename T>
+static void toggleInList(std::vector<T> &list, T entity) {
 
-    auto idx = std::find(DEBUG_ENTITY_INFO_HEAD.begin(), DEBUG_ENTITY_INFO_HEAD.end(), entity);
-    if (idx != DEBUG_ENTITY_INFO_HEAD.end()) {
-        DEBUG_ENTITY_INFO_HEAD.erase(idx);
+    auto idx = std::find(list.begin(), list.end(), entity);
+    if (idx != list.end()) {
+        list.erase(idx);
         TraceLog(LOG_TRACE, "Debug entity info disabled entity.");
     } else {
-        DEBUG_ENTITY_INFO_HEAD.push_back(entity);
+        list.push_back(entity);
         TraceLog(LOG_TRACE, "Debug entity info enabled entity.");
     }
 }
 
-void DebugEntityStop(LinkedList::Node *entity) {
+template <typename T>
+static void removeFromList(std::vector<T> &list, T entity) {
 
-    auto idx = std::find(DEBUG_ENTITY_INFO_HEAD.begin(), DEBUG_ENTITY_INFO_HEAD.end(), entity);
+    auto idx = std::find(list.begin(), list.end(), entity);
 
-    if (idx != DEBUG_ENTITY_INFO_HEAD.end()) {
-        DEBUG_ENTITY_INFO_HEAD.erase(idx);
+    if (idx != list.end()) {
+        list.erase(idx);
         TraceLog(LOG_TRACE, "Debug entity info disabled entity.");
     }
 }
 
+void DebugEntityToggle(Vector2 pos) {
+
+    switch (GAME_STATE->mode) {
+
+    case MODE_IN_LEVEL: {
+        Level::Entity *entity = Level::EntityGetAt(pos);
+        if (entity) toggleInList(DEBUG_ENTITY_INFO_HEAD, entity->handle);
+        break;
+    }
+
+    case MODE_OVERWORLD: {
+        LinkedList::Node *entity = OverworldEntityGetAt(pos);
+        if (entity) toggleInList(DEBUG_OW_ENTITY_INFO_HEAD, entity);
+        break;
+    }
+
+    default:
+        return;
+    }
+}
+
+void DebugEntityStop(Level::EntityHandle entity) {
+
+    removeFromList(DEBUG_ENTITY_INFO_HEAD, entity);
+}
+
+void DebugEntityStop(LinkedList::Node *entity) {
+
+    removeFromList(DEBUG_OW_ENTITY_INFO_HEAD, entity);
+}
+
 void DebugEntityStopAll() {
 
     DEBUG_ENTITY_INFO_HEAD.clear();
+    DEBUG_OW_ENTITY_INFO_HEAD.clear();
 
     TraceLog(LOG_TRACE, "Debug entity info disabled all entities.");
 }
@@ -9,14 +9,21 @@
 #include "level/level.hpp"
 
 
-extern std::vector<LinkedList::Node *> DEBUG_ENTITY_INFO_HEAD;
+// The level entities showing debug info
+extern std::vector<Level::EntityHandle> DEBUG_ENTITY_INFO_HEAD;
+
+// The overworld entities showing debug info
+extern std::vector<LinkedList::Node *> DEBUG_OW_ENTITY_INFO_HEAD;
 
 
 // Searches for entity at pos and, if it finds one, shows
 // debug info about it, or stops showing if it's enabled already.
 void DebugEntityToggle(Vector2 pos);
 
-// Stops showing info about an entity. If it's not showing already, does nothing.
+// Stops showing info about a level entity. If it's not showing already, does nothing.
+void DebugEntityStop(Level::EntityHandle entity);
+
+// Stops showing info about an overworld entity. If it's not showing already, does nothing.
 void DebugEntityStop(LinkedList::Node *entity);
 
 // Stops showing info about all entities.
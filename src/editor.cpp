@@ -1,7 +1,9 @@
 #include <raylib.h>
+#include <algorithm>
 
 #include "editor.hpp"
 #include "core.hpp"
+#include "frontend.hpp"
 #include "level/level.hpp"
 #include "level/enemy.hpp"
 #include "level/powerups.hpp"
@@ -46,7 +48,7 @@ static void editorUseEraserInLevel(Vector2 pos) {
 
     auto foundEntityInSelection = std::find(EDITOR_STATE->selectedEntities.begin(),
                                                 EDITOR_STATE->selectedEntities.end(),
-                                                foundEntity);
+                                                foundEntity->handle);
     bool isPartOfSelection = foundEntityInSelection != EDITOR_STATE->selectedEntities.end();
 
     if (isPartOfSelection) {
@@ -56,7 +58,9 @@ static void editorUseEraserInLevel(Vector2 pos) {
                 selectedEntity < EDITOR_STATE->selectedEntities.end();
                 selectedEntity++) {
 
-            Level::EntityDestroy((Level::Entity *)*selectedEntity);
+            // Skips the ones that are already gone
+            if (Level::Entity *entity = Level::EntityGet(*selectedEntity))
+                Level::EntityDestroy(entity);
         }
 
     }
@@ -95,8 +99,8 @@ static void editorAutoTileSelection() {
 
     for (auto e : EDITOR_STATE->selectedEntities) {
         
-        auto entity = (Level::Entity *) e;
-        if (entity->tags & Level::IS_TILE_BLOCK) {
+        auto entity = Level::EntityGet(e);
+        if (entity && entity->tags & Level::IS_TILE_BLOCK) {
             
             auto block = (Block *) entity;
             block->TileAutoAdjust();
@@ -172,17 +176,14 @@ void loadOverworldEditor() {
 static void updateEntitySelectionList() {
 
     EDITOR_STATE->selectedEntities.clear();
+    EDITOR_STATE->selectedOverworldEntities.clear();
     EDITOR_STATE->isSelectionGridlocked = false;
 
     const Rectangle selectionHitbox = EditorSelectionGetRect();
 
-    for (LinkedList::Node *node = GetEntityListHead();
-        node != 0;
-        node = node->next) {
+    if (GAME_STATE->mode == MODE_IN_LEVEL) {
 
-        if (GAME_STATE->mode == MODE_IN_LEVEL) {
-
-            Level::Entity *entity = (Level::Entity *) node;
+        for (Level::Entity *entity : Level::ENTITIES) {
             
             if (entity->tags & Level::IS_PLAYER) continue;
 
@@ -191,37 +192,39 @@ static void updateEntitySelectionList() {
                 // Only the moving platform's anchors are checked for collision and go into the entity selection
                 auto p = (MovingPlatform *) entity;
                 if (CheckCollisionRecs(selectionHitbox, p->startAnchor.hitbox))
-                    EDITOR_STATE->selectedEntities.push_back(&p->startAnchor);
+                    EDITOR_STATE->selectedEntities.push_back(p->startAnchor.handle);
                 if (CheckCollisionRecs(selectionHitbox, p->endAnchor.hitbox))
-                    EDITOR_STATE->selectedEntities.push_back(&p->endAnchor);
+                    EDITOR_STATE->selectedEntities.push_back(p->endAnchor.handle);
 
                 continue;
             }
 
             // generic entity
             else if (!entity->IsDisabled() && CheckCollisionRecs(selectionHitbox, entity->hitbox)) {
-                EDITOR_STATE->selectedEntities.push_back(entity);
+                EDITOR_STATE->selectedEntities.push_back(entity->handle);
                 if (entity->tags & Level::IS_GRIDLOCKED) EDITOR_STATE->isSelectionGridlocked = true;
                 continue;
             }            
 
             // generic entity's origin ghost
             else if (CheckCollisionRecs(selectionHitbox, entity->GetOriginHitbox())) {
-                EDITOR_STATE->selectedEntities.push_back(entity);
+                EDITOR_STATE->selectedEntities.push_back(entity->handle);
                 if (entity->tags & Level::IS_GRIDLOCKED) EDITOR_STATE->isSelectionGridlocked = true;
                 continue;
             }
-
         }
+    }
 
-        else if (GAME_STATE->mode == MODE_OVERWORLD) {
+    else if (GAME_STATE->mode == MODE_OVERWORLD) {
+
+        for (LinkedList::Node *node = OW_STATE->listHead; node != 0; node = node->next) {
             
             OverworldEntity *entity = (OverworldEntity *) node;
             
             if (entity->tags & OW_IS_CURSOR) continue;
 
             if (CheckCollisionRecs(selectionHitbox, OverworldEntitySquare(entity))) {
-                EDITOR_STATE->selectedEntities.push_back(entity);
+                EDITOR_STATE->selectedOverworldEntities.push_back(entity);
                 EDITOR_STATE->isSelectionGridlocked = true;
                 continue;
             }
@@ -232,52 +235,50 @@ static void updateEntitySelectionList() {
 void selectEntitiesApplyMove() {
 
     // Searches for collision 
-    for (auto node = EDITOR_STATE->selectedEntities.begin(); node < EDITOR_STATE->selectedEntities.end(); node++) {
-
-        switch (GAME_STATE->mode) {
+    switch (GAME_STATE->mode) {
 
-        case MODE_IN_LEVEL: {
-            Level::Entity *entity = (Level::Entity *) *node;
+    case MODE_IN_LEVEL:
+        for (auto handle : EDITOR_STATE->selectedEntities) {
+            Level::Entity *entity = Level::EntityGet(handle);
+            if (!entity) continue;
             Rectangle hitbox = entity->hitbox;
             Vector2 pos = EditorEntitySelectionCalcMove(RectangleGetPos(hitbox));
             RectangleSetPos(&hitbox, pos);
             if (Level::CheckCollisionWithAnythingElse(hitbox, EDITOR_STATE->selectedEntities))
                 return;
-            break;
         }
+        break;
 
-        case MODE_OVERWORLD: {
-            OverworldEntity *entity = (OverworldEntity *) *node;
+    case MODE_OVERWORLD:
+        for (auto node : EDITOR_STATE->selectedOverworldEntities) {
+            OverworldEntity *entity = (OverworldEntity *) node;
             Rectangle hitbox = OverworldEntitySquare(entity);
             Vector2 pos = EditorEntitySelectionCalcMove(RectangleGetPos(hitbox));
             RectangleSetPos(&hitbox, pos);
-            if (OverworldCheckCollisionWithAnyTileExcept(hitbox, EDITOR_STATE->selectedEntities))
+            if (OverworldCheckCollisionWithAnyTileExcept(hitbox, EDITOR_STATE->selectedOverworldEntities))
                 return;
-            break;
-        }
-
         }
+        break;
     }
 
     // Apply move
-    for (auto node = EDITOR_STATE->selectedEntities.begin(); node < EDITOR_STATE->selectedEntities.end(); node++) {
-        
-        switch (GAME_STATE->mode) {
+    switch (GAME_STATE->mode) {
 
-        case MODE_IN_LEVEL: {
-            Level::Entity *entity = (Level::Entity *) *node;
+    case MODE_IN_LEVEL:
+        for (auto handle : EDITOR_STATE->selectedEntities) {
+            Level::Entity *entity = Level::EntityGet(handle);
+            if (!entity) continue;
             entity->SetHitboxPos(EditorEntitySelectionCalcMove(RectangleGetPos(entity->hitbox)));
             entity->SetOrigin(EditorEntitySelectionCalcMove(entity->origin));
-            break;
         }
+        break;
 
-        case MODE_OVERWORLD: {
-            OverworldEntity *entity = (OverworldEntity *) *node;
+    case MODE_OVERWORLD:
+        for (auto node : EDITOR_STATE->selectedOverworldEntities) {
+            OverworldEntity *entity = (OverworldEntity *) node;
             entity->gridPos = EditorEntitySelectionCalcMove(entity->gridPos);
-            break;
-        }
-
         }
+        break;
     }
     
     EDITOR_STATE->entitySelectionCoords.start =
@@ -291,7 +292,8 @@ void selectEntitiesApplyMove() {
 void EditorInitialize() {
 
     EDITOR_STATE = (EditorState *) MemAlloc(sizeof(EditorState));
-    EDITOR_STATE->selectedEntities = std::vector<LinkedList::Node *>();
+    EDITOR_STATE->selectedEntities = std::vector<Level::EntityHandle>();
+    EDITOR_STATE->selectedOverworldEntities = std::vector<LinkedList::Node *>();
 
     editorStateReset();
 
@@ -420,15 +422,23 @@ void EditorSelectionCancel() {
     EDITOR_STATE->isMovingSelectedEntities = false;
     EDITOR_STATE->isSelectionGridlocked = false;
     EDITOR_STATE->selectedEntities.clear();
+    EDITOR_STATE->selectedOverworldEntities.clear();
 
     TraceLog(LOG_TRACE, "Editor's entity selection canceled.");
 }
 
+bool EditorSelectionIsEmpty() {
+
+    if (GAME_STATE->mode == MODE_OVERWORLD) return EDITOR_STATE->selectedOverworldEntities.empty();
+
+    return EDITOR_STATE->selectedEntities.empty();
+}
+
 bool EditorSelectedEntitiesMove(Vector2 cursorPos) {
 
     EditorState *s = EDITOR_STATE;
 
-    if (s->selectedEntities.empty()) {
+    if (EditorSelectionIsEmpty()) {
         TraceLog(LOG_ERROR,
                     "Editor tried to check selection move, but there are no entities selected.");
         return false;
@@ -438,23 +448,22 @@ bool EditorSelectedEntitiesMove(Vector2 cursorPos) {
 
         bool clickedOnASelectedEntity = false;
 
-        for (auto e = s->selectedEntities.begin(); e != s->selectedEntities.end(); e++) {
-
-            // Overworld
+        // Overworld
 
-            if (GAME_STATE->mode == MODE_OVERWORLD) {
+        for (auto e = s->selectedOverworldEntities.begin(); e != s->selectedOverworldEntities.end(); e++) {
 
-                if (CheckCollisionPointRec(cursorPos, OverworldEntitySquare((OverworldEntity *) *e))) {
-
-                    clickedOnASelectedEntity = true; break;
-                }
+            if (CheckCollisionPointRec(cursorPos, OverworldEntitySquare((OverworldEntity *) *e))) {
 
-                continue;
+                clickedOnASelectedEntity = true; break;
             }
+        }
 
-            // In level
+        // In level
+
+        for (auto e = s->selectedEntities.begin(); e != s->selectedEntities.end(); e++) {
 
-            auto entity = (Level::Entity *) *e;
+            auto entity = Level::EntityGet(*e);
+            if (!entity) continue;
 
             if (entity->tags & Level::IS_MOVING_PLATFORM) {
                 auto p = (MovingPlatform *) entity;
@@ -6,9 +6,10 @@
 #include <raylib.h>
 #include <vector>
 
-#include "assets.hpp"
+#include "sprites.hpp"
 #include "linked_list.hpp"
 #include "core.hpp"
+#include "level/entity_store.hpp"
 
 
 // The background color of the editor
@@ -119,7 +120,8 @@ typedef struct EditorState {
     bool                            isSelectingEntities;
     bool                            selectedEntitiesThisFrame;
     Trajectory                      entitySelectionCoords;
-    std::vector<LinkedList::Node *> selectedEntities;
+    std::vector<Level::EntityHandle> selectedEntities; // In level
+    std::vector<LinkedList::Node *> selectedOverworldEntities;
     bool                            isSelectionGridlocked;
 
     // Moving selected entities
@@ -130,6 +132,10 @@ typedef struct EditorState {
 } EditorState;
 
 
+/*
+    The simulation reads EDITOR_STATE, and calls EditorSync(), EditorEmpty(), EditorSelectionCancel()
+    and EditorEntitySelectionCalcMove(). The headless runner has no editor, and stubs them out.
+*/
 extern EditorState *EDITOR_STATE;
 
 
@@ -165,6 +171,9 @@ void EditorSelectEntities(Vector2 cursorPos);
 // Cancels the selection of entities.
 void EditorSelectionCancel();
 
+// If there are no entities selected
+bool EditorSelectionIsEmpty();
+
 // Moves a cluster of selected entities, if the cursor is above one.
 // Otherwise, returns false;
 bool EditorSelectedEntitiesMove(Vector2 cursorPos);
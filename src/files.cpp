@@ -1,11 +1,19 @@
 #include <stdio.h>
+#include <string.h>
 #include <raylib.h>
 #include <string>
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <sys/stat.h>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 #include "files.hpp"
+#include "pack.hpp"
 
 #define MODE_READ   (char *) "ab+"
 #define MODE_WRITE  (char *) "wb+"
@@ -82,6 +90,14 @@ static bool writeToFile(FILE *file, FileData data) {
 
 FileData DataLoad(char *filepath, size_t itemSize) {
 
+    std::string_view packed;
+    if (Pack::Find(filepath, &packed)) {
+
+        FileData data = { MemAlloc(packed.size()), itemSize, packed.size() / itemSize };
+        memcpy(data.data, packed.data(), packed.size());
+        return data;
+    }
+
     FILE *file = openFile(filepath, MODE_READ);
     rewind(file);
     FileData data = readFromFile(file, itemSize);
@@ -99,11 +115,18 @@ bool DataSave(char *filepath, FileData data) {
 
 std::string TextLoad(std::string filepath) {
 
-    std::stringstream buffer;
-    std::ifstream file(filepath);
-    buffer << file.rdbuf();
-    file.close();
-    return buffer.str();
+    std::string_view packed;
+    if (Pack::Find(filepath, &packed)) return std::string(packed);
+
+    std::ifstream file(filepath, std::ios_base::binary | std::ios_base::ate);
+    if (!file) return std::string();
+
+    // Straight into the string, in one read
+    std::string text(file.tellg(), '\0');
+    file.seekg(0);
+    file.read(text.data(), text.size());
+
+    return text;
 }
 
 void TextSave(std::string filepath, std::string data) {
@@ -114,4 +137,85 @@ void TextSave(std::string filepath, std::string data) {
     file.close();
 }
 
+bool BinarySave(std::string filepath, std::string_view data) {
+
+    std::ofstream file(filepath, std::ios_base::binary | std::ios_base::trunc);
+    file.write(data.data(), data.size());
+
+    if (!file) {
+        TraceLog(LOG_ERROR, "Could not write file %s.", filepath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool Exists(const std::string &filepath) {
+
+    struct stat status;
+    return stat(filepath.c_str(), &status) == 0;
+}
+
+long ModTime(const std::string &filepath) {
+
+    struct stat status;
+    if (stat(filepath.c_str(), &status) != 0) return 0;
+
+    return (long) status.st_mtime;
+}
+
+#if !defined(_WIN32)
+
+MappedFile Map(const char *filepath) {
+
+    MappedFile mapped = { 0, 0 };
+
+    int file = open(filepath, O_RDONLY);
+    if (file < 0) {
+        TraceLog(LOG_ERROR, "Could not open file %s.", filepath);
+        return mapped;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) == 0 && status.st_size > 0) {
+
+        void *data = mmap(0, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (data != MAP_FAILED) {
+            mapped.data = (const unsigned char *) data;
+            mapped.size = status.st_size;
+        } else {
+            TraceLog(LOG_ERROR, "Could not map file %s.", filepath);
+        }
+    }
+
+    // The mapping outlives the descriptor
+    close(file);
+
+    return mapped;
+}
+
+void Unmap(MappedFile file) {
+
+    if (file.data) munmap((void *) file.data, file.size);
+}
+
+#else
+
+// Including windows.h clashes with raylib, so the file is read instead
+MappedFile Map(const char *filepath) {
+
+    int size = 0;
+    unsigned char *data = LoadFileData(filepath, &size);
+
+    return { data, (size_t) size };
+}
+
+void Unmap(MappedFile file) {
+
+    UnloadFileData((unsigned char *) file.data);
+}
+
+#endif
+
 } // namespace
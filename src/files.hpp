@@ -3,6 +3,7 @@
 
 
 #include "string"
+#include "string_view"
 
 
 namespace Files {
@@ -21,6 +22,26 @@ bool DataSave(char *filepath, FileData data);
 std::string TextLoad(std::string filepath);
 void TextSave(std::string filepath, std::string data);
 
+bool BinarySave(std::string filepath, std::string_view data);
+
+
+// If the file is on disk. Unlike the loading functions, it doesn't look in the pack.
+bool Exists(const std::string &filepath);
+
+// When the file on disk was last modified, or 0 if it isn't there
+long ModTime(const std::string &filepath);
+
+
+// A file mapped read only into memory
+typedef struct MappedFile {
+    const unsigned char *data;
+    size_t size;
+} MappedFile;
+
+// Maps the whole file into memory, or reads it where there's no mmap. 'data' is 0 if it fails.
+MappedFile Map(const char *filepath);
+void Unmap(MappedFile file);
+
 
 } // namespace
 
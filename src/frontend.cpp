@@ -0,0 +1,131 @@
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "frontend.hpp"
+#include "core.hpp"
+#include "assets.hpp"
+#include "overworld.hpp"
+#include "camera.hpp"
+#include "level/level.hpp"
+#include "editor.hpp"
+#include "render.hpp"
+#include "debug.hpp"
+#include "text_bank.hpp"
+#include "input.hpp"
+#include "sounds.hpp"
+#include "menu.hpp"
+
+
+static size_t mouseEnabledReferences = 0;
+
+
+static void windowTitleUpdate() {
+
+    char title[LEVEL_NAME_BUFFER_SIZE + 20];
+
+    if (Level::STATE->levelName[0] != '\0')
+        sprintf(title, "%s - %d FPS", Level::STATE->levelName, GetFPS());  
+    else
+        sprintf(title, "Jogo de Plataforma - %d FPS", GetFPS());  
+
+    SetWindowTitle(title);
+}
+
+void SystemsInitialize() {
+
+    srand(time(NULL));
+
+    InitAudioDevice();
+    // while (!IsAudioDeviceReady()) {}
+
+    Input::Initialize();
+    AssetsInitialize();
+    GameStateInitialize();
+    CameraInitialize();
+    EditorInitialize();
+    OverworldInitialize();
+    Level::Initialize();
+    Render::Initialize();
+    Sounds::Initialize();
+    TextBank::LoadFromDisk();
+
+    EditorDisable();
+    DebugHudDisable();
+    MouseCursorDisable();
+}
+
+void FrontendUpdate() {
+
+    if (EDITOR_STATE->isEnabled)
+        EditorTick();
+
+    Sounds::Tick();
+
+    windowTitleUpdate();
+}
+
+void DebugHudEnable() {
+
+    GAME_STATE->showDebugHUD = true;
+    MouseCursorEnable();
+    TraceLog(LOG_TRACE, "Debug hud enabled.");
+}
+
+void DebugHudDisable() {
+
+    GAME_STATE->showDebugHUD = false;
+    MouseCursorDisable();
+    CameraPanningReset();
+    TraceLog(LOG_TRACE, "Debug hud disabled.");
+}
+
+void MouseCursorDisable() {
+
+    if (mouseEnabledReferences > 0) mouseEnabledReferences--;
+    if (mouseEnabledReferences == 0) HideCursor();
+    TraceLog(LOG_TRACE, "Mouse enabled references down to %d.", mouseEnabledReferences);
+}
+
+void MouseCursorEnable() {
+
+    mouseEnabledReferences++;
+    ShowCursor();
+    TraceLog(LOG_TRACE, "Mouse enabled references increased to %d.", mouseEnabledReferences);
+}
+
+void DebugHudToggle() {
+
+    if (GAME_STATE->showDebugHUD) {
+        DebugEntityStopAll();
+        DebugHudDisable();
+    }
+    else {
+        DebugHudEnable();
+    }
+}
+
+bool IsInMouseArea(Vector2 pos) {
+
+    float w = GetScreenWidth();
+    float h = GetScreenHeight();
+
+    if (EDITOR_STATE->isEnabled) {
+        auto bar = EditorBarGetRect();
+        w -= bar.width;
+    }
+    
+    return pos.x >= 0 &&
+            pos.x <= w &&
+            pos.y >= 0 &&
+            pos.y <= h;
+}
+
+void MenuAddSettingsItems(Menu *menu) {
+
+    menu->AddItem(new MenuItemToggle("Som", &Sounds::Toggle, &Sounds::IsEnabled));
+    menu->AddItem(new MenuItemToggle("Tela cheia", &Render::FullscreenToggle, &Render::IsFullscreen));
+    menu->AddItem(new MenuItemToggle("Shader CRT", &Render::CrtToggle, &Render::IsCrtEnabled));
+    menu->AddItem(new MenuItemToggle("Resolução dinâmica", &Render::DynamicResolutionToggle, &Render::IsDynamicResolutionEnabled));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <raylib.h>
+
+
+/*
+    What runs the game in a window: the renderer, the audio, the input and the editor,
+    around the simulation in the core. The headless runner has none of it.
+*/
+
+
+// Initialize the game's systems, the simulation's and the window's
+void SystemsInitialize();
+
+// Updates what isn't simulated: the editor, the music and the window's title. To be called once every frame.
+void FrontendUpdate();
+
+// The area of the screen that's interactable
+bool IsInMouseArea(Vector2 pos);
+
+// Enables the debug HUD
+void DebugHudEnable();
+
+// Disables the debug HUD
+void DebugHudDisable();
+
+// Disables mouse cursor, if not in use
+void MouseCursorDisable();
+
+// Enables the mouse cursor
+void MouseCursorEnable();
+
+// Toggles the debug HUD between 'enabled' and 'disabled'
+void DebugHudToggle();
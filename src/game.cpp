@@ -1,9 +1,15 @@
 #include <raylib.h>
+#include <string.h>
+#include <stdlib.h>
 
 #include "core.hpp"
+#include "frontend.hpp"
 #include "render.hpp"
 #include "input.hpp"
 #include "overworld.hpp"
+#include "replay.hpp"
+#include "pack.hpp"
+#include "persistence.hpp"
 
 void initWindow() {
 
@@ -26,15 +32,22 @@ void initWindow() {
     SetWindowSize(SCREEN_WIDTH, SCREEN_HEIGHT);
 }
 
-int main() {
+// jogo_plataforma [--replay <replay file>] [--render-scale <min> <max>] [--max-fps <fps, 0 for uncapped>] [--pack <pack file>]
+int main(int argc, char **argv) {
 
     SetTraceLogLevel(LOG_DEBUG);
 
+    // Opened before anything is loaded, so whatever it has is loaded from it
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--pack") == 0) Pack::Open(argv[i + 1]);
+    }
+
     initWindow();
 
     SetExitKey(KEY_NULL); 
 
-    SetTargetFPS(60);
+    // The frame rate is capped by Render, not raylib, as the simulation runs at TICKS_PER_SECOND regardless
+    // and rendering interpolates between ticks
 
     SystemsInitialize();
 
@@ -42,15 +55,48 @@ int main() {
 
     OverworldLoad();
 
+    for (int i = 1; i < argc; i++) {
+
+        if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            Replay::PlaybackStart(argv[++i]);
+        }
+
+        // The bounds of the dynamic resolution, e.g. lower for slower machines
+        else if (strcmp(argv[i], "--render-scale") == 0 && i + 2 < argc) {
+            Render::DynamicResolutionConfigure(atof(argv[i + 1]), atof(argv[i + 2]), DYNAMIC_RESOLUTION_FRAME_TIME);
+            i += 2;
+        }
+
+        // E.g. higher for monitors that report the wrong refresh rate
+        else if (strcmp(argv[i], "--max-fps") == 0 && i + 1 < argc) {
+            Render::FrameRateCapSet(atoi(argv[++i]));
+        }
+
+        else if (strcmp(argv[i], "--pack") == 0) {
+            i++; // already open
+        }
+    }
+
+    double lastFrameTime = GetTime();
+
     while (!WindowShouldClose())    // Detect window close button or ESC key
     {
+        double now = GetTime();
+
         Input::Handle();
 
-        GameUpdate();
+        GameUpdateFrame(now - lastFrameTime);
+        lastFrameTime = now;
+
+        FrontendUpdate();
 
         Render::Render();
     }
 
     CloseWindow();
+
+    PersistenceLevelPrefetchStop();
+    Pack::Close();
+
     return 0;
 }
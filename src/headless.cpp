@@ -0,0 +1,601 @@
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <new>
+
+#include "core.hpp"
+#include "sprites.hpp"
+#include "camera.hpp"
+#include "editor.hpp"
+#include "overworld.hpp"
+#include "persistence.hpp"
+#include "text_bank.hpp"
+#include "replay.hpp"
+#include "files.hpp"
+#include "persistence_binary.hpp"
+#include "pack.hpp"
+#include "level/level.hpp"
+#include "level/player.hpp"
+#include "level/block.hpp"
+
+
+/*
+    Runs the level simulation with no window, audio device or GPU, as fast as it can,
+    and reports how fast it ticked and how much it allocated.
+
+        jogo_headless <level file> [ticks]
+
+    Or plays back a recorded replay, checking that it plays out the same as when it was recorded.
+
+        jogo_headless --replay <replay file>
+
+    Or loads generated levels of growing sizes, up to the given number of entities,
+    checking that the time it takes to load them grows linearly with their size,
+    and that loading them doesn't allocate for each entity.
+    Each level is also converted to the binary format, and loaded again from it.
+
+        jogo_headless --benchmark-load [entities]
+
+    Or fills the level with thousands of extra blocks and times finding the ground beneath things
+    with the ground index against scanning all entities, checking that both find the same grounds.
+
+        jogo_headless --benchmark-ground <level file>
+
+    Or prefetches the level the way the overworld's cursor does and loads it right away, checking that
+    loading doesn't wait for the prefetcher, and then once it's prefetched, checking that both load the same level.
+
+        jogo_headless --check-prefetch <level file>
+
+    Like the game, it looks for the level in the levels folder, and for the
+    assets in the assets folder, so it should be run from the build folder.
+    It links only the simulation, with the frontend stubbed out in headless_frontend.cpp,
+    so it builds and runs without a window system, GL or an audio device.
+    Any of these can be preceded by --pack <pack file>, to read what the pack has from it.
+*/
+
+
+#define DEFAULT_TICKS   10000
+
+#define DEFAULT_BENCHMARK_ENTITIES  50000
+
+// The level the load benchmark generates, in the levels folder
+#define BENCHMARK_LEVEL_NAME        "_load_benchmark.lvl"
+#define BENCHMARK_BINARY_LEVEL_NAME "_load_benchmark" LEVEL_BINARY_FILE_EXTENSION
+
+// How many times larger each benchmark level is than the previous one
+#define BENCHMARK_GROWTH            2
+#define BENCHMARK_STEPS             4
+
+// The extra blocks and queries of the ground beneath benchmark
+#define GROUND_BENCHMARK_BLOCKS             10000
+#define GROUND_BENCHMARK_BLOCKS_PER_ROW     100
+#define GROUND_BENCHMARK_QUERIES            1000
+
+// The prefetch check keeps the prefetcher busy reading a level this large while the level is loaded
+#define PREFETCH_CHECK_BUSY_ENTITIES        200000
+
+// How long the prefetch check waits for the level to be prefetched
+#define PREFETCH_CHECK_TIMEOUT_SECONDS      30
+
+// How many updates a playback can go without ticking, e.g. while the level's exit transition plays,
+// before it's taken as stuck
+#define PLAYBACK_MAX_IDLE_UPDATES   (TICKS_PER_SECOND * 10)
+
+// Linear loading keeps the time per entity about the same at any size, so more than this is not linear
+#define BENCHMARK_MAX_SCALING       1.5
+
+// Loading makes room for the whole level up front, so the allocations left are a few per level, not per entity
+#define BENCHMARK_MAX_ALLOCATIONS_PER_ENTITY    0.1
+
+
+// Heap allocations made through operator new since the program started
+static size_t allocationCount = 0;
+
+void *operator new(size_t size) {
+
+    allocationCount++;
+
+    if (void *ptr = malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept {
+    (void) size;
+    free(ptr);
+}
+
+
+// From the part of raylib with the window, that isn't linked here. It's called by
+// ExportDataAsCode() in raylib's utils.c, which the simulation never calls.
+const char *GetFileNameWithoutExt(const char *filePath) {
+    return filePath;
+}
+
+// The game's SystemsInitialize(), minus the window, the audio, the input, the renderer and the editor
+static void initializeHeadless() {
+
+    SpritesInitializeHeadless();
+    GameStateInitialize();
+    CameraInitialize();
+    OverworldInitialize();
+    Level::Initialize();
+    TextBank::LoadFromDisk();
+}
+
+static void printPoolStats() {
+
+    for (Level::EntityPool *pool : Level::EntityPools()) {
+
+        if (!pool->ReservedBytes()) continue;
+
+        printf("  %s: %zu live, %zu allocations, %.1f/%.1f KB\n", pool->typeName.c_str(), pool->liveCount,
+                pool->allocationCount, pool->LiveBytes() / 1024.0f, pool->ReservedBytes() / 1024.0f);
+    }
+}
+
+static int playBack(const char *filePath) {
+
+    if (!Replay::PlaybackStart(filePath)) {
+        fprintf(stderr, "Couldn't read replay: %s\n", filePath);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned long lastTickCount = Replay::TickCount();
+    int idleUpdates = 0;
+
+    while (Replay::IsPlayingBack()) {
+
+        GameUpdate();
+
+        if (Replay::TickCount() != lastTickCount) {
+            lastTickCount = Replay::TickCount();
+            idleUpdates = 0;
+        }
+        else if (++idleUpdates > PLAYBACK_MAX_IDLE_UPDATES) {
+            printf("Replay %s stopped ticking at tick %lu\n", filePath, lastTickCount);
+            return 1;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    unsigned long ticks = Replay::TickCount();
+
+    printf("Replay %s of %s: %lu ticks in %.3f s (%.0f ticks/s)\n", filePath, Level::STATE->levelName,
+            ticks, elapsed.count(), ticks / elapsed.count());
+
+    if (Replay::PlaybackDivergedAt() != -1) {
+        printf("Diverged from the recording at tick %ld\n", Replay::PlaybackDivergedAt());
+        return 1;
+    }
+
+    printf("Matched the recording\n");
+    return 0;
+}
+
+// A level of about this many entities: rows of blocks, with coins and acid blocks above them
+static std::string generateLevel(long entityCount) {
+
+    std::string data = "levelname:" BENCHMARK_LEVEL_NAME "\n";
+    data += "player:originX=0.000000;originY=-200.000000;\n";
+
+    const long rowLength = 500;
+    char line[200];
+
+    for (long i = 0; i < entityCount - 1; i++) {
+
+        const long x = (i % rowLength) * 32;
+        const long y = (i / rowLength) * 32 * 4;
+
+        switch (i % 10) {
+        case 0:
+            snprintf(line, sizeof(line), "coin:originX=%ld.000000;originY=%ld.000000;\n", x, y - 64);
+            break;
+        case 1:
+            snprintf(line, sizeof(line), "acid_block:originX=%ld.000000;originY=%ld.000000;\n", x, y - 32);
+            break;
+        default:
+            snprintf(line, sizeof(line), "block:originX=%ld.000000;originY=%ld.000000;rotation=0;tileType=2SidesOpp;\n", x, y);
+        }
+
+        data += line;
+    }
+
+    return data;
+}
+
+// Loads the level, returning how long it took
+static double timeLoad(char *levelName, size_t *allocations) {
+
+    size_t allocationsBeforeLoading = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+
+    Level::Load(levelName);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    *allocations = allocationCount - allocationsBeforeLoading;
+
+    return elapsed.count();
+}
+
+static int benchmarkLoad(long maxEntities) {
+
+    const std::string levelPath = "../levels/" BENCHMARK_LEVEL_NAME;
+    const std::string binaryLevelPath = "../levels/" BENCHMARK_BINARY_LEVEL_NAME;
+    char levelName[LEVEL_NAME_BUFFER_SIZE] = BENCHMARK_LEVEL_NAME;
+
+    double firstTimePerEntity = 0;
+    double lastTimePerEntity = 0;
+    double maxAllocationsPerEntity = 0;
+
+    long entityCount = maxEntities;
+    for (int step = 1; step < BENCHMARK_STEPS; step++) entityCount /= BENCHMARK_GROWTH;
+
+    for (int step = 0; step < BENCHMARK_STEPS; step++, entityCount *= BENCHMARK_GROWTH) {
+
+        const std::string text = generateLevel(entityCount);
+
+        // Or the binary level of the last step would be loaded instead
+        remove(binaryLevelPath.c_str());
+        Files::TextSave(levelPath, text);
+
+        size_t allocations;
+        double elapsed = timeLoad(levelName, &allocations);
+        size_t loaded = Level::ENTITIES.Count();
+
+        lastTimePerEntity = elapsed / loaded;
+        if (step == 0) firstTimePerEntity = lastTimePerEntity;
+
+        maxAllocationsPerEntity = std::max(maxAllocationsPerEntity, (double) allocations / loaded);
+
+        printf("%7zu entities loaded in %8.2f ms: %.2f us/entity, %.3f allocations/entity\n", loaded,
+                elapsed * 1000, lastTimePerEntity * 1e6, (double) allocations / loaded);
+
+        std::string binary;
+        if (!PersistenceBinaryFromText(text, &binary) || !Files::BinarySave(binaryLevelPath, binary)) {
+            printf("Could not convert the level to binary\n");
+            remove(levelPath.c_str());
+            return 1;
+        }
+
+        double binaryElapsed = timeLoad(levelName, &allocations);
+
+        maxAllocationsPerEntity = std::max(maxAllocationsPerEntity, (double) allocations / Level::ENTITIES.Count());
+
+        printf("%7zu entities loaded in %8.2f ms from binary: %.2f us/entity, %.3f allocations/entity, %zu KB instead of %zu KB\n",
+                Level::ENTITIES.Count(), binaryElapsed * 1000, binaryElapsed / Level::ENTITIES.Count() * 1e6,
+                (double) allocations / Level::ENTITIES.Count(), binary.size() / 1024, text.size() / 1024);
+    }
+
+    remove(levelPath.c_str());
+    remove(binaryLevelPath.c_str());
+
+    int sizeRatio = 1;
+    for (int step = 1; step < BENCHMARK_STEPS; step++) sizeRatio *= BENCHMARK_GROWTH;
+
+    double scaling = lastTimePerEntity / firstTimePerEntity;
+    printf("Time per entity went x%.2f from the smallest level to one %d times larger (x1 is linear)\n",
+            scaling, sizeRatio);
+
+    if (scaling > BENCHMARK_MAX_SCALING) {
+        printf("Loading is not linear\n");
+        return 1;
+    }
+
+    printf("Loading is linear\n");
+
+    if (maxAllocationsPerEntity > BENCHMARK_MAX_ALLOCATIONS_PER_ENTITY) {
+        printf("Loading allocates %.3f times per entity, more than the %.3f allowed\n",
+                maxAllocationsPerEntity, BENCHMARK_MAX_ALLOCATIONS_PER_ENTITY);
+        return 1;
+    }
+
+    printf("Loading allocates %.3f times per entity at most\n", maxAllocationsPerEntity);
+    return 0;
+}
+
+// The ground beneath the hitbox, going through all the level entities instead of the ground index
+static Level::Entity *groundBeneathByScan(Rectangle hitbox, Level::Entity *entity) {
+
+    Level::Entity *foundGround = 0;
+
+    for (Level::Entity *possibleGround : Level::ENTITIES) {
+
+        if (Level::IsBetterGroundBeneath(hitbox, entity, possibleGround, foundGround))
+            foundGround = possibleGround;
+    }
+
+    return foundGround;
+}
+
+static int benchmarkGround(char *levelName) {
+
+    if (!PersistenceLevelExists(levelName)) {
+        fprintf(stderr, "Level not found: %s\n", levelName);
+        return 1;
+    }
+
+    Level::Load(levelName);
+
+    // Far away from anything in the level, so it doesn't mess with it
+    const Vector2 start = { -1000000, -1000000 };
+
+    std::vector<Level::Entity *> blocks;
+    blocks.reserve(GROUND_BENCHMARK_BLOCKS);
+
+    for (int i = 0; i < GROUND_BENCHMARK_BLOCKS; i++) {
+
+        // Spaces out the rows, so there are surfaces to stand on
+        Vector2 origin = {
+            start.x + (i % GROUND_BENCHMARK_BLOCKS_PER_ROW) * LEVEL_GRID.width,
+            start.y + (i / GROUND_BENCHMARK_BLOCKS_PER_ROW) * LEVEL_GRID.height * 3
+        };
+
+        blocks.push_back(Block::Add(origin));
+    }
+
+    // Standing over a block, and between two blocks, facing both sides
+    std::vector<Rectangle> queries;
+    queries.reserve(GROUND_BENCHMARK_QUERIES);
+
+    for (int i = 0; queries.size() < GROUND_BENCHMARK_QUERIES; i++) {
+
+        Rectangle block = blocks[(i * 7919) % GROUND_BENCHMARK_BLOCKS]->hitbox;
+        float xOffset = (i % 2) ? block.width / 2 : 0;
+
+        queries.push_back({ block.x + xOffset, block.y - block.height, block.width, block.height });
+    }
+
+    Level::Entity facingRight, facingLeft;
+    facingRight.isFacingRight = true;
+    facingLeft.isFacingRight = false;
+
+    int foundByIndex = 0, foundByScan = 0, mismatches = 0;
+
+    auto indexStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i++) {
+        Level::Entity *entity = (i % 4 < 2) ? &facingRight : &facingLeft;
+        entity->hitbox = queries[i];
+        if (Level::GetGroundBeneath(entity)) foundByIndex++;
+    }
+    std::chrono::duration<double> indexTime = std::chrono::steady_clock::now() - indexStart;
+
+    auto scanStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i++) {
+        Level::Entity *entity = (i % 4 < 2) ? &facingRight : &facingLeft;
+        if (groundBeneathByScan(queries[i], entity)) foundByScan++;
+    }
+    std::chrono::duration<double> scanTime = std::chrono::steady_clock::now() - scanStart;
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        Level::Entity *entity = (i % 4 < 2) ? &facingRight : &facingLeft;
+        entity->hitbox = queries[i];
+        if (Level::GetGroundBeneath(entity) != groundBeneathByScan(queries[i], entity)) mismatches++;
+    }
+
+    printf("%d queries over %d extra blocks: index took %.3f ms, scan took %.3f ms (%.1fx)\n",
+            GROUND_BENCHMARK_QUERIES, GROUND_BENCHMARK_BLOCKS, indexTime.count() * 1000, scanTime.count() * 1000,
+            scanTime.count() / indexTime.count());
+
+    if (mismatches || foundByIndex != GROUND_BENCHMARK_QUERIES || foundByScan != GROUND_BENCHMARK_QUERIES) {
+        printf("The index found %d grounds, the scan found %d, and %d queries disagreed\n",
+                foundByIndex, foundByScan, mismatches);
+        return 1;
+    }
+
+    printf("The index and the scan found the same grounds\n");
+    return 0;
+}
+
+// Loads the level, telling if it's the same as the reference one
+static bool loadsSameLevel(char *levelName, size_t entityCount, uint32_t hash) {
+
+    Level::Load(levelName);
+
+    return Level::ENTITIES.Count() == entityCount && Level::StateHash() == hash;
+}
+
+static int checkPrefetch(char *levelName) {
+
+    if (!PersistenceLevelExists(levelName)) {
+        fprintf(stderr, "Level not found: %s\n", levelName);
+        return 1;
+    }
+
+    const std::string busyLevelPath = "../levels/" BENCHMARK_LEVEL_NAME;
+    char busyLevelName[LEVEL_NAME_BUFFER_SIZE] = BENCHMARK_LEVEL_NAME;
+
+    // Without prefetching
+    Level::Load(levelName);
+    const size_t entityCount = Level::ENTITIES.Count();
+    const uint32_t hash = Level::StateHash();
+
+    remove("../levels/" BENCHMARK_BINARY_LEVEL_NAME);
+    Files::TextSave(busyLevelPath, generateLevel(PREFETCH_CHECK_BUSY_ENTITIES));
+
+    // The cursor goes over a large level, and then over this one, which is entered right away
+    PersistenceLevelPrefetch(busyLevelName);
+    PersistenceLevelPrefetch(levelName);
+
+    auto start = std::chrono::steady_clock::now();
+    bool isSame = loadsSameLevel(levelName, entityCount, hash);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Waiting for the level would have meant waiting for the large one, read before it
+    bool waited = PersistenceLevelIsPrefetched(busyLevelName);
+
+    printf("Loaded %s in %.2f ms while it was being prefetched\n", levelName, elapsed.count() * 1000);
+
+    if (!isSame || waited) {
+        printf(!isSame ? "It's not the same level it loads without prefetching\n" : "Loading waited for the prefetcher\n");
+        PersistenceLevelPrefetchStop();
+        remove(busyLevelPath.c_str());
+        return 1;
+    }
+
+    // The cursor stays over it until it's read
+    PersistenceLevelPrefetch(levelName);
+
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(PREFETCH_CHECK_TIMEOUT_SECONDS);
+    while (!PersistenceLevelIsPrefetched(levelName) && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    bool wasPrefetched = PersistenceLevelIsPrefetched(levelName);
+    isSame = wasPrefetched && loadsSameLevel(levelName, entityCount, hash);
+
+    PersistenceLevelPrefetchStop();
+    remove(busyLevelPath.c_str());
+
+    if (!wasPrefetched) {
+        printf("%s wasn't prefetched in %d s\n", levelName, PREFETCH_CHECK_TIMEOUT_SECONDS);
+        return 1;
+    }
+
+    if (!isSame) {
+        printf("The prefetched level is not the same level it loads without prefetching\n");
+        return 1;
+    }
+
+    printf("Loading doesn't wait for the prefetcher, and loads the same level from it\n");
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc > 2 && strcmp(argv[1], "--pack") == 0) {
+
+        if (!Pack::Open(argv[2])) return 1;
+
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <level file> [ticks]\n"
+                        "       %s --replay <replay file>\n"
+                        "       %s --benchmark-load [entities]\n"
+                        "       %s --benchmark-ground <level file>\n"
+                        "       %s --check-prefetch <level file>\n", argv[0], argv[0], argv[0], argv[0], argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "--replay") == 0) {
+
+        if (argc < 3) {
+            fprintf(stderr, "Missing replay file\n");
+            return 1;
+        }
+
+        SetTraceLogLevel(LOG_WARNING);
+        initializeHeadless();
+
+        return playBack(argv[2]);
+    }
+
+    if (strcmp(argv[1], "--benchmark-load") == 0) {
+
+        long entities = argc > 2 ? atol(argv[2]) : DEFAULT_BENCHMARK_ENTITIES;
+        if (entities < BENCHMARK_STEPS * BENCHMARK_GROWTH) {
+            fprintf(stderr, "Invalid number of entities: %s\n", argv[2]);
+            return 1;
+        }
+
+        SetTraceLogLevel(LOG_WARNING);
+        initializeHeadless();
+
+        return benchmarkLoad(entities);
+    }
+
+    if (strcmp(argv[1], "--benchmark-ground") == 0) {
+
+        if (argc < 3) {
+            fprintf(stderr, "Missing level file\n");
+            return 1;
+        }
+
+        char levelName[LEVEL_NAME_BUFFER_SIZE] = { 0 };
+        strncpy(levelName, argv[2], LEVEL_NAME_BUFFER_SIZE - 1);
+
+        SetTraceLogLevel(LOG_WARNING);
+        initializeHeadless();
+
+        return benchmarkGround(levelName);
+    }
+
+    if (strcmp(argv[1], "--check-prefetch") == 0) {
+
+        if (argc < 3) {
+            fprintf(stderr, "Missing level file\n");
+            return 1;
+        }
+
+        char levelName[LEVEL_NAME_BUFFER_SIZE] = { 0 };
+        strncpy(levelName, argv[2], LEVEL_NAME_BUFFER_SIZE - 1);
+
+        SetTraceLogLevel(LOG_WARNING);
+        initializeHeadless();
+
+        return checkPrefetch(levelName);
+    }
+
+    long ticks = argc > 2 ? atol(argv[2]) : DEFAULT_TICKS;
+    if (ticks <= 0) {
+        fprintf(stderr, "Invalid number of ticks: %s\n", argv[2]);
+        return 1;
+    }
+
+    char levelName[LEVEL_NAME_BUFFER_SIZE] = { 0 };
+    strncpy(levelName, argv[1], LEVEL_NAME_BUFFER_SIZE - 1);
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    initializeHeadless();
+
+    if (!PersistenceLevelExists(levelName)) {
+        fprintf(stderr, "Level not found: %s\n", levelName);
+        return 1;
+    }
+
+    size_t allocationsBeforeLoading = allocationCount;
+
+    Level::Load(levelName);
+
+    if (!PLAYER) {
+        fprintf(stderr, "Level has no player: %s\n", levelName);
+        return 1;
+    }
+
+    printf("Level %s: %zu entities (%zu tickable), %zu allocations loading\n", levelName, Level::ENTITIES.Count(),
+            Level::ENTITIES.TickableCount(), allocationCount - allocationsBeforeLoading);
+
+    size_t allocationsBeforeTicking = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+
+    for (long i = 0; i < ticks; i++) GameUpdate();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    size_t tickingAllocations = allocationCount - allocationsBeforeTicking;
+
+    printf("%ld ticks in %.3f s: %.0f ticks/s, %.2f us/tick\n", ticks, elapsed.count(),
+            ticks / elapsed.count(), elapsed.count() * 1e6 / ticks);
+    printf("%zu allocations ticking (%.2f per tick)\n", tickingAllocations, (double) tickingAllocations / ticks);
+
+    if (GAME_STATE->mode != MODE_IN_LEVEL)
+        printf("The level was left before the last tick\n");
+
+    printf("Entity pools:\n");
+    printPoolStats();
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <raylib.h>
+#include <string>
+
+#include "render.hpp"
+#include "sounds.hpp"
+#include "editor.hpp"
+#include "menu.hpp"
+
+
+/*
+    What the simulation calls on the frontend, for the headless runner and the tools, which have no window,
+    audio device or editor: nothing is drawn or played, and the editor is never enabled.
+*/
+
+
+static EditorState disabledEditor;
+
+EditorState *EDITOR_STATE = &disabledEditor;
+
+
+namespace Render {
+
+void DrawTexture(Sprite *, Vector2, Color, int, bool) {}
+
+void DrawSceneLine(Vector2, Vector2, float, Color) {}
+
+void DrawSceneCircleLines(Vector2, float, Color) {}
+
+void DrawLevelEntity(Level::Entity *) {}
+
+void DrawLevelEntityOriginGhost(Level::Entity *) {}
+
+void DrawLevelEntityMoveGhost(Level::Entity *) {}
+
+void PrintSysMessage(const std::string &) {}
+
+void LevelTransitionEffectStart(Vector2, bool) {}
+
+} // namespace
+
+
+namespace Sounds {
+
+void PlayEffect(SoundId) {}
+
+void PlayMusic(SoundId) {}
+
+void StopMusic() {}
+
+} // namespace
+
+
+void EditorSync() {}
+
+void EditorEmpty() {}
+
+void EditorSelectionCancel() {}
+
+Vector2 EditorEntitySelectionCalcMove(Vector2 pos) {
+    return pos;
+}
+
+void MenuAddSettingsItems(Menu *) {}
+
@@ -4,21 +4,24 @@
 
 #include "input.hpp"
 #include "core.hpp"
+#include "frontend.hpp"
+#include "assets.hpp"
 #include "level/level.hpp"
 #include "level/player.hpp"
 #include "overworld.hpp"
 #include "camera.hpp"
 #include "persistence.hpp"
+#include "persistence_binary.hpp"
 #include "render.hpp"
 #include "editor.hpp"
 #include "debug.hpp"
 #include "menu.hpp"
+#include "replay.hpp"
+#include "render_stats.hpp"
 
 
 namespace Input {
 
-InputState STATE;
-
 
 bool isGamepadPressed(int button) {
     return IsGamepadButtonPressed(GAME_STATE->gamepadIdx, button);
@@ -80,6 +83,9 @@ void handleInLevelInput() {
     if (IsKeyPressed(KEY_F7))
         GAME_STATE->showBackground = !GAME_STATE->showBackground;
 
+    if (IsKeyPressed(KEY_F9))
+        Replay::RecordingToggle();
+
 
     if (EDITOR_STATE->isEnabled) return;
 
@@ -88,6 +94,10 @@ void handleInLevelInput() {
         { Level::GoToOverworld(); return; }
 
 
+    // The recording has the input, pausing included
+    if (Replay::IsPlayingBack()) return;
+
+
     if (IsKeyPressed(KEY_ENTER) || isGamepadPressed(GP_START))
         { Level::PauseToggle(); return; }
 
@@ -109,13 +119,13 @@ void handleInLevelInput() {
 
 
     if (IsKeyPressed(KEY_X) || isGamepadPressed(GP_A))
-        PLAYER->InputJump();
+        STATE.pressedJump = true;
 
     if (IsKeyPressed(KEY_C) || isGamepadPressed(GP_Y))
-        PLAYER->SetCheckpoint();
+        STATE.pressedCheckpoint = true;
 
     if (IsKeyPressed(KEY_A) || isGamepadPressed(GP_R1))
-        PLAYER->LaunchGrapplingHook();
+        STATE.pressedGrapplingHook = true;
 
 
     // For debugging
@@ -154,10 +164,12 @@ void handleOverworldInput() {
 
 void handleDevInput() {
 
-    if      (IsKeyPressed(KEY_F1))          { EditorEnabledToggle(); return; }
+    if      (IsKeyPressed(KEY_F1) &&
+            !Replay::IsPlayingBack())       { EditorEnabledToggle(); return; }
     if      (IsKeyPressed(KEY_F2))          DebugHudToggle();
     if      (IsKeyPressed(KEY_F3))          GAME_STATE->showDebugGrid = !GAME_STATE->showDebugGrid;
     if      (IsKeyPressed(KEY_F5))          AssetsHotReload();
+    if      (IsKeyPressed(KEY_F10))         Render::StatsDumpToggle();
     if      (IsKeyPressed(KEY_F11))         Render::FullscreenToggle();
 
 
@@ -165,6 +177,10 @@ void handleDevInput() {
 
     if (IsCursorHidden()) return;
 
+    // What's past here changes the level, or the camera the entities wake up around,
+    // which would make the playback diverge
+    if (Replay::IsPlayingBack()) return;
+
     Vector2 mousePosInScreen = GetMousePosition();
     Vector2 mousePosInScene = PosInScreenToScene(mousePosInScreen);
 
@@ -181,7 +197,7 @@ void handleDevInput() {
         EditorSelectEntities(mousePosInScene);
         return;
     }
-    else if (EDITOR_STATE->isEnabled && IsMouseButtonDown(MOUSE_BUTTON_LEFT) && !EDITOR_STATE->selectedEntities.empty()) {
+    else if (EDITOR_STATE->isEnabled && IsMouseButtonDown(MOUSE_BUTTON_LEFT) && !EditorSelectionIsEmpty()) {
 
         if (!IsInMouseArea(mousePosInScreen)) goto skip_selected_entities_actions;
 
@@ -248,11 +264,64 @@ skip_to_button_handler:
 
 }
 
+// Copies the name of the dropped level into the buffer. Returns 'true' if successful.
+static bool getDroppedLevelName(char *nameBuffer) {
+    
+    FilePathList fileList = LoadDroppedFiles();
+    bool result = false;
+
+    char *filePath = fileList.paths[0];
+
+    // Ideally we'd support loading levels from anywhere,
+    // but this would involve rewriting the InitializeLevel logic.
+    // ATTENTION: It presumes the working dir is next to the 'levels' dir (i.e., it's the 'build' dir)
+    const char *fileDir = GetDirectoryPath(filePath);
+    const char *projectRootPath = GetPrevDirectoryPath(GetWorkingDirectory());
+    const char *fileName = GetFileName(filePath);
+
+    if (fileList.count > 1) {
+        TraceLog(LOG_ERROR, "Multiple files dropped. Ignoring them.");
+        goto return_result;
+    }
+
+    if (strcmp(projectRootPath, GetPrevDirectoryPath(fileDir)) != 0 ||
+        strcmp(GetFileName(fileDir), PERSISTENCE_DIR_NAME) != 0) {
+
+            TraceLog(LOG_ERROR, "Dropped file is not on 'levels' directory.");
+            Render::PrintSysMessage("Arquivo não é parte do jogo");
+            goto return_result;
+    }
+
+    if (strcmp(GetFileExtension(filePath), LEVEL_FILE_EXTENSION) != 0 &&
+        strcmp(GetFileExtension(filePath), LEVEL_BINARY_FILE_EXTENSION) != 0) {
+        TraceLog(LOG_ERROR, "Dropped file extension is not %s nor %s. Ignoring it",
+                    LEVEL_FILE_EXTENSION, LEVEL_BINARY_FILE_EXTENSION);
+        Render::PrintSysMessage("Arquivo não é fase");
+        goto return_result;
+    }
+
+    if (strcmp(fileName, LEVEL_BLUEPRINT_NAME) == 0 ||
+        strlen(fileName) > LEVEL_NAME_BUFFER_SIZE) {
+
+            TraceLog(LOG_ERROR, "Dropped file has invalid level name %s.",
+                        fileName);
+            Render::PrintSysMessage("Nome de fase proibido");
+            goto return_result;
+    }
+
+    strcpy(nameBuffer, fileName);
+    result = true;
+
+return_result:
+    UnloadDroppedFiles(fileList);
+    return result;
+}
+
 void handleDroppedFile() {
 
     char *levelName = (char *) MemAlloc(sizeof(char) * LEVEL_NAME_BUFFER_SIZE);
     
-    if (PersistenceGetDroppedLevelName(levelName)) {
+    if (getDroppedLevelName(levelName)) {
         
         Level::Load(levelName);
         
@@ -342,13 +411,4 @@ void Handle() {
     }
 }
 
-void GetTextInput(TextInputCallback *callback) {
-
-    GAME_STATE->waitingForTextInput = true;
-    
-    STATE.textInputCallback = callback;
-
-    TraceLog(LOG_TRACE, "Text input started.");
-}
-
 }
@@ -63,17 +63,32 @@ public:
     bool isHoldingRun;
     PlayerMoveDirection playerMoveDirection;
 
+    // Pressed since the last level tick, and applied at the start of the next one
+    bool pressedJump;
+    bool pressedCheckpoint;
+    bool pressedGrapplingHook;
+
     InputState() {}
 };
 
 
+// Part of the simulation, in input_state.cpp, as the replays feed it to the ticks
 extern InputState STATE;
 
 
+// Reads the keyboard, the mouse and the gamepad into STATE, or acts on them directly, once every frame
+
 void Initialize();
 
 void Handle();
 
+
+// Part of the simulation, in input_state.cpp
+
+// Applies the gameplay input to the level tick about to run. Gameplay input only
+// takes effect through here, so it happens in the same tick when replayed.
+void ApplyTickInput();
+
 // Enters Text Input mode and, when the user finishes entering
 // the texts, it passes it to the callback.
 void GetTextInput(TextInputCallback *callback);
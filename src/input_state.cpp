@@ -0,0 +1,39 @@
+#include <raylib.h>
+
+#include "input.hpp"
+#include "core.hpp"
+#include "level/player.hpp"
+#include "replay.hpp"
+
+
+namespace Input {
+
+InputState STATE;
+
+
+void ApplyTickInput() {
+
+    Replay::TickInput(&STATE);
+
+    if (PLAYER && !PLAYER->isDead) {
+
+        if (STATE.pressedJump)              PLAYER->InputJump();
+        if (STATE.pressedCheckpoint)        PLAYER->SetCheckpoint();
+        if (STATE.pressedGrapplingHook)     PLAYER->LaunchGrapplingHook();
+    }
+
+    STATE.pressedJump = false;
+    STATE.pressedCheckpoint = false;
+    STATE.pressedGrapplingHook = false;
+}
+
+void GetTextInput(TextInputCallback *callback) {
+
+    GAME_STATE->waitingForTextInput = true;
+    
+    STATE.textInputCallback = callback;
+
+    TraceLog(LOG_TRACE, "Text input started.");
+}
+
+}
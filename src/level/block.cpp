@@ -29,7 +29,7 @@ Block *Block::AddFromPersistence() {
 
 Block *Block::Add(Vector2 origin) {
 
-    Block *newBlock = new Block();
+    Block *newBlock = Level::EntityNew<Block>();
 
     newBlock->tags = Level::IS_GEOMETRY +
                             Level::IS_GROUND +
@@ -42,7 +42,7 @@ Block *Block::Add(Vector2 origin) {
     newBlock->hitbox = SpriteHitboxFromEdge(newBlock->sprite, newBlock->origin);
     newBlock->entityTypeID = BLOCK_ENTITY_ID;
 
-    LinkedList::AddNode(&Level::STATE->listHead, newBlock);
+    Level::EntityAdd(newBlock);
 
     TraceLog(LOG_TRACE, "Added block to level (x=%.1f, y=%.1f)",
                 newBlock->hitbox.x, newBlock->hitbox.y);
@@ -163,36 +163,44 @@ void Block::TileAutoAdjust() {
         rotation = 180;
         break;
     }
+
+    Level::TileChanged(this);
 }
 
 void Block::TileRotate() {
     
     rotation += 90;
     if (rotation >= 360) rotation -= 360;
+
+    Level::TileChanged(this);
 }
 
 void Block::Draw() {
 
-    Vector2 pos = PosInSceneToScreen({
-                                        hitbox.x,
-                                        hitbox.y });
-
-    Render::DrawTexture(sprite, { pos.x, pos.y }, WHITE, rotation, false);
+    Render::DrawTexture(sprite, { hitbox.x, hitbox.y }, WHITE, rotation, false);
 }
 
-std::string Block::PersistanceSerialize() {
+void Block::PersistanceSerialize(std::string *line) {
 
-    std::string data = Level::Entity::PersistanceSerialize();
-    persistanceAddValue(&data, "rotation", std::to_string(rotation));
-    persistanceAddValue(&data, "tileType", tileTypeId);
-    return data;
+    Level::Entity::PersistanceSerialize(line);
+    persistanceAddValue(line, "rotation", rotation);
+    persistanceAddValue(line, "tileType", tileTypeId);
 }
 
-void Block::PersistenceParse(const std::string &data) {
+bool Block::PersistenceParse(const PersistenceFields &fields) {
+
+    if (!Level::Entity::PersistenceParse(fields)) return false;
 
-    Level::Entity::PersistenceParse(data);
-    rotation = std::stoi(persistenceReadValue(data, "rotation"));
-    TileTypeSet(persistenceReadValue(data, "tileType"));
+    // Blocks saved before they had a rotation and a tile type keep the defaults
+    if (fields.Has("rotation") && !fields.ReadInt("rotation", &rotation)) return false;
+
+    std::string tileType;
+    if (fields.Has("tileType")) {
+        if (!fields.ReadString("tileType", &tileType)) return false;
+        TileTypeSet(tileType);
+    }
+
+    return true;
 }
 
 void Block::TileTypeSet(const std::string &id) {
@@ -206,6 +214,8 @@ void Block::TileTypeSet(const std::string &id) {
         TraceLog(LOG_ERROR, "Block couldn't set tile type '%s'.", id.c_str());
         sprite = tileSpriteMap.at(DEFAULT_TILE_TYPE);
     }
+
+    Level::TileChanged(this);
 }
 
 //
@@ -216,7 +226,7 @@ AcidBlock *AcidBlock::AddFromPersistence() {
 
 AcidBlock *AcidBlock::Add(Vector2 origin) {
 
-    AcidBlock *newBlock = new AcidBlock();
+    AcidBlock *newBlock = Level::EntityNew<AcidBlock>();
 
     newBlock->tags = Level::IS_GEOMETRY +
                             Level::IS_GROUND +
@@ -229,7 +239,7 @@ AcidBlock *AcidBlock::Add(Vector2 origin) {
     newBlock->hitbox = SpriteHitboxFromEdge(newBlock->sprite, newBlock->origin);
     newBlock->entityTypeID = ACID_BLOCK_ENTITY_ID;
 
-    LinkedList::AddNode(&Level::STATE->listHead, newBlock);
+    Level::EntityAdd(newBlock);
 
     TraceLog(LOG_TRACE, "Added acid block to level (x=%.1f, y=%.1f)",
                 newBlock->hitbox.x, newBlock->hitbox.y);
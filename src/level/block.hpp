@@ -6,7 +6,7 @@
 #include <map>
 
 #include "level.hpp"
-#include "../assets.hpp"
+#include "../sprites.hpp"
 
 #define BLOCK_ENTITY_ID        "block"
 #define ACID_BLOCK_ENTITY_ID   "acid_block"
@@ -39,16 +39,20 @@ public:
 
     void Draw() override;
 
-    std::string PersistanceSerialize() override;
+    bool IsTile() override { return true; }
+
+    int GetTileRotation() override { return rotation; }
+
+    void PersistanceSerialize(std::string *line) override;
     
-    void PersistenceParse(const std::string &data) override;
+    bool PersistenceParse(const PersistenceFields &fields) override;
     
 private:
 
     // Defines the different block tile types and which sprite to use for each of them
     static std::map<std::string, Sprite*> tileSpriteMap;
 
-    int rotation;
+    int rotation = 0;
 
     std::string tileTypeId;
 
@@ -68,6 +72,8 @@ public:
     // if there are no other blocks there already
     static void AddFromEditor(Vector2 origin, int interactionTags);
 
+    bool IsTile() override { return true; }
+
 };
 
 #endif // _BLOCK_H_INCLUDED_
@@ -0,0 +1,188 @@
+#include <raylib.h>
+#include <math.h>
+#include <algorithm>
+
+#include "cell_buckets.hpp"
+#include "level.hpp"
+
+
+// The fewest spots the cell table has, once something is added
+#define CELL_BUCKETS_MIN_TABLE_SIZE     64
+
+
+namespace Level {
+
+
+CellRange CellRangeOf(Rectangle rect) {
+
+    const Dimensions grid = LEVEL_GRID;
+
+    return {
+        (int) floorf(rect.x / grid.width),
+        (int) floorf(rect.y / grid.height),
+        (int) floorf((rect.x + rect.width) / grid.width),
+        (int) floorf((rect.y + rect.height) / grid.height)
+    };
+}
+
+bool CellRangeEquals(CellRange a, CellRange b) {
+    return a.x0 == b.x0 && a.y0 == b.y0 && a.x1 == b.x1 && a.y1 == b.y1;
+}
+
+long long CellKey(int x, int y) {
+    return ((long long) x << 32) | (unsigned int) y;
+}
+
+void CellBuckets::Insert(Entity *entity, CellRange range) {
+
+    for (int x = range.x0; x <= range.x1; x++) {
+        for (int y = range.y0; y <= range.y1; y++) {
+
+            int link;
+
+            if (firstFreeLink != LINK_NONE) {
+                link = firstFreeLink;
+                firstFreeLink = links[link].next;
+            }
+            else {
+                link = links.size();
+                links.push_back({});
+            }
+
+            Cell &cell = findOrAdd(CellKey(x, y));
+
+            links[link] = { entity, cell.firstLink };
+            cell.firstLink = link;
+        }
+    }
+}
+
+void CellBuckets::Erase(Entity *entity, CellRange range) {
+
+    for (int x = range.x0; x <= range.x1; x++) {
+        for (int y = range.y0; y <= range.y1; y++) {
+
+            Cell *cell = find(CellKey(x, y));
+            if (!cell) continue;
+
+            // Order inside a bucket doesn't matter, Query() sorts the results
+            for (int *link = &cell->firstLink; *link != LINK_NONE; link = &links[*link].next) {
+
+                if (links[*link].entity != entity) continue;
+
+                int erased = *link;
+                *link = links[erased].next;
+
+                links[erased].next = firstFreeLink;
+                firstFreeLink = erased;
+                break;
+            }
+        }
+    }
+}
+
+void CellBuckets::Query(CellRange range, std::vector<Entity *> *result) {
+
+    result->clear();
+
+    for (int x = range.x0; x <= range.x1; x++) {
+        for (int y = range.y0; y <= range.y1; y++) {
+
+            Cell *cell = find(CellKey(x, y));
+            if (!cell) continue;
+
+            for (int link = cell->firstLink; link != LINK_NONE; link = links[link].next) {
+                result->push_back(links[link].entity);
+            }
+        }
+    }
+
+    // An entity can be in more than one cell, and the callers expect the entity list's order
+    std::sort(result->begin(), result->end(),
+                [](Entity *a, Entity *b) { return a->spawnOrder < b->spawnOrder; });
+    result->erase(std::unique(result->begin(), result->end()), result->end());
+}
+
+void CellBuckets::Reserve(size_t linkCount, size_t cellCount) {
+
+    links.reserve(linkCount);
+
+    size_t tableSize = std::max(cells.size(), (size_t) CELL_BUCKETS_MIN_TABLE_SIZE);
+    while (tableSize < cellCount * 2) tableSize *= 2;
+
+    if (tableSize != cells.size()) rehash(tableSize);
+}
+
+void CellBuckets::Clear() {
+
+    std::fill(cells.begin(), cells.end(), Cell());
+    usedCellCount = 0;
+
+    links.clear();
+    firstFreeLink = LINK_NONE;
+}
+
+CellBuckets::Cell *CellBuckets::find(long long key) {
+
+    if (cells.empty()) return 0;
+
+    const size_t mask = cells.size() - 1;
+
+    for (size_t slot = slotOf(key, cells.size()); cells[slot].isUsed; slot = (slot + 1) & mask) {
+        if (cells[slot].key == key) return &cells[slot];
+    }
+
+    return 0;
+}
+
+CellBuckets::Cell &CellBuckets::findOrAdd(long long key) {
+
+    if ((usedCellCount + 1) * 2 > cells.size()) {
+        rehash(std::max(cells.size() * 2, (size_t) CELL_BUCKETS_MIN_TABLE_SIZE));
+    }
+
+    const size_t mask = cells.size() - 1;
+
+    size_t slot = slotOf(key, cells.size());
+    for (; cells[slot].isUsed; slot = (slot + 1) & mask) {
+        if (cells[slot].key == key) return cells[slot];
+    }
+
+    Cell &cell = cells[slot];
+    cell.key = key;
+    cell.firstLink = LINK_NONE;
+    cell.isUsed = true;
+    usedCellCount++;
+
+    return cell;
+}
+
+size_t CellBuckets::slotOf(long long key, size_t tableSize) {
+
+    // Neighbouring cells have keys that only differ in a few bits, so they're spread out first
+    unsigned long long hash = (unsigned long long) key * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 32;
+
+    return hash & (tableSize - 1);
+}
+
+void CellBuckets::rehash(size_t tableSize) {
+
+    std::vector<Cell> oldCells(tableSize);
+    cells.swap(oldCells);
+
+    const size_t mask = tableSize - 1;
+
+    for (const Cell &cell : oldCells) {
+
+        if (!cell.isUsed) continue;
+
+        size_t slot = slotOf(cell.key, tableSize);
+        while (cells[slot].isUsed) slot = (slot + 1) & mask;
+
+        cells[slot] = cell;
+    }
+}
+
+
+} // namespace
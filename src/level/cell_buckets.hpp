@@ -0,0 +1,110 @@
+#pragma once
+
+#include <raylib.h>
+#include <stddef.h>
+#include <vector>
+
+
+namespace Level {
+
+
+class Entity;
+
+
+// A block of LEVEL_GRID cells. Both ends are inclusive.
+typedef struct CellRange {
+    int x0, y0;
+    int x1, y1;
+} CellRange;
+
+// The LEVEL_GRID cells a rectangle touches
+CellRange CellRangeOf(Rectangle rect);
+
+bool CellRangeEquals(CellRange a, CellRange b);
+
+// Identifies a single cell in the hash maps
+long long CellKey(int x, int y);
+
+
+/*
+    Level entities bucketed by the LEVEL_GRID cells they're in, which the spatial hash and
+    the ground index build on, each deciding which cells an entity goes in.
+
+    The cells are an open addressing hash table, and each bucket is a list linked through a single
+    array shared by all buckets, so adding entities only allocates when these arrays grow,
+    and not at all once Reserve() made room for the level.
+*/
+class CellBuckets {
+
+public:
+
+    // Puts the entity in the buckets of all cells in the range
+    void Insert(Entity *entity, CellRange range);
+
+    // Takes the entity out of the buckets of the cells in the range it's in
+    void Erase(Entity *entity, CellRange range);
+
+    // Sets the entities in the cells of the range, without repetitions,
+    // in the same order they were added to the level
+    void Query(CellRange range, std::vector<Entity *> *result);
+
+    // Calls the function for each entity in each bucket, so once per cell the entity is in
+    template <typename Function>
+    void ForEach(Function function) {
+        for (const Cell &cell : cells) {
+            for (int link = cell.firstLink; link != LINK_NONE; link = links[link].next) function(links[link].entity);
+        }
+    }
+
+    // Makes room for this many entities in buckets, counting an entity once per cell,
+    // and this many cells, so adding them doesn't allocate
+    void Reserve(size_t linkCount, size_t cellCount);
+
+    // Empties all buckets, keeping the memory for the next level
+    void Clear();
+
+private:
+
+    static constexpr int LINK_NONE = -1;
+
+    typedef struct Cell {
+        long long key = 0;
+
+        // The first entity in the cell's bucket, or LINK_NONE. An emptied cell stays in the table.
+        int firstLink = LINK_NONE;
+
+        // If this spot of the table has a cell
+        bool isUsed = false;
+    } Cell;
+
+    // An entity in a bucket, and the next one in the same bucket
+    typedef struct Link {
+        Entity *entity;
+        int next;
+    } Link;
+
+
+    // Its size is a power of two, and it's kept at most half full, so probing is short
+    std::vector<Cell> cells;
+    size_t usedCellCount = 0;
+
+    // The links of all buckets. The ones taken out of a bucket are linked from firstFreeLink, to be reused.
+    std::vector<Link> links;
+    int firstFreeLink = LINK_NONE;
+
+
+    // The cell with the key, or 0 if there's none
+    Cell *find(long long key);
+
+    // The cell with the key, added if there's none yet
+    Cell &findOrAdd(long long key);
+
+    // Where to start probing for the key, in a table of this size
+    static size_t slotOf(long long key, size_t tableSize);
+
+    // Makes the table this size, moving the cells over
+    void rehash(size_t tableSize);
+};
+
+
+} // namespace
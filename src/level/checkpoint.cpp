@@ -17,7 +17,7 @@ Level::Entity *CheckpointPickup::AddFromPersistence() {
 
 Level::Entity *CheckpointPickup::Add(Vector2 pos) {
 
-    CheckpointPickup *newPickup = new CheckpointPickup();
+    CheckpointPickup *newPickup = Level::EntityNew<CheckpointPickup>();
 
     Sprite *sprite = &SPRITES->LevelCheckpointPickup1;
     Rectangle hitbox = SpriteHitboxFromEdge(sprite, pos);
@@ -35,7 +35,7 @@ Level::Entity *CheckpointPickup::Add(Vector2 pos) {
 
     newPickup->initializeAnimationSystem();
 
-    LinkedList::AddNode(&Level::STATE->listHead, newPickup);
+    Level::EntityAdd(newPickup);
 
     TraceLog(LOG_TRACE, "Added checkpoint pickup to level (x=%.1f, y=%.1f)",
                 newPickup->hitbox.x, newPickup->hitbox.y);
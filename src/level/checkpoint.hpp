@@ -27,6 +27,8 @@ public:
 
     void Tick();
 
+    bool IsTickable() { return true; }
+
     void Draw();
 
 private:
@@ -20,7 +20,7 @@ Coin *Coin::AddFromPersistence() {
 
 Coin *Coin::Add(Vector2 origin) {
 
-    Coin *newCoin = new Coin();
+    Coin *newCoin = Level::EntityNew<Coin>();
 
     newCoin->tags = Level::IS_COIN +
                         Level::IS_PERSISTABLE;
@@ -34,7 +34,7 @@ Coin *Coin::Add(Vector2 origin) {
 
     newCoin->initializeAnimationSystem();
 
-    LinkedList::AddNode(&Level::STATE->listHead, newCoin);
+    Level::EntityAdd(newCoin);
 
     TraceLog(LOG_TRACE, "Added coin to level (x=%.1f, y=%.1f)",
                 newCoin->hitbox.x, newCoin->hitbox.y);
@@ -58,7 +58,7 @@ void Coin::PickUp() {
 
     GAME_STATE->coinsCollected++;
 
-    DebugEntityStop(this);
+    DebugEntityStop(handle);
 
     TraceLog(LOG_TRACE, "Picked up coin.");
 }
@@ -84,13 +84,12 @@ void Coin::Draw() {
         Render::DrawLevelEntityOriginGhost(this);
 }
 
-std::string Coin::PersistanceSerialize() {
-    std::string data = Level::Entity::PersistanceSerialize();
-    return data;
+void Coin::PersistanceSerialize(std::string *line) {
+    Level::Entity::PersistanceSerialize(line);
 }
 
-void Coin::PersistenceParse(const std::string &data) {
-    Level::Entity::PersistenceParse(data);
+bool Coin::PersistenceParse(const PersistenceFields &fields) {
+    return Level::Entity::PersistenceParse(fields);
 }
 
 void Coin::createAnimations() {
@@ -25,11 +25,13 @@ public:
 
     void Tick() override;
 
+    bool IsTickable() override { return true; }
+
     void Draw() override;
 
-    std::string PersistanceSerialize() override;
+    void PersistanceSerialize(std::string *line) override;
     
-    void PersistenceParse(const std::string &data) override;
+    bool PersistenceParse(const PersistenceFields &fields) override;
 
 private:
 
@@ -19,7 +19,7 @@ Enemy *Enemy::AddFromPersistence() {
 
 Enemy *Enemy::Add(Vector2 origin) {
 
-    Enemy *newEnemy = new Enemy();
+    Enemy *newEnemy = Level::EntityNew<Enemy>();
 
     newEnemy->tags = Level::IS_ENEMY +
                             Level::IS_GROUND +
@@ -31,7 +31,7 @@ Enemy *Enemy::Add(Vector2 origin) {
     newEnemy->isFallingDown = true;
     newEnemy->entityTypeID = ENEMY_ENTITY_ID;
 
-    LinkedList::AddNode(&Level::STATE->listHead, newEnemy);
+    Level::EntityAdd(newEnemy);
 
     TraceLog(LOG_TRACE, "Added enemy to level (x=%.1f, y=%.1f)",
                 newEnemy->hitbox.x, newEnemy->hitbox.y);
@@ -117,23 +117,17 @@ void Enemy::Tick() {
     }
 
 
-    LinkedList::Node *node = Level::STATE->listHead;
-    while (node) {
+    for (Level::Entity *entity : Level::EntitiesNear(hitbox)) {
 
-        Level::Entity *entity = (Level::Entity *) node;
-
-        if (entity == this) goto next_node;
+        if (entity == this) continue;
 
         if (entity->tags & Level::IS_GEOMETRY &&
-            CheckCollisionRecs(entity->hitbox, hitbox)) {
+            RectanglesCollide(entity->hitbox, hitbox)) {
 
                 isFacingRight = !isFacingRight;
 
                 return;
         }
-
-next_node:
-        node = node->next;
     }
 }
 
@@ -141,7 +135,7 @@ void Enemy::Kill() {
 
     isDead = true;
 
-    DebugEntityStop(this);
+    DebugEntityStop(handle);
 
     TraceLog(LOG_TRACE, "Enemy died.");
 }
@@ -167,7 +161,7 @@ EnemyDummySpike *EnemyDummySpike::AddFromPersistence() {
 
 EnemyDummySpike *EnemyDummySpike::Add(Vector2 origin) {
 
-    EnemyDummySpike *newEnemy = new EnemyDummySpike();
+    EnemyDummySpike *newEnemy = Level::EntityNew<EnemyDummySpike>();
 
     newEnemy->tags = Level::IS_ENEMY +
                             Level::IS_GROUND +
@@ -181,7 +175,7 @@ EnemyDummySpike *EnemyDummySpike::Add(Vector2 origin) {
 
     newEnemy->initializeAnimationSystem();
 
-    LinkedList::AddNode(&Level::STATE->listHead, newEnemy);
+    Level::EntityAdd(newEnemy);
 
     TraceLog(LOG_TRACE, "Added enemy dummy to level (x=%.1f, y=%.1f)",
                 newEnemy->hitbox.x, newEnemy->hitbox.y);
@@ -230,6 +224,10 @@ void EnemyDummySpike::Tick() {
     sprite = animationTick();
 }
 
+void EnemyDummySpike::HashMotionState(uint32_t *hash) {
+    Level::StateHashAdd(hash, popOutAnimationCountdown);
+}
+
 void EnemyDummySpike::Draw() {
 
     Render::DrawLevelEntity(this);
@@ -244,8 +242,8 @@ void EnemyDummySpike::setToSpike() {
     tags |= Level::IS_GEOMETRY + Level::IS_GEOMETRY_DANGER;
 
     auto newSprite = &SPRITES->EnemyDummySpikePoppedOut;
-    float xOff = (hitbox.width - (newSprite->sprite.width * newSprite->scale)) / 2;
-    float yOff = (hitbox.height - (newSprite->sprite.height * newSprite->scale)) / 2;
+    float xOff = (hitbox.width - (newSprite->source.width * newSprite->scale)) / 2;
+    float yOff = (hitbox.height - (newSprite->source.height * newSprite->scale)) / 2;
     hitbox = SpriteHitboxFromEdge(newSprite, { hitbox.x + xOff, hitbox.y + yOff });
 }
 
@@ -255,8 +253,8 @@ void EnemyDummySpike::setToEnemy() {
     tags &= ~Level::IS_GEOMETRY + ~Level::IS_GEOMETRY_DANGER;
     
     auto newSprite = &SPRITES->EnemyDummySpike;
-    float xOff = ((newSprite->sprite.width * newSprite->scale) - hitbox.width) / 2;
-    float yOff = ((newSprite->sprite.height * newSprite->scale) - hitbox.height) / 2;
+    float xOff = ((newSprite->source.width * newSprite->scale) - hitbox.width) / 2;
+    float yOff = ((newSprite->source.height * newSprite->scale) - hitbox.height) / 2;
     hitbox = SpriteHitboxFromEdge(newSprite, { hitbox.x - xOff, hitbox.y - yOff });
 }
 
@@ -33,6 +33,8 @@ public:
     // Runs the update routine of a given enemy
     void Tick();
 
+    bool IsTickable() { return true; }
+
     virtual void Draw();
 
 };
@@ -54,6 +56,8 @@ public:
 
     void Tick() override;
 
+    void HashMotionState(uint32_t *hash) override;
+
     void Draw() override;
 
 private:
@@ -0,0 +1,122 @@
+#include <raylib.h>
+#include <stdlib.h>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+#include "entity_pool.hpp"
+
+
+// How many objects fit in each chunk of a pool
+#define OBJECTS_PER_CHUNK       256
+
+
+namespace Level {
+
+
+std::vector<EntityPool *> &EntityPools() {
+
+    static std::vector<EntityPool *> pools;
+    return pools;
+}
+
+static std::string readableTypeName(const std::type_info &type) {
+
+#ifdef __GNUG__
+    int status;
+    char *demangled = abi::__cxa_demangle(type.name(), 0, 0, &status);
+    if (status == 0 && demangled) {
+        std::string name = demangled;
+        free(demangled);
+        return name;
+    }
+#endif
+
+    std::string name = type.name();
+    if (name.rfind("class ", 0) == 0) name = name.substr(6);
+    return name;
+}
+
+EntityPool::EntityPool(const std::type_info &type, size_t objectSize) {
+
+    const size_t alignment = alignof(std::max_align_t);
+
+    // Each slot must fit the free list's pointer, and keep the next slot aligned
+    if (objectSize < sizeof(void *)) objectSize = sizeof(void *);
+    objectSize = (objectSize + alignment - 1) / alignment * alignment;
+
+    this->typeName = readableTypeName(type);
+    this->objectSize = objectSize;
+    this->liveCount = 0;
+    this->allocationCount = 0;
+    this->usedChunks = 0;
+    this->usedInLastChunk = 0;
+    this->freeList = 0;
+
+    EntityPools().push_back(this);
+}
+
+EntityPool::~EntityPool() {
+
+    for (char *chunk : chunks) ::operator delete(chunk);
+}
+
+void *EntityPool::Allocate() {
+
+    void *object;
+
+    if (freeList) {
+        object = freeList;
+        freeList = *(void **) freeList;
+    }
+    else {
+
+        if (usedChunks == 0 || usedInLastChunk == OBJECTS_PER_CHUNK) {
+
+            if (usedChunks == chunks.size()) {
+                chunks.push_back((char *) ::operator new(objectSize * OBJECTS_PER_CHUNK));
+                TraceLog(LOG_TRACE, "Entity pool for %s grew to %zu chunks.", typeName.c_str(), chunks.size());
+            }
+
+            usedChunks++;
+            usedInLastChunk = 0;
+        }
+
+        object = chunks[usedChunks - 1] + (usedInLastChunk * objectSize);
+        usedInLastChunk++;
+    }
+
+    liveCount++;
+    allocationCount++;
+
+    return object;
+}
+
+void EntityPool::Free(void *object) {
+
+    *(void **) object = freeList;
+    freeList = object;
+
+    liveCount--;
+}
+
+void EntityPool::Reset() {
+
+    usedChunks = 0;
+    usedInLastChunk = 0;
+    freeList = 0;
+
+    liveCount = 0;
+}
+
+size_t EntityPool::LiveBytes() {
+    return liveCount * objectSize;
+}
+
+size_t EntityPool::ReservedBytes() {
+    return chunks.size() * OBJECTS_PER_CHUNK * objectSize;
+}
+
+
+} // namespace
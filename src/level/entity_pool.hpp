@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+
+namespace Level {
+
+
+/*
+    Fixed-size slots for the entities of a single type, allocated in chunks.
+
+    Freed slots are reused by the next allocations, and Reset() forgets all of them
+    at once, keeping the chunks around for the next level.
+*/
+class EntityPool {
+
+public:
+
+    // A readable name of the type this pool holds
+    std::string typeName;
+
+    // The size of each slot
+    size_t objectSize;
+
+    // How many objects are allocated right now
+    size_t liveCount;
+
+    // How many objects were ever allocated from this pool
+    size_t allocationCount;
+
+
+    EntityPool(const std::type_info &type, size_t objectSize);
+
+    ~EntityPool();
+
+    // Memory for one object. Doesn't construct it.
+    void *Allocate();
+
+    // Gives back the memory of one object. Doesn't destroy it.
+    void Free(void *object);
+
+    // Gives back the memory of all objects at once. Doesn't destroy them.
+    void Reset();
+
+    // How many bytes the live objects use
+    size_t LiveBytes();
+
+    // How many bytes the pool has reserved in chunks
+    size_t ReservedBytes();
+
+private:
+
+    std::vector<char *> chunks;
+
+    // How many chunks are in use, and how many slots of the last one in use were handed out
+    size_t usedChunks;
+    size_t usedInLastChunk;
+
+    // Freed slots, linked through their first bytes
+    void *freeList;
+};
+
+
+// All the entity pools created so far
+std::vector<EntityPool *> &EntityPools();
+
+// The pool for a type of entity
+template <typename T>
+EntityPool &EntityPoolOf() {
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Entity pools don't support over-aligned types");
+
+    static EntityPool pool(typeid(T), sizeof(T));
+    return pool;
+}
+
+
+} // namespace
@@ -0,0 +1,255 @@
+#include <raylib.h>
+
+#include "entity_store.hpp"
+#include "level.hpp"
+
+
+namespace Level {
+
+
+EntityStore::Iterator::Iterator(const std::vector<Entity *> *list, size_t index) {
+    this->list = list;
+    this->index = index;
+    skipRemoved();
+}
+
+Entity *EntityStore::Iterator::operator*() const {
+    return (*list)[index];
+}
+
+EntityStore::Iterator &EntityStore::Iterator::operator++() {
+    index++;
+    skipRemoved();
+    return *this;
+}
+
+bool EntityStore::Iterator::operator!=(const Iterator &end) const {
+    (void) end;
+    return index < list->size();
+}
+
+void EntityStore::Iterator::skipRemoved() {
+    while (index < list->size() && !(*list)[index]) index++;
+}
+
+EntityStore::TickableIterator::TickableIterator(std::vector<Tickable> *list, size_t index) {
+    this->list = list;
+    this->index = index;
+    skipRemoved();
+}
+
+EntityStore::Tickable &EntityStore::TickableIterator::operator*() const {
+    return (*list)[index];
+}
+
+EntityStore::TickableIterator &EntityStore::TickableIterator::operator++() {
+    index++;
+    skipRemoved();
+    return *this;
+}
+
+bool EntityStore::TickableIterator::operator!=(const TickableIterator &end) const {
+    (void) end;
+    return index < list->size();
+}
+
+void EntityStore::TickableIterator::skipRemoved() {
+    while (index < list->size() && !(*list)[index].entity) index++;
+}
+
+// The entity in a spot of the dense or the tickable array, or 0 if it was removed
+static Entity *entityOf(Entity *entity) {
+    return entity;
+}
+
+static Entity *entityOf(const EntityStore::Tickable &tickable) {
+    return tickable.entity;
+}
+
+EntityStore::Iterator EntityStore::begin() const {
+    return Iterator(&dense, 0);
+}
+
+EntityStore::Iterator EntityStore::end() const {
+    return Iterator(&dense, dense.size());
+}
+
+EntityStore::TickableRange EntityStore::Tickables() {
+    return { &tickable };
+}
+
+EntityHandle EntityStore::Add(Entity *entity) {
+
+    EntityHandle handle = allocateSlot(entity);
+    iterate(entity, slots[handle.index]);
+
+    return handle;
+}
+
+EntityHandle EntityStore::Register(Entity *entity) {
+
+    return allocateSlot(entity);
+}
+
+void EntityStore::Append(EntityHandle handle) {
+
+    Entity *entity = Get(handle);
+    if (!entity) return;
+
+    Slot &slot = slots[handle.index];
+    if (slot.denseIndex != NOT_ITERATED) return;
+
+    iterate(entity, slot);
+}
+
+void EntityStore::Remove(EntityHandle handle) {
+
+    Entity *entity = Get(handle);
+    if (!entity) return;
+
+    Slot &slot = slots[handle.index];
+
+    if (slot.denseIndex != NOT_ITERATED) {
+        dense[slot.denseIndex] = 0;
+        removedCount++;
+    }
+
+    if (slot.tickableIndex != NOT_ITERATED) {
+        tickable[slot.tickableIndex].entity = 0;
+        tickableRemovedCount++;
+    }
+
+    slot.entity = 0;
+    bumpGeneration(slot);
+    freeSlots.push_back(handle.index);
+
+    entity->handle = EntityHandle();
+}
+
+Entity *EntityStore::Get(EntityHandle handle) const {
+
+    if (handle.generation == 0 || handle.index >= slots.size()) return 0;
+
+    const Slot &slot = slots[handle.index];
+    if (slot.generation != handle.generation) return 0;
+
+    return slot.entity;
+}
+
+void EntityStore::Moved(Entity *entity) {
+
+    if (Get(entity->handle) != entity) return;
+
+    const Slot &slot = slots[entity->handle.index];
+    if (slot.tickableIndex == NOT_ITERATED) return;
+
+    tickable[slot.tickableIndex].activationArea = entity->GetActivationArea();
+}
+
+void EntityStore::Compact() {
+
+    compact(dense, removedCount, slots, &Slot::denseIndex);
+    compact(tickable, tickableRemovedCount, slots, &Slot::tickableIndex);
+}
+
+template <typename T>
+void EntityStore::compact(std::vector<T> &list, size_t &removed,
+                            std::vector<Slot> &slots, size_t Slot::*indexField) {
+
+    if (!removed) return;
+
+    size_t kept = 0;
+
+    for (size_t i = 0; i < list.size(); i++) {
+
+        Entity *entity = entityOf(list[i]);
+        if (!entity) continue;
+
+        list[kept] = list[i];
+        slots[entity->handle.index].*indexField = kept;
+        kept++;
+    }
+
+    list.resize(kept);
+    removed = 0;
+}
+
+void EntityStore::Clear() {
+
+    // The slots are kept, so their generations keep going up and old handles stay stale
+    for (unsigned int i = 0; i < slots.size(); i++) {
+
+        Slot &slot = slots[i];
+        if (!slot.entity) continue;
+
+        slot.entity->handle = EntityHandle();
+        slot.entity = 0;
+        bumpGeneration(slot);
+        freeSlots.push_back(i);
+    }
+
+    dense.clear();
+    tickable.clear();
+    removedCount = 0;
+    tickableRemovedCount = 0;
+}
+
+void EntityStore::Reserve(size_t count) {
+
+    dense.reserve(count);
+    slots.reserve(count);
+    freeSlots.reserve(count);
+}
+
+size_t EntityStore::Count() const {
+    return dense.size() - removedCount;
+}
+
+size_t EntityStore::TickableCount() const {
+    return tickable.size() - tickableRemovedCount;
+}
+
+void EntityStore::iterate(Entity *entity, Slot &slot) {
+
+    dense.push_back(entity);
+    slot.denseIndex = dense.size() - 1;
+
+    if (entity->IsTickable()) {
+        tickable.push_back({ entity, entity->GetActivationArea(), entity->isAsleep });
+        slot.tickableIndex = tickable.size() - 1;
+    }
+}
+
+void EntityStore::bumpGeneration(Slot &slot) {
+
+    slot.generation++;
+
+    // 0 is for the zeroed handle
+    if (slot.generation == 0) slot.generation = 1;
+}
+
+EntityHandle EntityStore::allocateSlot(Entity *entity) {
+
+    unsigned int index;
+
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        index = slots.size();
+        slots.push_back({ 0, 1, NOT_ITERATED, NOT_ITERATED });
+    }
+
+    Slot &slot = slots[index];
+    slot.entity = entity;
+    slot.denseIndex = NOT_ITERATED;
+    slot.tickableIndex = NOT_ITERATED;
+
+    entity->handle = { index, slot.generation };
+
+    return entity->handle;
+}
+
+
+} // namespace
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <raylib.h>
+#include <stddef.h>
+#include <vector>
+
+
+namespace Level {
+
+
+class Entity;
+
+
+// A reference to a level entity that knows when the entity is gone.
+// A zeroed handle doesn't refer to any entity.
+typedef struct EntityHandle {
+    unsigned int index;
+    unsigned int generation;
+} EntityHandle;
+
+inline bool operator==(EntityHandle a, EntityHandle b) {
+    return a.index == b.index && a.generation == b.generation;
+}
+
+
+/*
+    Keeps the level entities in a dense array, in the order they were added, and hands out
+    generational handles to them, so references to removed entities can be detected.
+    The entities that tick are also kept in a second array, so ticking doesn't go through the others,
+    along with what deciding if they're asleep takes, so the sleeping ones are skipped without reaching them.
+
+    A removed entity leaves an empty spot in the array until Compact() is called,
+    so entities can be added and removed while the store is being iterated.
+*/
+class EntityStore {
+
+public:
+
+    // Goes through the entities in the order they were added, skipping the removed ones.
+    // Entities added during the iteration are also visited.
+    class Iterator {
+
+    public:
+
+        Iterator(const std::vector<Entity *> *list, size_t index);
+
+        Entity *operator*() const;
+
+        Iterator &operator++();
+
+        // Only checks if the iteration is over, because the store can grow while being iterated
+        bool operator!=(const Iterator &end) const;
+
+    private:
+
+        const std::vector<Entity *> *list;
+        size_t index;
+
+        void skipRemoved();
+    };
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    // An entity that ticks, and its sleep state kept next to it
+    typedef struct Tickable {
+        Entity *entity;
+
+        // Its GetActivationArea(), as of the last time it moved
+        Rectangle activationArea;
+
+        // The same as the entity's isAsleep, which only the level's tick changes
+        bool isAsleep;
+    } Tickable;
+
+    // Goes through the entities that tick like Iterator does, skipping the removed ones
+    class TickableIterator {
+
+    public:
+
+        TickableIterator(std::vector<Tickable> *list, size_t index);
+
+        Tickable &operator*() const;
+
+        TickableIterator &operator++();
+
+        bool operator!=(const TickableIterator &end) const;
+
+    private:
+
+        std::vector<Tickable> *list;
+        size_t index;
+
+        void skipRemoved();
+    };
+
+    // The entities that tick, in the order they were added
+    typedef struct TickableRange {
+        std::vector<Tickable> *list;
+        TickableIterator begin() const { return TickableIterator(list, 0); }
+        TickableIterator end() const { return TickableIterator(list, list->size()); }
+    } TickableRange;
+
+    TickableRange Tickables();
+
+
+    // Adds an entity to the end of the store. Returns its handle.
+    // Whether it ticks is decided here, by its IsTickable().
+    EntityHandle Add(Entity *entity);
+
+    // Gives an entity a handle without it being part of the iteration,
+    // for entities that live inside other entities.
+    EntityHandle Register(Entity *entity);
+
+    // Makes an entity that was only registered part of the iteration, at the end of the store
+    void Append(EntityHandle handle);
+
+    // Removes an entity, making its handle stale. Does nothing if the handle is already stale.
+    // Doesn't destroy the entity.
+    void Remove(EntityHandle handle);
+
+    // The entity a handle refers to, or 0 if it was removed
+    Entity *Get(EntityHandle handle) const;
+
+    // Refreshes what's kept of a tickable entity to decide if it's asleep, after it moved
+    void Moved(Entity *entity);
+
+    // Closes the spots left by the removed entities, keeping the order.
+    // Must not be called while the store is being iterated.
+    void Compact();
+
+    // Removes all entities, making all handles stale. Doesn't destroy the entities.
+    void Clear();
+
+    // Makes room for this many entities in total, so adding them doesn't allocate
+    void Reserve(size_t count);
+
+    // How many entities are in the store, not counting the registered-only ones
+    size_t Count() const;
+
+    // How many of the entities tick
+    size_t TickableCount() const;
+
+private:
+
+    // Marks a slot whose entity is not part of the iteration
+    static constexpr size_t NOT_ITERATED = (size_t) -1;
+
+    typedef struct Slot {
+        Entity *entity;
+
+        // Increased every time the slot is freed, so old handles to it become stale
+        unsigned int generation;
+
+        // Where the entity is in the dense array, or NOT_ITERATED
+        size_t denseIndex;
+
+        // Where the entity is in the tickable array, or NOT_ITERATED
+        size_t tickableIndex;
+    } Slot;
+
+
+    std::vector<Entity *> dense;
+    std::vector<Tickable> tickable;
+    std::vector<Slot> slots;
+    std::vector<unsigned int> freeSlots;
+
+    // How many empty spots there are in the dense and tickable arrays
+    size_t removedCount = 0;
+    size_t tickableRemovedCount = 0;
+
+
+    EntityHandle allocateSlot(Entity *entity);
+
+    void bumpGeneration(Slot &slot);
+
+    // Puts the entity in the dense array, and in the tickable one if it ticks
+    void iterate(Entity *entity, Slot &slot);
+
+    template <typename T>
+    static void compact(std::vector<T> &list, size_t &removed, std::vector<Slot> &slots, size_t Slot::*indexField);
+};
+
+
+} // namespace
@@ -12,7 +12,6 @@
 #include "level.hpp"
 #include "player.hpp"
 #include "moving_platform.hpp"
-#include "../linked_list.hpp"
 #include "../camera.hpp"
 
 #define ANGLE           PI/3 // With the end being y0 and start being y, 0 <= ANGLE < PI/2
@@ -33,7 +32,7 @@
 
 GrapplingHook *GrapplingHook::Initialize() {
 
-    GrapplingHook *hook = new GrapplingHook();
+    GrapplingHook *hook = Level::EntityNew<GrapplingHook>();
 
     hook->tags = 0;
     hook->isFacingRight = PLAYER->isFacingRight;
@@ -41,10 +40,12 @@ GrapplingHook *GrapplingHook::Initialize() {
     hook->FollowPlayer();
     hook->end = hook->start;
 
+    hook->currentSpeed = START_SPEED;
+
     if (hook->isFacingRight) hook->currentAngle = PI + ANGLE;
     else hook->currentAngle = 2*PI - ANGLE;
 
-    LinkedList::AddNode(&Level::STATE->listHead, hook);
+    Level::EntityAdd(hook);
 
     TraceLog(LOG_TRACE, "Initialized grappling hook");
 
@@ -57,13 +58,13 @@ void GrapplingHook::Tick() {
     else if (currentAngle < 0) currentAngle += 2*PI;
     
 
-    if (attachedTo) {
+    if (Level::Entity *attachedEntity = Level::EntityGet(attachedTo)) {
 
         // Checking only for ground beneath is a very primitive way of avoiding pushing the player into geometry
         if (currentLength < MIN_LENGTH && !PLAYER->groundBeneath) currentLength += ADJUST_SPEED;
 
-        if (attachedTo->tags & Level::IS_MOVING_PLATFORM) {
-            Vector2 trajectory = ((MovingPlatform *)attachedTo)->lastFrameTrajectory;
+        if (attachedEntity->tags & Level::IS_MOVING_PLATFORM) {
+            Vector2 trajectory = ((MovingPlatform *)attachedEntity)->lastFrameTrajectory;
             SetHitboxPos({
                 end.x += trajectory.x,
                 end.y += trajectory.y
@@ -78,12 +79,11 @@ void GrapplingHook::Tick() {
 
 
     if (currentLength >= MAX_LENGTH) { // didn't attach
-        delete this;
+        Level::EntityDestroy(this); // at the end of the tick
         return;
     }
 
 
-    static float currentSpeed = START_SPEED;
     currentLength += (currentSpeed += LAUNCH_ACCEL);
     if (currentLength > MAX_LENGTH) {
         currentLength = MAX_LENGTH;
@@ -118,39 +118,53 @@ void GrapplingHook::Tick() {
     this->end = projectedEnd; // In case of collision the end should be different
 
 
-    Level::Entity *entity = (Level::Entity *) Level::STATE->listHead;
-    while (entity) {
+    // Where the end went through since the last tick
+    const Rectangle path = RectanglesUnion({ projectedEnd.x, projectedEnd.y, 0, 0 }, { projectedEndPartway1.x, projectedEndPartway1.y, 0, 0 });
+
+    for (Level::Entity *entity : Level::EntitiesNear(path)) {
 
         if (entity->tags & Level::IS_HOOKABLE &&
-                (CheckCollisionPointRec(projectedEnd, entity->hitbox) ||
-                CheckCollisionPointRec(projectedEndPartway1, entity->hitbox) ||
-                CheckCollisionPointRec(projectedEndPartway2, entity->hitbox) ||
-                CheckCollisionPointRec(projectedEndPartway3, entity->hitbox))
+                (PointInRectangle(projectedEnd, entity->hitbox) ||
+                PointInRectangle(projectedEndPartway1, entity->hitbox) ||
+                PointInRectangle(projectedEndPartway2, entity->hitbox) ||
+                PointInRectangle(projectedEndPartway3, entity->hitbox))
             ) {
 
             // Hook it!
 
-            attachedTo = entity;
+            attachedTo = entity->handle;
 
             angularVelocity = ANGULAR_VELOCITY_INITIAL;
             if (!isFacingRight) angularVelocity *= -1;
 
             
             // This is ugly as hell
-            if (CheckCollisionPointRec(projectedEndPartway1, entity->hitbox)) this->end = projectedEndPartway1;
-            if (CheckCollisionPointRec(projectedEndPartway2, entity->hitbox)) this->end = projectedEndPartway2;
-            if (CheckCollisionPointRec(projectedEndPartway3, entity->hitbox)) this->end = projectedEndPartway3;
+            if (PointInRectangle(projectedEndPartway1, entity->hitbox)) this->end = projectedEndPartway1;
+            if (PointInRectangle(projectedEndPartway2, entity->hitbox)) this->end = projectedEndPartway2;
+            if (PointInRectangle(projectedEndPartway3, entity->hitbox)) this->end = projectedEndPartway3;
             if (this->end.x != projectedEnd.x && this->end.y != projectedEnd.y)
                 currentLength = Vector2Distance(start, end);
 
 
             break;
         }
-
-        entity = (Level::Entity *) entity->next;
     }
 }
 
+bool GrapplingHook::IsAttached() {
+    return Level::EntityGet(attachedTo) != 0;
+}
+
+void GrapplingHook::HashMotionState(uint32_t *hash) {
+
+    Level::StateHashAdd(hash, start);
+    Level::StateHashAdd(hash, end);
+    Level::StateHashAdd(hash, currentLength);
+    Level::StateHashAdd(hash, currentSpeed);
+    Level::StateHashAdd(hash, currentAngle);
+    Level::StateHashAdd(hash, angularVelocity);
+}
+
 void GrapplingHook::Swing() {
     
     // I'm not sure why I'm using cos here, the formula uses sin, but that's what worked
@@ -176,25 +190,32 @@ void GrapplingHook::FollowPlayer() {
 
 void GrapplingHook::Draw() {
     
-    Vector2 posStart = PosInSceneToScreen(start);
-    Vector2 posEnd = PosInSceneToScreen(end);
+    // The start follows the player, so it's drawn where the player is drawn
+    Vector2 playerOffset = PLAYER ? PLAYER->GetRenderOffset() : Vector2{ 0, 0 };
+    Vector2 posStart = { start.x + playerOffset.x, start.y + playerOffset.y };
+    Vector2 posEnd = end;
 
     float thickness = THICKNESS;
     Color color = RAYWHITE;
-    if (!attachedTo) {
+    if (!IsAttached()) {
         thickness = std::max(THICKNESS/2.0f, THICKNESS * (currentLength/MAX_LENGTH));
         color.r = rand();
         color.g = rand();
         color.b = rand();
     }
 
-    DrawLineEx(posStart, posEnd, thickness, color);
+    Render::DrawSceneLine(posStart, posEnd, thickness, color);
+}
+
+Rectangle GrapplingHook::GetDrawArea() {
+
+    float x = std::min(start.x, end.x);
+    float y = std::min(start.y, end.y);
+
+    return { x, y, std::max(start.x, end.x) - x, std::max(start.y, end.y) - y };
 }
 
 GrapplingHook::~GrapplingHook() {
 
-    LinkedList::RemoveNode(&Level::STATE->listHead, this);
-    PLAYER->hookLaunched = 0;
-    
     TraceLog(LOG_TRACE, "Destroying grappling hook");
 }
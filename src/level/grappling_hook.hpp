@@ -10,7 +10,12 @@ public:
     Vector2 end;
 
     float currentLength;
-    Level::Entity *attachedTo;
+
+    // How much the length grows in the next tick, while it's being launched
+    float currentSpeed;
+
+    // What the hook is attached to. Stale if it isn't attached, or if the entity is gone.
+    Level::EntityHandle attachedTo;
 
     // Used by the swinging simulation
     double currentAngle; // In radians
@@ -20,6 +25,15 @@ public:
     
     void Tick();
 
+    bool IsTickable() { return true; }
+
+    Level::SleepPolicy GetSleepPolicy() { return Level::SLEEP_NEVER; }
+
+    void HashMotionState(uint32_t *hash) override;
+
+    // If the hook is attached to an entity that's still in the level
+    bool IsAttached();
+
     // Simulates swing movement 
     void Swing();
 
@@ -28,5 +42,8 @@ public:
 
     void Draw();
 
+    // The line between the start and the end
+    Rectangle GetDrawArea();
+
     ~GrapplingHook();
 };
@@ -0,0 +1,76 @@
+#include <raylib.h>
+
+#include "ground_index.hpp"
+#include "level.hpp"
+
+
+// A tile's top edge touches 2 cells, as cell ranges include both ends, one of them shared with the next tile
+#define GROUND_INDEX_LINKS_PER_ENTITY   2
+
+
+namespace Level {
+
+
+// The cells the entity's top edge is in
+static CellRange topEdgeCells(Entity *entity) {
+    return CellRangeOf({ entity->hitbox.x, entity->hitbox.y, entity->hitbox.width, 0 });
+}
+
+void GroundIndex::Add(Entity *entity) {
+
+    if (entity->isGroundIndexed || !(entity->tags & IS_GROUND)) return;
+
+    entity->indexedGroundCells = topEdgeCells(entity);
+    cells.Insert(entity, entity->indexedGroundCells);
+
+    entity->isGroundIndexed = true;
+}
+
+void GroundIndex::Remove(Entity *entity) {
+
+    if (!entity->isGroundIndexed) return;
+
+    cells.Erase(entity, entity->indexedGroundCells);
+
+    entity->isGroundIndexed = false;
+}
+
+void GroundIndex::Update(Entity *entity) {
+
+    if (!(entity->tags & IS_GROUND)) {
+        Remove(entity);
+        return;
+    }
+
+    if (!entity->isGroundIndexed) {
+        Add(entity);
+        return;
+    }
+
+    CellRange groundCells = topEdgeCells(entity);
+
+    if (!CellRangeEquals(groundCells, entity->indexedGroundCells)) {
+        cells.Erase(entity, entity->indexedGroundCells);
+        cells.Insert(entity, groundCells);
+        entity->indexedGroundCells = groundCells;
+    }
+}
+
+void GroundIndex::Reserve(size_t entityCount) {
+    cells.Reserve(entityCount * GROUND_INDEX_LINKS_PER_ENTITY, entityCount);
+}
+
+void GroundIndex::Clear() {
+
+    cells.ForEach([](Entity *entity) { entity->isGroundIndexed = false; });
+    cells.Clear();
+}
+
+const std::vector<Entity *> &GroundIndex::Query(Rectangle area) {
+
+    cells.Query(CellRangeOf(area), &queryResult);
+    return queryResult;
+}
+
+
+} // namespace
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+#include "cell_buckets.hpp"
+
+
+namespace Level {
+
+
+class Entity;
+
+
+/*
+    Buckets the level's ground entities by their top edge, per LEVEL_GRID column and row,
+    so looking for the ground beneath something only looks at the surfaces around its feet.
+*/
+class GroundIndex {
+
+public:
+
+    // Indexes the entity if it's a ground. Does nothing if it isn't one.
+    void Add(Entity *entity);
+
+    // Stops indexing an entity. Does nothing if it's not indexed.
+    void Remove(Entity *entity);
+
+    // Re-indexes an entity, if its top edge changed cells or it started/stopped being a ground
+    void Update(Entity *entity);
+
+    // Stops indexing all entities
+    void Clear();
+
+    // Makes room for indexing this many entities, so indexing them doesn't allocate
+    void Reserve(size_t entityCount);
+
+    // Returns the ground entities whose top edge is in the cells of an area, without repetitions,
+    // in the same order they were added to the level. Valid until the next query.
+    const std::vector<Entity *> &Query(Rectangle area);
+
+private:
+
+    CellBuckets cells;
+
+    // Reused between queries, so they don't allocate
+    std::vector<Entity *> queryResult;
+};
+
+
+} // namespace
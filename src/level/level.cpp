@@ -25,6 +25,7 @@
 #include "../menu.hpp"
 #include "../core.hpp"
 #include "../sounds.hpp"
+#include "../replay.hpp"
 
 
 // The difference between the y of the hitbox and the ground to be considered "on the ground"
@@ -46,19 +47,67 @@ namespace Level {
 
 LevelState *STATE = 0;
 
+EntityStore ENTITIES;
+
+// Indexes the level entities by position, for the collision queries
+static SpatialHash spatialHash;
+
+// Indexes the level grounds by their top edge, for finding the ground beneath something
+static GroundIndex groundIndex;
+
+// The level's static tiles, laid out in a grid for the renderer
+static Tilemap tilemap;
+
+// How many entities were added to the level so far, so each gets its spawnOrder
+static unsigned long int entitiesAddedCount = 0;
+
+// If the entities are being ticked. While they are, adding and destroying entities is deferred.
+static bool isTickingEntities = false;
+
+// How many entities were ticked in the last tick, i.e. tickable and awake
+static size_t tickedCount = 0;
+
+// If the entities were ticked in the last game tick, i.e. not paused or in the editor, so their rendering is interpolated
+static bool tickedLastUpdate = false;
+
+// Entities added and destroyed while ticking, to be applied at the end of the tick
+static std::vector<Entity *> spawnQueue;
+static std::vector<Entity *> destroyQueue;
+
 
 void resetState() {
 
-    LinkedList::DestroyAll(&STATE->listHead);
+    Replay::LevelLeft();
+
+    spatialHash.Clear();
+    groundIndex.Clear();
+    tilemap.Clear();
+
+    PLAYER = 0;
+
+    // Destroys all entities, but releases their memory in bulk after.
+    // Destructors may remove entities from the store (e.g. a moving platform's anchors), which is fine while iterating.
+    for (Entity *entity : ENTITIES) {
+        if (entity->pool) entity->~Entity();
+        else delete entity;
+    }
+    ENTITIES.Clear();
+    spawnQueue.clear();
+    destroyQueue.clear();
+
+    for (EntityPool *pool : EntityPools()) pool->Reset();
+
     memset(STATE->levelName, 0, sizeof(STATE->levelName));
     STATE->isPaused = false;
     STATE->awaitingAssociation = false;
     STATE->concludedAgo = -1;
-    STATE->exit = 0;
-    STATE->checkpoint = 0;
+    STATE->exit = EntityHandle();
+    STATE->checkpoint = EntityHandle();
     STATE->checkpointsLeft = 0;
+    STATE->tickCount = 0;
+    STATE->activationMargin = ACTIVATION_MARGIN;
 
-    PLAYER = 0;
+    tickedCount = 0;
 
     TraceLog(LOG_INFO, "Level State initialized.");
 }
@@ -77,22 +126,24 @@ void continueLevel() {
 
     STATE->isPaused = false;
 
+    Replay::LevelContinued();
+
     // Reset all the entities to their origins
-    for (Entity *entity = (Entity *) STATE->listHead;
-        entity != 0;
-        entity = (Entity *) entity->next) {
+    Entity *checkpoint = EntityGet(STATE->checkpoint);
+
+    for (Entity *entity : ENTITIES) {
 
         // Doesn't respawn enemies that are too close to the checkpoint,
         // so the player doesn't get stuck
-        if (STATE->checkpoint && entity->tags & IS_ENEMY && entity->isDead) {
+        if (checkpoint && entity->tags & IS_ENEMY && entity->isDead) {
 
-            const auto h = STATE->checkpoint->hitbox;
+            const auto h = checkpoint->hitbox;
             Rectangle enlargedHitbox = { h.x - h.width,
                                             h.y - h.height,
                                             h.width * 3,
                                             h.height * 3 };
 
-            if (CheckCollisionRecs(enlargedHitbox, entity->GetOriginHitbox())) {
+            if (RectanglesCollide(enlargedHitbox, entity->GetOriginHitbox())) {
 
                 TraceLog(LOG_DEBUG, "Didn't respawn entity with tag %d, collided with checkpoint.", entity->tags);
                 continue;
@@ -100,6 +151,8 @@ void continueLevel() {
         }
 
         entity->Reset();
+        EntityMoved(entity);
+        EntitySnap(entity);
     }
 
     CameraLevelCentralizeOnPlayer();
@@ -118,21 +171,142 @@ void leave() {
     TraceLog(LOG_TRACE, "Level left.");
 }
 
+// Puts the entity to sleep if it's outside the activation region, or wakes it up if it's back inside.
+// Returns if the entity is awake.
+static bool updateSleep(EntityStore::Tickable &tickable, Rectangle activationRegion) {
+
+    Entity *entity = tickable.entity;
+
+    if (entity->sleepPolicy == SLEEP_NEVER) return true;
+
+    tickable.activationArea = entity->GetActivationArea();
+    const bool inRegion = RectanglesCollide(activationRegion, tickable.activationArea);
+
+    if (entity->isAsleep && inRegion) {
+        entity->isAsleep = false;
+        entity->Wake();
+    }
+    else if (!entity->isAsleep && !inRegion) {
+        entity->isAsleep = true;
+    }
+
+    tickable.isAsleep = entity->isAsleep;
+
+    return !entity->isAsleep;
+}
+
 void tickAllEntities() {
 
-    Entity *entity = (Entity *) STATE->listHead;
-    Entity *next;
+    isTickingEntities = true;
+
+    STATE->tickCount++;
+    tickedCount = 0;
+
+    const Rectangle activationRegion = GetActivationRegion();
+
+    for (EntityStore::Tickable &tickable : ENTITIES.Tickables()) {
+
+        // Staying asleep, which is known without reaching the entity
+        if (tickable.isAsleep && !RectanglesCollide(activationRegion, tickable.activationArea)) continue;
 
-    while (entity != 0) {
+        Entity *entity = tickable.entity;
 
-        next = (Entity *) entity->next;
+        if (entity->isDestroyQueued) continue;
 
-        // ATTENTION: If the 'next' entity is deleted during Tick() this will break.
-        // Honestly, it's a miracle this hasn't broken so far.
+        if (!updateSleep(tickable, activationRegion)) continue;
+
+        entity->lastTickPos = RectangleGetPos(entity->hitbox);
+        entity->lastTickedAt = STATE->tickCount;
 
         entity->Tick();
-        entity = next;        
+        tickedCount++;
+
+        // Tick() is free to move the entity around
+        EntityMoved(entity);
+    }
+
+    isTickingEntities = false;
+}
+
+// Clears what references an entity that's about to be destroyed
+static void clearReferencesTo(Entity *entity) {
+
+    const EntityHandle handle = entity->handle;
+
+    if (STATE->exit == handle) STATE->exit = EntityHandle();
+
+    if (STATE->checkpoint == handle) STATE->checkpoint = EntityHandle();
+
+    if (PLAYER) {
+
+        GrapplingHook *hook = PLAYER->LaunchedHook();
+
+        if (PLAYER->hookLaunched == handle)
+            PLAYER->hookLaunched = EntityHandle();
+
+        else if (hook && hook->attachedTo == handle)
+            hook->attachedTo = EntityHandle();
+    }
+
+    DebugEntityStop(handle);
+}
+
+static void destroyNow(Entity *entity) {
+
+    clearReferencesTo(entity);
+
+    EntityRemove(entity);
+    EntityFree(entity);
+
+    TraceLog(LOG_TRACE, "Destroyed level entity.");
+}
+
+// Applies the spawns and destructions requested while ticking,
+// and closes the gaps left in the entity store, all in one pass
+static void applyQueuedChanges() {
+
+    for (Entity *entity : spawnQueue) {
+        ENTITIES.Append(entity->handle);
+        spatialHash.Add(entity);
+        groundIndex.Add(entity);
+        tilemap.Add(entity);
+    }
+    spawnQueue.clear();
+
+    for (Entity *entity : destroyQueue) destroyNow(entity);
+    destroyQueue.clear();
+
+    ENTITIES.Compact();
+}
+
+bool IsBetterGroundBeneath(Rectangle hitbox, Entity *entity, Entity *possibleGround, Entity *foundGround) {
+
+    if (possibleGround == entity ||
+        !(possibleGround->tags & IS_GROUND) ||
+        possibleGround->IsDisabled()) {
+
+        return false;
+    }
+
+    int feetHeight = hitbox.y + hitbox.height;
+
+    if (!(// If x is within the possible ground
+        possibleGround->hitbox.x < (hitbox.x + hitbox.width) &&
+        hitbox.x < (possibleGround->hitbox.x + possibleGround->hitbox.width) &&
+
+        // If y is RIGHT above the possible ground
+        abs((int) (possibleGround->hitbox.y - feetHeight)) <= ON_THE_GROUND_Y_TOLERANCE)) {
+
+        return false;
     }
+
+    // Is on a ground
+
+    if (!foundGround) return true;
+
+    // In case of multiple grounds beneath
+    return (entity->isFacingRight && (possibleGround->hitbox.x > foundGround->hitbox.x)) ||
+            (!entity->isFacingRight && (possibleGround->hitbox.x < foundGround->hitbox.x));
 }
 
 // Searches the level for a ground immediatelly beneath the hitbox.
@@ -151,47 +325,23 @@ static Entity *getGroundBeneath(Rectangle hitbox, Entity *entity) {
 
     int feetHeight = hitbox.y + hitbox.height;
 
+    // The heights a ground's top edge can be at to count as beneath the hitbox.
+    // One extra pixel each way, because the tolerance check truncates the distance.
+    Rectangle feetArea = {
+        hitbox.x,
+        (float) (feetHeight - ON_THE_GROUND_Y_TOLERANCE - 1),
+        hitbox.width,
+        (float) (ON_THE_GROUND_Y_TOLERANCE + 1) * 2
+    };
 
-    for (Entity *possibleGround = (Entity *) STATE->listHead;
-        possibleGround != 0;
-        possibleGround = (Entity *) possibleGround->next) {
-
-    
-        if (possibleGround == entity ||
-            !(possibleGround->tags & IS_GROUND) ||
-            possibleGround->IsDisabled()) {
-
-            continue;
-        }
-
-
-        if (// If x is within the possible ground
-            possibleGround->hitbox.x < (hitbox.x + hitbox.width) &&
-            hitbox.x < (possibleGround->hitbox.x + possibleGround->hitbox.width) &&
-
-            // If y is RIGHT above the possible ground
-            abs((int) (possibleGround->hitbox.y - feetHeight)) <= ON_THE_GROUND_Y_TOLERANCE) {
-                
-                // Is on a ground
-
-                if (foundGround) {
-
-                    // In case of multiple grounds beneath
-                    if (
-                        (entity->isFacingRight && (possibleGround->hitbox.x > foundGround->hitbox.x)) ||
-                        (!entity->isFacingRight && (possibleGround->hitbox.x < foundGround->hitbox.x))
-                    ) {
-                        
-                        foundGround = possibleGround;
+    for (Entity *possibleGround : groundIndex.Query(feetArea)) {
 
-                    }
-                }
-                else foundGround = possibleGround;
-            }
+        if (IsBetterGroundBeneath(hitbox, entity, possibleGround, foundGround))
+            foundGround = possibleGround;
     }
 
 
-    return foundGround;   
+    return foundGround;
 }
 
 void Initialize() {
@@ -228,13 +378,15 @@ void Load(char *levelName) {
 
     strcpy(STATE->levelName, levelName);
 
+    Replay::LevelLoaded(levelName);
+
     EditorSync();
 
     CameraLevelCentralizeOnPlayer();
 
     CameraFollow();
 
-    Sounds::PlayMusic(&SOUNDS->Track1);
+    Sounds::PlayMusic(Sounds::SOUND_TRACK_1);
 
     Render::LevelTransitionEffectStart(
         SpritePosMiddlePoint(
@@ -262,12 +414,12 @@ void GoToOverworld() {
 
     DebugEntityStopAll();
 
-    STATE->concludedAgo = GetTime();
+    STATE->concludedAgo = GetSimulationTime();
 }
 
 Entity *CheckpointFlagAdd(Vector2 pos) {
 
-    Entity *newCheckpoint = new Entity();
+    Entity *newCheckpoint = EntityNew<Entity>();
 
     Sprite *sprite = &SPRITES->LevelCheckpointFlag;
     Rectangle hitbox = SpriteHitboxFromEdge(sprite, pos);
@@ -279,7 +431,7 @@ Entity *CheckpointFlagAdd(Vector2 pos) {
     newCheckpoint->isFacingRight = true;
     newCheckpoint->layer = -1;
 
-    LinkedList::AddNode(&STATE->listHead, newCheckpoint);
+    EntityAdd(newCheckpoint);
 
     TraceLog(LOG_TRACE, "Added checkpoint flag to level (x=%.1f, y=%.1f)",
                 newCheckpoint->hitbox.x, newCheckpoint->hitbox.y);
@@ -293,7 +445,7 @@ Entity *ExitAddFromPersistence() {
 
 Entity *ExitAdd(Vector2 pos) {
 
-    Entity *newExit = new Entity();
+    Entity *newExit = EntityNew<Entity>();
 
     Sprite *sprite = &SPRITES->LevelEndOrb;
     Rectangle hitbox = SpriteHitboxFromEdge(sprite, pos);
@@ -307,7 +459,7 @@ Entity *ExitAdd(Vector2 pos) {
 
     newExit->entityTypeID = EXIT_ENTITY_ID;
 
-    STATE->exit = (Entity *) LinkedList::AddNode(&STATE->listHead, newExit);
+    STATE->exit = EntityAdd(newExit)->handle;
 
     TraceLog(LOG_TRACE, "Added exit to level (x=%.1f, y=%.1f)",
                 newExit->hitbox.x, newExit->hitbox.y);
@@ -328,8 +480,8 @@ void ExitAddFromEditor(Vector2 pos, int interactionTags) {
     }
 
     // Currently only one level exit is supported, but this should change in the future.
-    if (STATE->exit)
-        LinkedList::DestroyNode(&STATE->listHead, STATE->exit);
+    if (Entity *exit = EntityGet(STATE->exit))
+        EntityDestroy(exit);
     
     ExitAdd({ hitbox.x, hitbox.y });
 }
@@ -344,6 +496,49 @@ Entity *GetGroundBeneathHitbox(Rectangle hitbox) {
     return getGroundBeneath(hitbox, 0);
 }
 
+void EntitiesReserve(size_t count) {
+
+    ENTITIES.Reserve(count);
+    spatialHash.Reserve(count);
+    groundIndex.Reserve(count);
+}
+
+void EntityFree(Entity *entity) {
+
+    EntityPool *pool = entity->pool;
+
+    if (!pool) {
+        delete entity;
+        return;
+    }
+
+    void *memory = dynamic_cast<void *>(entity); // the start of the whole object
+    entity->~Entity();
+    pool->Free(memory);
+}
+
+Entity *EntityAdd(Entity *entity) {
+
+    entity->spawnOrder = entitiesAddedCount++;
+    entity->sleepPolicy = entity->GetSleepPolicy();
+
+    if (isTickingEntities) {
+
+        // Gets its handle right away, but only joins the level at the end of the tick
+        ENTITIES.Register(entity);
+        spawnQueue.push_back(entity);
+
+        return entity;
+    }
+
+    ENTITIES.Add(entity);
+    spatialHash.Add(entity);
+    groundIndex.Add(entity);
+    tilemap.Add(entity);
+
+    return entity;
+}
+
 void EntityDestroy(Entity *entity) {
 
     if (entity->tags & IS_PLAYER) {
@@ -356,30 +551,122 @@ void EntityDestroy(Entity *entity) {
         return;
     }
 
-    if (entity == STATE->exit) STATE->exit = 0;
+    if (isTickingEntities) {
 
-    if (entity == STATE->checkpoint) STATE->checkpoint = 0;
+        if (entity->isDestroyQueued) return;
 
-    if (PLAYER->hookLaunched)
-        if (entity == PLAYER->hookLaunched->attachedTo)
-            PLAYER->hookLaunched->attachedTo = 0;
+        // It's destroyed at the end of the tick, but it's already out of the collision queries
+        entity->isDestroyQueued = true;
+        spatialHash.Remove(entity);
+        groundIndex.Remove(entity);
+        tilemap.Remove(entity);
+        destroyQueue.push_back(entity);
 
-    DebugEntityStop(entity);
+        return;
+    }
 
-    LinkedList::DestroyNode(&STATE->listHead, entity);
+    destroyNow(entity);
+}
 
-    TraceLog(LOG_TRACE, "Destroyed level entity.");
+void EntityRemove(Entity *entity) {
+
+    spatialHash.Remove(entity);
+    groundIndex.Remove(entity);
+    tilemap.Remove(entity);
+    ENTITIES.Remove(entity->handle);
+}
+
+Entity *EntityGet(EntityHandle handle) {
+
+    return ENTITIES.Get(handle);
+}
+
+void EntityMoved(Entity *entity) {
+
+    // Not in the level (yet), or on its way out
+    if (!entity->isIndexed) return;
+
+    ENTITIES.Moved(entity);
+    spatialHash.Update(entity);
+    groundIndex.Update(entity);
+    tilemap.Update(entity);
+}
+
+void EntitySnap(Entity *entity) {
+
+    entity->lastTickedAt = 0;
+}
+
+void TileChanged(Entity *entity) {
+
+    // Not in the level (yet), or on its way out
+    if (!entity->isIndexed) return;
+
+    tilemap.Update(entity);
+}
+
+Tilemap &GetTilemap() {
+    return tilemap;
+}
+
+Rectangle GetActivationRegion() {
+
+    // Uses the native resolution instead of the window's, so it doesn't depend on the display
+    const Dimensions margin = STATE->activationMargin;
+
+    return {
+        CAMERA->pos.x - margin.width,
+        CAMERA->pos.y - margin.height,
+        SCREEN_WIDTH / CAMERA->zoom + margin.width * 2,
+        SCREEN_HEIGHT / CAMERA->zoom + margin.height * 2
+    };
+}
+
+const std::vector<Entity *> &EntitiesNear(Rectangle area) {
+    return spatialHash.Query(area);
+}
+
+size_t TickedEntitiesCount() {
+    return tickedCount;
+}
+
+double ElapsedTime() {
+    return STATE->tickCount * TICK_DURATION;
+}
+
+// FNV-1a
+void StateHashAdd(uint32_t *hash, const void *data, size_t size) {
+
+    const unsigned char *bytes = (const unsigned char *) data;
+
+    for (size_t i = 0; i < size; i++) {
+        *hash ^= bytes[i];
+        *hash *= 16777619u;
+    }
+}
+
+uint32_t StateHash() {
+
+    uint32_t hash = 2166136261u;
+
+    for (Entity *entity : ENTITIES) {
+        StateHashAdd(&hash, entity->hitbox);
+        StateHashAdd(&hash, entity->isDead);
+        StateHashAdd(&hash, entity->isFacingRight);
+        StateHashAdd(&hash, entity->isFallingDown);
+        entity->HashMotionState(&hash);
+    }
+
+    return hash;
 }
 
 Entity *EntityGetAt(Vector2 pos) {
 
     Entity *result = 0;
 
-    for (Entity *e = (Entity *) STATE->listHead;
-        e != 0;
-        e = (Entity *) e->next) {
+    for (Entity *e : spatialHash.Query({ pos.x, pos.y, 0, 0 })) {
 
-            if (CheckCollisionPointRec(pos, e->hitbox)) {
+            if (PointInRectangle(pos, e->hitbox)) {
                 result = e; break;
             }
     }
@@ -391,17 +678,15 @@ Entity *EntityGetRemoveableAt(Vector2 pos) {
 
     Entity *result = 0;
 
-    for (Entity *entity = (Entity *) STATE->listHead;
-        entity != 0;
-        entity = (Entity *) entity->next) {
+    for (Entity *entity : spatialHash.Query({ pos.x, pos.y, 0, 0 })) {
 
             if (entity->tags & IS_PLAYER) continue;
 
-            if (CheckCollisionPointRec(pos, entity->GetOriginHitbox())) {
+            if (PointInRectangle(pos, entity->GetOriginHitbox())) {
                 result = entity; break;
             }
 
-            if (!entity->IsDisabled() && CheckCollisionPointRec(pos, entity->hitbox)) {
+            if (!entity->IsDisabled() && PointInRectangle(pos, entity->hitbox)) {
                 result = entity; break;
             }
     }
@@ -433,9 +718,7 @@ void InflatePauseMenu() {
     GAME_STATE->menu = new Menu();
     GAME_STATE->menu->AddItem(new MenuItem("Continuar", &PauseToggle));
     GAME_STATE->menu->AddItem(new MenuItemToggle("Caixas de texto do desenvolvedor", &ToggleDevTextbox, &IsDevTextboxEnabled));
-    GAME_STATE->menu->AddItem(new MenuItemToggle("Som", &Sounds::Toggle, &Sounds::IsEnabled));
-    GAME_STATE->menu->AddItem(new MenuItemToggle("Tela cheia", &Render::FullscreenToggle, &Render::IsFullscreen));
-    GAME_STATE->menu->AddItem(new MenuItemToggle("Shader CRT", &Render::CrtToggle, &Render::IsCrtEnabled));
+    MenuAddSettingsItems(GAME_STATE->menu);
     GAME_STATE->menu->AddItem(new MenuItem("Sair do jogo", &GameExit));
 }
 
@@ -452,7 +735,7 @@ void Tick() {
     // TODO check if having the first check before saves on processing,
     // of if it's just redundant. 
     if (STATE->concludedAgo != -1 &&
-        GetTime() - STATE->concludedAgo > LEVEL_TRANSITION_ANIMATION_DURATION) {
+        GetSimulationTime() - STATE->concludedAgo > LEVEL_TRANSITION_ANIMATION_DURATION) {
 
         leave();
 
@@ -461,8 +744,23 @@ void Tick() {
         return;
     }
 
-    if (!STATE->isPaused && !EDITOR_STATE->isEnabled)
+    // Continuing after dying is done from the pause menu when playing,
+    // so when playing back it's done here, before the tick it was recorded with
+    if (STATE->isPaused && PLAYER && PLAYER->isDead && Replay::PlaybackContinuesLevel())
+        continueLevel();
+
+    tickedLastUpdate = !STATE->isPaused && !EDITOR_STATE->isEnabled;
+
+    if (tickedLastUpdate) {
+        Input::ApplyTickInput();
         tickAllEntities();
+    }
+
+    // Also closes the gaps left by entities removed this frame by the editor
+    applyQueuedChanges();
+
+    if (tickedLastUpdate)
+        Replay::TickState(StateHash());
 
     CameraTick();
 }
@@ -474,51 +772,45 @@ Level::Entity *CheckCollisionWithAnyEntity(Vector2 point) {
 
 Level::Entity *CheckCollisionWithAnyEntity(Rectangle hitbox) {
 
-    Entity *entity = (Entity *) STATE->listHead;
+    for (Entity *entity : spatialHash.Query(hitbox)) {
 
-    while (entity != 0) {
-
-        if (!entity->IsDisabled() && CheckCollisionRecs(hitbox, entity->hitbox)) {
-            break; // found it
+        if (!entity->IsDisabled() && RectanglesCollide(hitbox, entity->hitbox)) {
+            return entity; // found it
         }
-
-        entity = (Entity *) entity->next;
     }
 
-    return entity;
+    return 0;
 }
 
 Level::Entity *CheckCollisionWithAnything(Rectangle hitbox) {
 
-    return CheckCollisionWithAnythingElse(hitbox, std::vector<LinkedList::Node *>());
+    return CheckCollisionWithAnythingElse(hitbox, std::vector<EntityHandle>());
 }
 
-Level::Entity *CheckCollisionWithAnythingElse(Rectangle hitbox, std::vector<LinkedList::Node *> entitiesToIgnore) {
-
-    Entity *entity = (Entity *) STATE->listHead;
+Level::Entity *CheckCollisionWithAnythingElse(Rectangle hitbox, std::vector<EntityHandle> entitiesToIgnore) {
 
-    while (entity != 0) {
+    for (Entity *entity : spatialHash.Query(hitbox)) {
 
         Rectangle entitysOrigin = {
                                         entity->origin.x,       entity->origin.y,
                                         entity->hitbox.width,   entity->hitbox.height
                                     };
 
-        if (CheckCollisionRecs(hitbox, entitysOrigin) ||
-            (!entity->IsDisabled() && CheckCollisionRecs(hitbox, entity->hitbox))) {
+        if (RectanglesCollide(hitbox, entitysOrigin) ||
+            (!entity->IsDisabled() && RectanglesCollide(hitbox, entity->hitbox))) {
 
             for (auto e = entitiesToIgnore.begin(); e < entitiesToIgnore.end(); e++) {
-                if (*e == entity) goto next_entity;
+                if (*e == entity->handle) goto next_entity;
             }
 
-            break; // found it
+            return entity; // found it
         }
 
 next_entity:
-        entity = (Entity *) entity->next;
+        ;
     }
 
-    return entity;
+    return 0;
 }
 
 void Save() {
@@ -532,11 +824,12 @@ void LoadNew() {
     PLAYER->origin = PLAYERS_ORIGIN;
     PLAYER->hitbox.x = PLAYER->origin.x;
     PLAYER->hitbox.y = PLAYER->origin.y;
+    EntityMoved(PLAYER);
 
     strcpy(STATE->levelName, NEW_LEVEL_NAME);
 }
 
-void Entity::AddFromPersistence(const std::string &entityTypeID, const std::string &data) {
+bool Entity::AddFromPersistence(std::string_view entityTypeID, const PersistenceFields &fields) {
 
     Level::Entity *entity;
 
@@ -565,11 +858,15 @@ void Entity::AddFromPersistence(const std::string &entityTypeID, const std::stri
     else if (entityTypeID == COIN_ENTITY_ID)
         entity = Coin::AddFromPersistence();
     else {
-        TraceLog(LOG_ERROR, "Unknow entity type found when adding level entity for persistence, entityTypeID=%s.", entityTypeID.c_str());
-        return; 
+        TraceLog(LOG_ERROR, "Unknow entity type found when adding level entity for persistence, entityTypeID=%.*s.",
+                    (int) entityTypeID.size(), entityTypeID.data());
+        return false;
     }
 
-    entity->PersistenceParse(data);
+    bool parsed = entity->PersistenceParse(fields);
+    EntityMoved(entity);
+
+    return parsed;
 }
 
 void Entity::Reset()
@@ -580,6 +877,18 @@ void Entity::Reset()
     hitbox.y = origin.y;
 }
 
+void Entity::SetHitboxPos(Vector2 pos) {
+
+    RectangleSetPos(&hitbox, pos);
+    EntityMoved(this);
+}
+
+void Entity::SetOrigin(Vector2 origin) {
+
+    this->origin = origin;
+    EntityMoved(this);
+}
+
 void Entity::Tick() {            
 
     // Default entity has no tick routine
@@ -590,6 +899,28 @@ std::string Entity::GetEntityDebugString() {
                         "\ny=" + std::to_string((int) hitbox.y));
 }
 
+Vector2 Entity::GetRenderPos() {
+
+    const Vector2 pos = RectangleGetPos(hitbox);
+
+    // What didn't move in the last tick is drawn where it is
+    if (!tickedLastUpdate || lastTickedAt != STATE->tickCount) return pos;
+
+    const float t = GetTickInterpolation();
+
+    return {
+        lastTickPos.x + (pos.x - lastTickPos.x) * t,
+        lastTickPos.y + (pos.y - lastTickPos.y) * t
+    };
+}
+
+Vector2 Entity::GetRenderOffset() {
+
+    const Vector2 renderPos = GetRenderPos();
+
+    return { renderPos.x - hitbox.x, renderPos.y - hitbox.y };
+}
+
 void Entity::Draw() {            
 
     Render::DrawLevelEntity(this);
@@ -603,21 +934,21 @@ void Entity::DrawMoveGhost() {
     Render::DrawLevelEntityMoveGhost(this);
 }
 
-std::string Entity::PersistanceSerialize() {
+void Entity::PersistanceSerialize(std::string *line) {
 
-    std::string data;
-    persistanceAddValue(&data, "originX", std::to_string(origin.x));
-    persistanceAddValue(&data, "originY", std::to_string(origin.y));
-    return data;
+    persistanceAddValue(line, "originX", origin.x);
+    persistanceAddValue(line, "originY", origin.y);
 }
 
-void Entity::PersistenceParse(const std::string &data) {
+bool Entity::PersistenceParse(const PersistenceFields &fields) {
 
-    origin.x = std::stof(persistenceReadValue(data, "originX"));
-    origin.y = std::stof(persistenceReadValue(data, "originY"));
+    if (!fields.ReadFloat("originX", &origin.x) ||
+        !fields.ReadFloat("originY", &origin.y)) return false;
     
     hitbox.x = origin.x;
     hitbox.y = origin.y;
+
+    return true;
 }
 
 } // namespace
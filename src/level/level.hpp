@@ -6,11 +6,15 @@
 #include <string>
 #include <vector>
 
-#include "../linked_list.hpp"
-#include "../assets.hpp"
+#include "../sprites.hpp"
 #include "../core.hpp"
 #include "../persistence.hpp"
 #include "../render.hpp"
+#include "entity_store.hpp"
+#include "entity_pool.hpp"
+#include "spatial_hash.hpp"
+#include "ground_index.hpp"
+#include "tilemap.hpp"
 
 
 // The level used as a basis for new levels
@@ -22,6 +26,9 @@
 // Below this y entities die
 #define FLOOR_DEATH_HEIGHT      1400
 
+// How far beyond the camera view, by default, entities keep ticking
+#define ACTIVATION_MARGIN       Dimensions(400, 300)
+
 #define EXIT_ENTITY_ID          "lvl_exit"
 
 #define UNKNOW_LEVEL_ENTITY_ID  "!!!_unknown_level_entity"
@@ -52,10 +59,39 @@ typedef enum {
     IS_COIN                 = 32768 * 8,
 } EntityTag;
 
+// What a tickable entity does when it's outside the activation region around the camera
+typedef enum {
+    // Keeps ticking anywhere in the level
+    SLEEP_NEVER,
+    // Stops ticking and being drawn, and resumes from where it was when it wakes
+    SLEEP_FREEZE,
+    // Stops ticking and being drawn, and catches up with the level's tick count when it wakes
+    SLEEP_ANALYTIC,
+} SleepPolicy;
+
 
-class Entity : public LinkedList::Node, public Render::IDrawable, public IPersistable {
+class Entity : public Render::IDrawable, public IPersistable {
 
 public:
+    // This entity's handle in the level's entity store, or a zeroed handle if it's not in it
+    EntityHandle handle;
+
+    // The pool the entity was allocated from, or 0 if it wasn't created by EntityNew()
+    EntityPool *pool = 0;
+
+    // If it was destroyed while ticking, and is waiting for the end of the tick to go away
+    bool isDestroyQueued = false;
+
+    // If it's outside the activation region, and so not ticked nor drawn
+    bool isAsleep = false;
+
+    // Its type's GetSleepPolicy(), cached when it joins the level
+    SleepPolicy sleepPolicy = SLEEP_FREEZE;
+
+    // Where the hitbox was before the last time the entity ticked, and in which tick, for interpolating its rendering
+    Vector2 lastTickPos;
+    unsigned long int lastTickedAt = 0;
+
     unsigned long int tags;
     Vector2 origin;
     Rectangle hitbox;
@@ -63,17 +99,37 @@ public:
     Sprite *sprite;
     int layer;
 
-    bool isDead;
+    bool isDead = false;
+
+    bool isFacingRight = false;
+    bool isFallingDown = false;
+
+    // The order in which the entity was added to the level, so spatial queries
+    // can return the same entity that iterating the entity list would
+    unsigned long int spawnOrder = 0;
+
+    // The cells the spatial hash indexed this entity under, if it's indexed
+    bool isIndexed = false;
+    CellRange indexedHitboxCells;
+    CellRange indexedOriginCells;
+
+    // The cells the ground index indexed this entity's top edge under, if it's indexed
+    bool isGroundIndexed = false;
+    CellRange indexedGroundCells;
 
-    bool isFacingRight;
-    bool isFallingDown;
+    // If the level's tilemap draws this entity, and in which cell
+    bool isInTilemap = false;
+    int tilemapCellX;
+    int tilemapCellY;
 
     // It's an object attribute so it supports entity types that simply instantiates Entity (i.e. not a subclass).
     // It would save memory, though, if it was part of the class definition -- like a static method returning a compile-time const.
-    std::string entityTypeID = UNKNOW_LEVEL_ENTITY_ID;
+    // A view of one of the *_ENTITY_ID literals, so setting it doesn't allocate.
+    std::string_view entityTypeID = UNKNOW_LEVEL_ENTITY_ID;
     
-    // Uses the entityTypeID to create a new entity, and parses the data to it.
-    static void AddFromPersistence(const std::string &entityTypeID, const std::string &data);
+    // Uses the entityTypeID to create a new entity, and parses the fields to it.
+    // Returns 'false' if the type is unknown or the fields couldn't be parsed.
+    static bool AddFromPersistence(std::string_view entityTypeID, const PersistenceFields &fields);
 
     // Resets entity to its default state
     virtual void Reset();
@@ -85,26 +141,54 @@ public:
         };
     }
 
-    virtual void SetHitboxPos(Vector2 pos) {
-        RectangleSetPos(&hitbox, pos);
-    }
+    virtual void SetHitboxPos(Vector2 pos);
 
-    virtual void SetOrigin(Vector2 origin) {
-        this->origin = origin;
-    }    
+    virtual void SetOrigin(Vector2 origin);
 
     virtual void Tick();
 
+    // If the entity type has a Tick() routine. Checked once, when the entity joins the level,
+    // and only the entities that tick are ticked.
+    virtual bool IsTickable() { return false; }
+
+    // How a tickable entity of this type behaves far from the camera. Checked once, when the entity joins the level.
+    virtual SleepPolicy GetSleepPolicy() { return SLEEP_FREEZE; }
+
+    // The area that, if inside the activation region, keeps the entity awake
+    virtual Rectangle GetActivationArea() { return hitbox; }
+
+    // The area the entity draws over, for entities that draw outside of their hitbox and origin.
+    // The spatial hash indexes it too, so the entity is found when culling what's off-screen.
+    virtual Rectangle GetDrawArea() { return hitbox; }
+
+    // Called when the entity comes back into the activation region, before it's ticked
+    virtual void Wake() {}
+
+    // If the entity is a static, grid-locked tile, which the level's tilemap can draw instead of the entity itself
+    virtual bool IsTile() { return false; }
+
+    // A tile's rotation, in degrees, in steps of 90
+    virtual int GetTileRotation() { return 0; }
+
+    // Adds what moves the entity from tick to tick, past its hitbox and facing (e.g. velocities), to a StateHash()
+    virtual void HashMotionState(uint32_t *hash) { (void) hash; }
+
     virtual std::string GetEntityDebugString();
 
+    // Where to draw the entity's hitbox, between where it was before and after the last tick
+    Vector2 GetRenderPos();
+
+    // How far the entity's rendering is from its hitbox
+    Vector2 GetRenderOffset();
+
     void Draw();
     void DrawMoveGhost();
 
-    virtual std::string PersistanceSerialize();
-    virtual void PersistenceParse(const std::string &data);
+    virtual void PersistanceSerialize(std::string *line);
+    virtual bool PersistenceParse(const PersistenceFields &fields);
 
     // Yields the entityTypeID system for the PersistenceEntityID tag.
-    const std::string &PersitenceEntityID() override final {
+    std::string_view PersitenceEntityID() override final {
         if (entityTypeID == UNKNOW_LEVEL_ENTITY_ID) {
             TraceLog(LOG_ERROR, "Level entity had its PersitenceEntityID() called, but it has no entityTypeID [tags=%lu]", tags);
         }
@@ -115,14 +199,13 @@ public:
     virtual bool IsDisabled() {
         return false;
     }
+
+    virtual ~Entity() = default; // so objects from derived classes can be deleted from an Entity pointer
 };
 
 
 typedef struct LevelState {
 
-    // The head of the linked list of all the level entities
-    LinkedList::Node *listHead;
-
     // The current loaded level's name
     char levelName[LEVEL_NAME_BUFFER_SIZE];
 
@@ -135,20 +218,29 @@ typedef struct LevelState {
     // How long ago, in seconds, the level concluded, or -1 if it's not concluded
     double concludedAgo;
 
-    // Reference to the level exit in the level entity's list
-    Entity *exit;
+    // Reference to the level exit in the level entity store
+    EntityHandle exit;
 
-    // Reference to the current checkpoint in the level entity's list
-    Entity *checkpoint;
+    // Reference to the current checkpoint in the level entity store
+    EntityHandle checkpoint;
 
     // How many checkpoints the player has left
     int checkpointsLeft;
 
+    // How many times the entities were ticked since the level was loaded
+    unsigned long int tickCount;
+
+    // How far beyond the camera view entities keep ticking
+    Dimensions activationMargin;
+
 } LevelState;
 
 
 extern LevelState *STATE;
 
+// All the level entities
+extern EntityStore ENTITIES;
+
 
 // Initialize the level system
 void Initialize();
@@ -179,9 +271,83 @@ Entity *GetGroundBeneath(Entity *entity);
 // The ground beneath a hitbox, or 0 if not on the ground.
 Entity *GetGroundBeneathHitbox(Rectangle hitbox);
 
-// Destroys an Entity
+// If 'possibleGround' is a ground immediatelly beneath the hitbox, and should be picked over 'foundGround' (or 0).
+// The rule GetGroundBeneath() goes by, out of the grounds the ground index has around the hitbox.
+bool IsBetterGroundBeneath(Rectangle hitbox, Entity *entity, Entity *possibleGround, Entity *foundGround);
+
+// Makes room for this many entities in the level's entity list and indexes,
+// so adding them doesn't allocate one by one, e.g. before loading a level
+void EntitiesReserve(size_t count);
+
+// Creates an entity in its type's pool. It must be destroyed with EntityFree(),
+// or by the level being released.
+template <typename T>
+T *EntityNew() {
+
+    EntityPool &pool = EntityPoolOf<T>();
+
+    T *entity = new (pool.Allocate()) T();
+    entity->pool = &pool;
+
+    return entity;
+}
+
+// Destroys an entity and gives its memory back, without removing it from the level
+void EntityFree(Entity *entity);
+
+// Adds an entity to the level. Returns the entity. While the entities are being ticked,
+// it gets its handle right away, but only joins the level at the end of the tick.
+Entity *EntityAdd(Entity *entity);
+
+// Destroys an Entity, clearing the level's references to it.
+// While the entities are being ticked, it's only destroyed at the end of the tick.
 void EntityDestroy(Entity *entity);
 
+// Removes an entity from the level, but doesn't destroy it.
+void EntityRemove(Entity *entity);
+
+// The entity a handle refers to, or 0 if it's no longer in the level
+Entity *EntityGet(EntityHandle handle);
+
+// Lets the level know an entity's hitbox or origin changed, so the spatial queries can find it.
+// Changes made during the entity's own Tick() are picked up automatically.
+void EntityMoved(Entity *entity);
+
+// Stops the entity's rendering from being interpolated until it's ticked again, e.g. after it teleported
+void EntitySnap(Entity *entity);
+
+// Lets the level know a tile changed its sprite or rotation, so the tilemap draws it right
+void TileChanged(Entity *entity);
+
+// The level's static tiles, for drawing them all at once
+Tilemap &GetTilemap();
+
+// The area around the camera where entities are awake
+Rectangle GetActivationRegion();
+
+// The entities whose hitbox, origin or draw area are near an area, in the
+// order they were added to the level. Valid until the next query.
+const std::vector<Entity *> &EntitiesNear(Rectangle area);
+
+// How many entities were ticked in the last tick
+size_t TickedEntitiesCount();
+
+// Seconds simulated in the current level, i.e. its tickCount in seconds.
+// Doesn't depend on when the level was loaded, so the level plays out the same every time.
+double ElapsedTime();
+
+// A hash of the entities' simulation state (hitboxes, velocities and the other motion state, if they're dead),
+// to detect when two runs of the same level diverge
+uint32_t StateHash();
+
+// Adds the bytes to a StateHash()
+void StateHashAdd(uint32_t *hash, const void *data, size_t size);
+
+template <typename T>
+void StateHashAdd(uint32_t *hash, const T &value) {
+    StateHashAdd(hash, &value, sizeof(value));
+}
+
 // Searches for any level entity in the given position
 Entity *EntityGetAt(Vector2 pos);
 
@@ -221,7 +387,7 @@ Entity *CheckCollisionWithAnything(Rectangle hitbox);
 
 // Checks for collision between a rectangle and any living entity in the level,
 // including their origins, as long as it's NOT present in a given entity vector.
-Entity *CheckCollisionWithAnythingElse(Rectangle hitbox, std::vector<LinkedList::Node *> entitiesToIgnore);
+Entity *CheckCollisionWithAnythingElse(Rectangle hitbox, std::vector<EntityHandle> entitiesToIgnore);
 
 
 } // namespace
@@ -57,18 +57,13 @@ void MovingPlatformAnchor::SetOrigin(Vector2 origin) {
 void MovingPlatformAnchor::Draw() {
 
     if (EDITOR_STATE->isEnabled) {
-        Vector2 p = PosInSceneToScreen(pos);
-        float r = ScaleInSceneToScreen(ANCHOR_HITBOX_SIDE / 2);
-        DrawCircleLines(p.x, p.y, r, color);
+        Render::DrawSceneCircleLines(pos, ANCHOR_HITBOX_SIDE / 2, color);
     }
 }
 
 void MovingPlatformAnchor::DrawMoveGhost() {
 
-    Vector2 p = PosInSceneToScreen(EditorEntitySelectionCalcMove(pos));
-    float r = ScaleInSceneToScreen(ANCHOR_HITBOX_SIDE / 2);
-
-    DrawCircleLines(p.x, p.y, r,
+    Render::DrawSceneCircleLines(EditorEntitySelectionCalcMove(pos), ANCHOR_HITBOX_SIDE / 2,
                     { color.r, color.g, color.b, EDITOR_SELECTION_MOVE_TRANSPARENCY });
 }
 
@@ -81,7 +76,7 @@ MovingPlatform *MovingPlatform::AddFromPersistence() {
 MovingPlatform *MovingPlatform::Add(Vector2 startPos, Vector2 endPos, int size) {
 
 
-    MovingPlatform *newPlatform = new MovingPlatform();
+    MovingPlatform *newPlatform = Level::EntityNew<MovingPlatform>();
 
     newPlatform->tags = Level::IS_GEOMETRY +
                             Level::IS_GROUND +
@@ -98,7 +93,11 @@ MovingPlatform *MovingPlatform::Add(Vector2 startPos, Vector2 endPos, int size)
     newPlatform->setSize(size);
 
 
-    LinkedList::AddNode(&Level::STATE->listHead, newPlatform);
+    Level::EntityAdd(newPlatform);
+
+    // The anchors aren't ticked or drawn by the level, but they can be referenced (e.g. by the editor's selection)
+    Level::ENTITIES.Register(&newPlatform->startAnchor);
+    Level::ENTITIES.Register(&newPlatform->endAnchor);
 
     TraceLog(LOG_TRACE, "Added moving platform to level (x=%.1f, y=%.1f)",
                 newPlatform->hitbox.x, newPlatform->hitbox.y);
@@ -125,10 +124,16 @@ Rectangle MovingPlatform::GetOriginHitbox() {
     };
 }
 
+MovingPlatform::~MovingPlatform() {
+    Level::ENTITIES.Remove(startAnchor.handle);
+    Level::ENTITIES.Remove(endAnchor.handle);
+}
+
 void MovingPlatform::UpdateAfterAnchorMove() {
 
     this->origin = this->startAnchor.pos;
     updateAngle();
+    trackStartTick = Level::STATE->tickCount;
     movePlatformTo(origin); // resets current position
 }
 
@@ -136,21 +141,7 @@ void MovingPlatform::Tick() {
 
     Vector2 oldPos = currentPos;
 
-    int direction = isFacingRight ? 1 : -1;
-    
-    movePlatformTo({
-        (float)(currentPos.x + PLATFORM_SPEED * cos(angle) * direction),
-        (float)(currentPos.y - PLATFORM_SPEED * sin(angle) * direction)
-    });
-
-    if ((currentPos.x > startAnchor.pos.x && currentPos.x > endAnchor.pos.x) ||
-        (currentPos.x < startAnchor.pos.x && currentPos.x < endAnchor.pos.x) ||
-        (currentPos.y > startAnchor.pos.y && currentPos.y > endAnchor.pos.y) ||
-        (currentPos.y < startAnchor.pos.y && currentPos.y < endAnchor.pos.y)) {
-
-            isFacingRight = !isFacingRight;
-    }
-
+    movePlatformToTick(Level::STATE->tickCount);
 
     lastFrameTrajectory = {
         currentPos.x - oldPos.x,
@@ -158,27 +149,60 @@ void MovingPlatform::Tick() {
     };
 }
 
+Rectangle MovingPlatform::GetActivationArea() {
+
+    float x0 = fminf(startAnchor.pos.x, endAnchor.pos.x) - hitbox.width/2;
+    float y0 = fminf(startAnchor.pos.y, endAnchor.pos.y) - hitbox.height/2;
+    float x1 = fmaxf(startAnchor.pos.x, endAnchor.pos.x) + hitbox.width/2;
+    float y1 = fmaxf(startAnchor.pos.y, endAnchor.pos.y) + hitbox.height/2;
+
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+Rectangle MovingPlatform::GetDrawArea() {
+
+    Rectangle track = GetActivationArea();
+
+    // The anchors are drawn around the track's ends
+    return {
+        track.x - ANCHOR_HITBOX_SIDE/2, track.y - ANCHOR_HITBOX_SIDE/2,
+        track.width + ANCHOR_HITBOX_SIDE, track.height + ANCHOR_HITBOX_SIDE
+    };
+}
+
+void MovingPlatform::Wake() {
+
+    movePlatformToTick(Level::STATE->tickCount);
+
+    // Whatever is on it wasn't carried while it slept
+    lastFrameTrajectory = { 0, 0 };
+}
+
+void MovingPlatform::HashMotionState(uint32_t *hash) {
+
+    Level::StateHashAdd(hash, currentPos);
+    Level::StateHashAdd(hash, angle);
+    Level::StateHashAdd(hash, trackStartTick);
+    Level::StateHashAdd(hash, lastFrameTrajectory);
+}
+
 void MovingPlatform::Draw() {
 
     // Draw track
-    Vector2 sp = PosInSceneToScreen(startAnchor.pos);
-    Vector2 ep = PosInSceneToScreen(endAnchor.pos);
-    DrawLine(sp.x, sp.y, ep.x, ep.y, RAYWHITE);
+    Render::DrawSceneLine(startAnchor.pos, endAnchor.pos, 1, RAYWHITE);
 
     // Draw platform
+    const Vector2 renderPos = GetRenderPos();
     for (int i = 0; i < size; i++) {
-        Vector2 pos = PosInSceneToScreen({
-                                        hitbox.x + (sprite->sprite.width * sprite->scale * i),
-                                        hitbox.y });
+        Vector2 pos = { renderPos.x + (sprite->source.width * sprite->scale * i), renderPos.y };
         Render::DrawTexture(sprite, pos, WHITE, 0, false);
     }
 
     // Draw platform origin ghost
     if (EDITOR_STATE->isEnabled) {
         for (int i = 0; i < size; i++) {
-            Vector2 pos = PosInSceneToScreen({
-                                            GetOriginHitbox().x + (sprite->sprite.width * sprite->scale * i),
-                                            GetOriginHitbox().y });
+            Vector2 pos = { GetOriginHitbox().x + (sprite->source.width * sprite->scale * i),
+                                GetOriginHitbox().y };
             Color color = { WHITE.r, WHITE.g, WHITE.b, ORIGIN_GHOST_TRANSPARENCY };
             Render::DrawTexture(sprite, pos, color, 0, false);
         }
@@ -189,32 +213,33 @@ void MovingPlatform::Draw() {
     endAnchor.Draw();
 }
 
-std::string MovingPlatform::PersistanceSerialize() {
+void MovingPlatform::PersistanceSerialize(std::string *line) {
 
-    std::string data = Level::Entity::PersistanceSerialize();
-    persistanceAddValue(&data, "startPosX", std::to_string(startAnchor.pos.x));
-    persistanceAddValue(&data, "startPosY", std::to_string(startAnchor.pos.y));
-    persistanceAddValue(&data, "endPosX", std::to_string(endAnchor.pos.x));
-    persistanceAddValue(&data, "endPosY", std::to_string(endAnchor.pos.y));
-    persistanceAddValue(&data, "size", std::to_string(size));
-    return data;
+    Level::Entity::PersistanceSerialize(line);
+    persistanceAddValue(line, "startPosX", startAnchor.pos.x);
+    persistanceAddValue(line, "startPosY", startAnchor.pos.y);
+    persistanceAddValue(line, "endPosX", endAnchor.pos.x);
+    persistanceAddValue(line, "endPosY", endAnchor.pos.y);
+    persistanceAddValue(line, "size", size);
 }
 
-void MovingPlatform::PersistenceParse(const std::string &data) {
+bool MovingPlatform::PersistenceParse(const PersistenceFields &fields) {
 
     Vector2 startPos, endPos;
     int size;
 
-    Level::Entity::PersistenceParse(data);
-    startPos.x = std::stof(persistenceReadValue(data, "startPosX"));
-    startPos.y = std::stof(persistenceReadValue(data, "startPosY"));
-    endPos.x = std::stof(persistenceReadValue(data, "endPosX"));
-    endPos.y = std::stof(persistenceReadValue(data, "endPosY"));
-    size = std::stoi(persistenceReadValue(data, "size"));
+    if (!Level::Entity::PersistenceParse(fields) ||
+        !fields.ReadFloat("startPosX", &startPos.x) ||
+        !fields.ReadFloat("startPosY", &startPos.y) ||
+        !fields.ReadFloat("endPosX", &endPos.x) ||
+        !fields.ReadFloat("endPosY", &endPos.y) ||
+        !fields.ReadInt("size", &size)) return false;
 
     startAnchor.SetPos(startPos);
     endAnchor.SetPos(endPos);
     setSize(size);
+
+    return true;
 }
 
 void MovingPlatform::setSize(int size) {
@@ -234,6 +259,28 @@ void MovingPlatform::movePlatformTo(Vector2 newPos) {
     updateHitbox();
 }
 
+void MovingPlatform::movePlatformToTick(unsigned long int tick) {
+
+    const double trackLength = hypot(endAnchor.pos.x - startAnchor.pos.x, endAnchor.pos.y - startAnchor.pos.y);
+
+    if (trackLength == 0) {
+        isFacingRight = true;
+        movePlatformTo(startAnchor.pos);
+        return;
+    }
+
+    // Goes back and forth along the track, so the distance from the start is a triangle wave
+    const double traveled = fmod((double) (tick - trackStartTick) * PLATFORM_SPEED, trackLength * 2);
+
+    isFacingRight = traveled < trackLength;
+    const double distance = isFacingRight ? traveled : trackLength * 2 - traveled;
+
+    movePlatformTo({
+        (float)(startAnchor.pos.x + distance * cos(angle)),
+        (float)(startAnchor.pos.y - distance * sin(angle))
+    });
+}
+
 void MovingPlatform::updateHitbox() {
 
     Dimensions dimensions = SpriteScaledDimensions(sprite);
@@ -245,6 +292,8 @@ void MovingPlatform::updateHitbox() {
         dimensions.width,
         dimensions.height
     };
+
+    Level::EntityMoved(this);
 }
 
 void MovingPlatform::updateAngle() {
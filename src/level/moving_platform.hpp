@@ -48,11 +48,13 @@ public:
     MovingPlatformAnchor startAnchor, endAnchor;
 
     // So other entities can move together with this platform
-    Vector2 lastFrameTrajectory;
+    Vector2 lastFrameTrajectory = { 0, 0 };
 
 
     MovingPlatform() : Level::Entity(), startAnchor(this, GREEN), endAnchor(this, RED) {};
 
+    ~MovingPlatform();
+
     static MovingPlatform *AddFromPersistence();
 
     static MovingPlatform *Add(Vector2 startPos, Vector2 endPos, int size);
@@ -66,10 +68,25 @@ public:
 
     void Tick() override;
 
+    bool IsTickable() override { return true; }
+
+    // Its position is a function of the level's tick count, so it can skip ticks while asleep
+    Level::SleepPolicy GetSleepPolicy() override { return Level::SLEEP_ANALYTIC; }
+
+    // The whole track, so it wakes when any part of its path gets close
+    Rectangle GetActivationArea() override;
+
+    void Wake() override;
+
+    void HashMotionState(uint32_t *hash) override;
+
+    // The track and the anchors, drawn along with the platform
+    Rectangle GetDrawArea() override;
+
     void Draw() override;
 
-    std::string PersistanceSerialize() override;
-    void PersistenceParse(const std::string &data) override;
+    void PersistanceSerialize(std::string *line) override;
+    bool PersistenceParse(const PersistenceFields &fields) override;
 
 private:
 
@@ -77,6 +94,9 @@ private:
     int size; // In blocks
     float angle; // In radians
 
+    // The level tick when the platform was last at its start anchor, from where its position is calculated
+    unsigned long int trackStartTick;
+
 
     // Resizes platform (in blocks)
     void setSize(int size);
@@ -84,6 +104,9 @@ private:
     // Moves platform to a new position
     void movePlatformTo(Vector2 newPos);
 
+    // Moves the platform to where it is in the track at a given level tick
+    void movePlatformToTick(unsigned long int tick);
+
     // Updates platform hitbox based on size and currentPoint 
     void updateHitbox();
 
@@ -93,3 +93,7 @@ void INpc::Reset() {
     Level::Entity::Reset();
     isFalling = true;
 }
+
+void INpc::HashMotionState(uint32_t *hash) {
+    Level::StateHashAdd(hash, isFalling);
+}
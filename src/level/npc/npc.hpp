@@ -20,8 +20,12 @@ public:
 
     virtual void Tick() override;
 
+    bool IsTickable() override { return true; }
+
     virtual void Reset() override;
 
+    void HashMotionState(uint32_t *hash) override;
+
 private:
 
     // Defines the different NPC types and which add function to use for each of them
@@ -8,7 +8,7 @@ Princess *Princess::AddFromPersistence() {
 
 Princess *Princess::Add(Vector2 pos) {
     
-    Princess *newPrincess = new Princess();
+    Princess *newPrincess = Level::EntityNew<Princess>();
 
     Sprite *sprite = &SPRITES->PrincessDefault1;
     Rectangle hitbox = SpriteHitboxFromEdge(sprite, pos);
@@ -24,7 +24,7 @@ Princess *Princess::Add(Vector2 pos) {
 
     newPrincess->isFalling = true;
 
-    LinkedList::AddNode(&Level::STATE->listHead, newPrincess);
+    Level::EntityAdd(newPrincess);
 
     TraceLog(LOG_TRACE, "Added princess to level (x=%.1f, y=%.1f)",
                 newPrincess->hitbox.x, newPrincess->hitbox.y);
@@ -113,9 +113,8 @@ Player *Player::AddFromPersistence() {
 
 Player *Player::Initialize(Vector2 origin) {
 
-    Player *newPlayer = new Player();
+    Player *newPlayer = Level::EntityNew<Player>();
     PLAYER = newPlayer;
-    LinkedList::AddNode(&Level::STATE->listHead, newPlayer);
  
     newPlayer->tags = Level::IS_PLAYER +
                         Level::IS_PERSISTABLE;
@@ -133,6 +132,7 @@ Player *Player::Initialize(Vector2 origin) {
 
     newPlayer->initializeAnimationSystem();
 
+    Level::EntityAdd(newPlayer);
 
     TraceLog(LOG_TRACE, "Added player to level (x=%.1f, y=%.1f)",
                 newPlayer->hitbox.x, newPlayer->hitbox.y);
@@ -154,6 +154,7 @@ void Player::CheckAndSetOrigin(Vector2 pos) {
     }
 
     origin = { newHitbox.x, newHitbox.y };
+    Level::EntityMoved(this);
 
     TraceLog(LOG_DEBUG, "Player's origin set to x=%.1f, y=%.1f.", origin.x, origin.y);
 }
@@ -172,6 +173,7 @@ void Player::CheckAndSetPos(Vector2 pos) {
     }
     
     SetHitbox(newHitbox);
+    Level::EntitySnap(this);
 
     TraceLog(LOG_DEBUG, "Player set to pos x=%.1f, y=%.1f.", newHitbox.x, newHitbox.y);
 }
@@ -181,6 +183,7 @@ void Player::SetHitbox(Rectangle newHitbox) {
     SetHitboxPos({ newHitbox.x, newHitbox.y });
     this->hitbox = newHitbox;
 
+    Level::EntityMoved(this);
 }
 
 void Player::SetHitboxPos(Vector2 pos) {
@@ -207,6 +210,8 @@ void Player::SetHitboxPos(Vector2 pos) {
         hitbox.width + 2,
         hitbox.height * (1 - PLAYERS_UPPERBODY_PROPORTION) + 1
     };
+
+    Level::EntityMoved(this);
 }
 
 void Player::SetMode(PlayerMode newMode) {
@@ -218,7 +223,9 @@ void Player::SetMode(PlayerMode newMode) {
 
 void Player::InputJump() {
 
-    if (hookLaunched && hookLaunched->attachedTo) {
+    GrapplingHook *hook = LaunchedHook();
+
+    if (hook && hook->IsAttached()) {
         
         jump(false);
 
@@ -226,13 +233,13 @@ void Player::InputJump() {
         //  Horizontal velocity calculation
 
         float newXVel = 0;
-        const float angularVel = hookLaunched->angularVelocity;
+        const float angularVel = hook->angularVelocity;
 
         if (isFacingRight && angularVel > 0) { // facing + swinging to the right
-            newXVel = HOOK_JUMP_X_VELOCITY_BASE * sin(hookLaunched->currentAngle + PI);
+            newXVel = HOOK_JUMP_X_VELOCITY_BASE * sin(hook->currentAngle + PI);
         }
         else if (!isFacingRight && angularVel < 0) { // facing + swinging to the left
-            newXVel = HOOK_JUMP_X_VELOCITY_BASE * sin(hookLaunched->currentAngle + PI) * -1;
+            newXVel = HOOK_JUMP_X_VELOCITY_BASE * sin(hook->currentAngle + PI) * -1;
         }
 
         // if the player is holding the direction they're facing
@@ -246,7 +253,7 @@ void Player::InputJump() {
         xVelocity = newXVel;
         
 
-        delete hookLaunched;
+        destroyLaunchedHook();
         
         return;
     }
@@ -254,7 +261,7 @@ void Player::InputJump() {
 
     // Normal jump from the ground 
 
-    lastPressedJump = GetTime();
+    lastPressedJump = Level::ElapsedTime();
 }
 
 void Player::Tick() {
@@ -267,14 +274,14 @@ void Player::Tick() {
     double now;
     const float oldX = hitbox.x;
     const float oldY = hitbox.y;
-    const bool isHooked = hookLaunched && hookLaunched->attachedTo;
+    GrapplingHook *hook = LaunchedHook();
+    const bool isHooked = hook && hook->IsAttached();
     bool changedFacingSide = false;
 
 
     if (isHooked) {
 
         //      Hooked!!
-        const auto hook = hookLaunched;
 
         // Uses its own system for player's pos calculation
         xVelocity = 0;
@@ -328,10 +335,7 @@ void Player::Tick() {
         isFacingRight = false;
     }
 
-    if (changedFacingSide && hookLaunched && !hookLaunched->attachedTo) {
-        delete hookLaunched;
-        hookLaunched = 0;
-    }
+    if (changedFacingSide && hook && !hook->IsAttached()) destroyLaunchedHook();
 
 
     groundBeneath = Level::GetGroundBeneath(PLAYER);
@@ -382,7 +386,7 @@ END_HORIZONTAL_VELOCITY_CALCULATION:
 
     if (groundBeneath) {
 
-        lastGroundBeneathTime = GetTime();
+        lastGroundBeneathTime = Level::ElapsedTime();
         lastGroundBeneath = groundBeneath;
 
         if (!isAscending) {
@@ -406,7 +410,7 @@ END_HORIZONTAL_VELOCITY_CALCULATION:
         }
     }
 
-    now = GetTime();
+    now = Level::ElapsedTime();
     if (!isAscending &&
         (now - lastPressedJump < jumpBufferBackwardsSize()) &&
         (now - lastGroundBeneathTime < JUMP_BUFFER_FORWARDS_SIZE)) {
@@ -417,7 +421,7 @@ END_HORIZONTAL_VELOCITY_CALCULATION:
 
             jump(true);
 
-            lastGroundBeneathTime = GetTime();
+            lastGroundBeneathTime = Level::ElapsedTime();
             ((Enemy *)lastGroundBeneath)->Kill();
             lastGroundBeneath = 0;
         }
@@ -441,24 +445,31 @@ COLISION_CHECKING:
             return;
         }
 
-        Level::Entity *entity = (Level::Entity *) Level::STATE->listHead;
+        // Where the player was and is, and a cell around it for the ground beneath, as the hitbox
+        // can go back to where it was while colliding. A copy, as collisions can make other queries.
+        const Dimensions grid = LEVEL_GRID;
+        Rectangle area = RectanglesUnion(RectanglesUnion(hitbox, { oldX, oldY, hitbox.width, hitbox.height }),
+                                            RectanglesUnion(upperbody, lowerbody));
+        area = { area.x - grid.width, area.y - grid.height, area.width + grid.width * 2, area.height + grid.height * 2 };
+
+        nearbyEntities = Level::EntitiesNear(area);
 
-        while (entity != 0) {
+        for (Level::Entity *entity : nearbyEntities) {
 
             if ((entity->tags & Level::IS_ENEMY) && !entity->isDead) {
 
                 // Enemy hit player
-                if (CheckCollisionRecs(entity->hitbox, upperbody)) {
+                if (RectanglesCollide(entity->hitbox, upperbody)) {
                     die();
                     break;
                 }
 
                 // Player hit enemy
-                if (CheckCollisionRecs(entity->hitbox, lowerbody)) {
-                    lastGroundBeneathTime = GetTime();
+                if (RectanglesCollide(entity->hitbox, lowerbody)) {
+                    lastGroundBeneathTime = Level::ElapsedTime();
                     lastGroundBeneath = entity;
                     ((Enemy *)entity)->Kill();
-                    goto next_entity;
+                    continue;
                 }
             }
 
@@ -466,7 +477,7 @@ COLISION_CHECKING:
 
                 // Check for collision with level geometry
 
-                Rectangle collisionRec = GetCollisionRec(entity->hitbox, hitbox);
+                Rectangle collisionRec = RectanglesOverlap(entity->hitbox, hitbox);
 
                 if (entity->tags & Level::IS_GEOMETRY_DANGER &&
                     (collisionRec.width > 0 || collisionRec.height > 0 || groundBeneath == entity)) {
@@ -476,7 +487,7 @@ COLISION_CHECKING:
                     break;
                 }
 
-                if (collisionRec.width == 0 || collisionRec.height == 0) goto next_entity;
+                if (collisionRec.width == 0 || collisionRec.height == 0) continue;
             
                 const bool isAWall = collisionRec.width <= collisionRec.height;
                 const bool isACeiling = (collisionRec.width >= collisionRec.height) &&
@@ -504,7 +515,7 @@ COLISION_CHECKING:
 
                         hitbox.x = oldX;
 
-                        if (isHooked) hookLaunched->angularVelocity *= -1;
+                        if (isHooked) hook->angularVelocity *= -1;
 
                     }
                 }
@@ -519,14 +530,14 @@ COLISION_CHECKING:
                     yVelocity = (yVelocity * -1) * CEILING_VELOCITY_FACTOR;
                     yVelocityTarget = DOWNWARDS_VELOCITY_TARGET;
 
-                    if (isHooked) hookLaunched->angularVelocity *= -1;
+                    if (isHooked) hook->angularVelocity *= -1;
                 }
 
                 // TODO maybe ground check should be here as well
             }
 
             else if (entity->tags & Level::IS_EXIT &&
-                        CheckCollisionRecs(entity->hitbox, hitbox)) {
+                        RectanglesCollide(entity->hitbox, hitbox)) {
 
                 // Player exit level
 
@@ -534,21 +545,21 @@ COLISION_CHECKING:
             }
 
             else if (entity->tags & Level::IS_GLIDE_PICKUP &&
-                        CheckCollisionRecs(entity->hitbox, hitbox) &&
+                        RectanglesCollide(entity->hitbox, hitbox) &&
                         mode != PLAYER_MODE_GLIDE) {
                 SetMode(PLAYER_MODE_GLIDE);
                 return;
             }
 
             else if (entity->tags & Level::IS_TEXTBOX &&
-                        CheckCollisionRecs(entity->hitbox, hitbox)) {
+                        RectanglesCollide(entity->hitbox, hitbox)) {
 
                 textboxCollidedThisFrame = (Textbox *) entity;
             }
 
             else if (entity->tags & Level::IS_CHECKPOINT_PICKUP &&
                         !((CheckpointPickup *) entity)->wasPickedUp &&
-                        CheckCollisionRecs(entity->hitbox, hitbox)) {
+                        RectanglesCollide(entity->hitbox, hitbox)) {
 
                 // Picked up a checkpoint
                 Level::STATE->checkpointsLeft++;
@@ -558,13 +569,11 @@ COLISION_CHECKING:
             else if (entity->tags & Level::IS_COIN) {
 
                 auto coin = (Coin *) entity;
-                if (!coin->wasPickedUp && CheckCollisionRecs(entity->hitbox, hitbox)) {
+                if (!coin->wasPickedUp && RectanglesCollide(entity->hitbox, hitbox)) {
                     coin->PickUp();
                 }
             }
 
-next_entity:
-            entity = (Level::Entity *)  entity->next;
         }
     }
 
@@ -587,7 +596,7 @@ next_entity:
         }
     }
 
-    if (isHooked) hookLaunched->FollowPlayer();
+    if (isHooked) hook->FollowPlayer();
 
     if (groundBeneath && groundBeneath->tags & Level::IS_MOVING_PLATFORM) {
         Vector2 trajectory = ((MovingPlatform *)groundBeneath)->lastFrameTrajectory;
@@ -615,9 +624,9 @@ void Player::Reset() {
 
     Level::Entity::Reset();
 
-    if (Level::STATE->checkpoint) {
-        Vector2 pos = RectangleGetPos(Level::STATE->checkpoint->hitbox);
-        pos.y -= Level::STATE->checkpoint->hitbox.height;
+    if (Level::Entity *checkpoint = Level::EntityGet(Level::STATE->checkpoint)) {
+        Vector2 pos = RectangleGetPos(checkpoint->hitbox);
+        pos.y -= checkpoint->hitbox.height;
         SetHitboxPos(pos);
     } else {
         SetHitboxPos(origin);
@@ -632,7 +641,21 @@ void Player::Reset() {
     lastGroundBeneath = nullptr;
     textboxCollidedLastFrame = nullptr;
 
-    if (hookLaunched) delete hookLaunched;
+    destroyLaunchedHook();
+}
+
+void Player::HashMotionState(uint32_t *hash) {
+
+    Level::StateHashAdd(hash, xVelocity);
+    Level::StateHashAdd(hash, yVelocity);
+    Level::StateHashAdd(hash, yVelocityTarget);
+    Level::StateHashAdd(hash, isAscending);
+    Level::StateHashAdd(hash, isGliding);
+    Level::StateHashAdd(hash, isSkidding);
+    Level::StateHashAdd(hash, wasRunningOnJumpStart);
+    Level::StateHashAdd(hash, mode);
+    Level::StateHashAdd(hash, lastPressedJump);
+    Level::StateHashAdd(hash, lastGroundBeneathTime);
 }
 
 void Player::SetCheckpoint() {
@@ -647,13 +670,13 @@ void Player::SetCheckpoint() {
         return;
     }
 
-    if (Level::STATE->checkpoint) {
-        Level::EntityDestroy(Level::STATE->checkpoint);
+    if (Level::Entity *checkpoint = Level::EntityGet(Level::STATE->checkpoint)) {
+        Level::EntityDestroy(checkpoint);
     }
 
     Vector2 pos = RectangleGetPos(hitbox);
     pos.y += hitbox.height / 2;
-    Level::STATE->checkpoint = Level::CheckpointFlagAdd(pos);
+    Level::STATE->checkpoint = Level::CheckpointFlagAdd(pos)->handle;
 
     Level::STATE->checkpointsLeft--;
 
@@ -662,12 +685,23 @@ void Player::SetCheckpoint() {
 
 void Player::LaunchGrapplingHook() {
 
-    if (hookLaunched) {
-        delete hookLaunched;
+    if (LaunchedHook()) {
+        destroyLaunchedHook();
         return;
     }
 
-    hookLaunched = GrapplingHook::Initialize();
+    hookLaunched = GrapplingHook::Initialize()->handle;
+}
+
+GrapplingHook *Player::LaunchedHook() {
+    return (GrapplingHook *) Level::EntityGet(hookLaunched);
+}
+
+void Player::destroyLaunchedHook() {
+
+    if (GrapplingHook *hook = LaunchedHook()) Level::EntityDestroy(hook);
+
+    hookLaunched = Level::EntityHandle();
 }
 
 void Player::jump(bool isFromEnemy) {
@@ -682,7 +716,7 @@ void Player::jump(bool isFromEnemy) {
         if (yVelocity > 20) yVelocity = 20;
     }
 
-    Sounds::PlayEffect(&SOUNDS->Jump);
+    Sounds::PlayEffect(Sounds::SOUND_JUMP);
 }
 
 void Player::die() {
@@ -699,9 +733,10 @@ void Player::die() {
 float Player::jumpStartVelocity() {
 
     // Velocity if player's swinging from a hook
-    if (hookLaunched && hookLaunched->attachedTo) {
+    GrapplingHook *h = LaunchedHook();
+
+    if (h && h->IsAttached()) {
         
-        auto h = hookLaunched;
         float vel = HOOK_JUMP_Y_VELOCITY_BASE;
         bool isSwingingClockwise = h->angularVelocity >= 0;
         // where the hook start is in the cartesian plane
@@ -774,7 +809,9 @@ Animation::Animation *Player::getCurrentAnimation() {
     bool isModeGlide = mode == PLAYER_MODE_GLIDE;
 
 
-    if (PLAYER->hookLaunched && PLAYER->hookLaunched->attachedTo)
+    GrapplingHook *hook = PLAYER->LaunchedHook();
+
+    if (hook && hook->IsAttached())
         if (Input::STATE.playerMoveDirection != Input::PLAYER_DIRECTION_STOP)
             if ((Input::STATE.playerMoveDirection == Input::PLAYER_DIRECTION_RIGHT) == PLAYER->isFacingRight)
                 animation =             &animationSwingingForwards;
@@ -806,8 +843,11 @@ Animation::Animation *Player::getCurrentAnimation() {
     return animation;
 }
 
-void Player::PersistenceParse(const std::string &data) {
+bool Player::PersistenceParse(const PersistenceFields &fields) {
+
+    if (!Level::Entity::PersistenceParse(fields)) return false;
 
-    Level::Entity::PersistenceParse(data);
     SetHitboxPos(origin);
+
+    return true;
 }
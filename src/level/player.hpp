@@ -3,6 +3,7 @@
 
 
 #include <raylib.h>
+#include <vector>
 
 #include "level.hpp"
 #include "grappling_hook.hpp"
@@ -47,8 +48,8 @@ public:
     double lastGroundBeneathTime;
     Level::Entity *lastGroundBeneath;
 
-    // A reference to the launched grappling hook, if there's one  
-    GrapplingHook *hookLaunched;
+    // The launched grappling hook, if there's one. A handle, so a destroyed hook isn't referenced.
+    Level::EntityHandle hookLaunched;
 
     // A reference to the moving platform the player is on, if there's one
     Level::Entity *movingPlatformBeneath;
@@ -79,6 +80,10 @@ public:
 
     void Tick();
 
+    bool IsTickable() { return true; }
+
+    Level::SleepPolicy GetSleepPolicy() { return Level::SLEEP_NEVER; }
+
     void Draw() override;
 
     void Reset() override;
@@ -87,11 +92,22 @@ public:
 
     void LaunchGrapplingHook();
 
-    void PersistenceParse(const std::string &data) override;
+    // The launched grappling hook, or 0 if there's none
+    GrapplingHook *LaunchedHook();
+
+    bool PersistenceParse(const PersistenceFields &fields) override;
+
+    void HashMotionState(uint32_t *hash) override;
 
 
 private:
 
+    // The entities near the player, reused by the collision checks of every tick so they don't allocate
+    std::vector<Level::Entity *> nearbyEntities;
+
+    // Destroys the launched grappling hook, if there's one
+    void destroyLaunchedHook();
+
     static Animation::Animation animationInPlace;
     static Animation::Animation animationWalking;
     static Animation::Animation animationRunning;
@@ -21,7 +21,7 @@ Level::Entity *GlideAdd(Vector2 origin) {
 
     glide->entityTypeID = GLIDE_PICKUP_ENTITY_ID;
 
-    LinkedList::AddNode(&Level::STATE->listHead, glide);
+    Level::EntityAdd(glide);
 
     TraceLog(LOG_TRACE, "Added glide item to level (x=%.1f, y=%.1f)",
                 glide->hitbox.x, glide->hitbox.y);
@@ -0,0 +1,100 @@
+#include <raylib.h>
+#include <algorithm>
+
+#include "spatial_hash.hpp"
+#include "level.hpp"
+
+
+// A tile's hitbox touches 2x2 cells, as cell ranges include both ends, and its origin 2x2 more.
+// Most of them are shared with the neighbouring tiles.
+#define SPATIAL_HASH_LINKS_PER_ENTITY   8
+#define SPATIAL_HASH_CELLS_PER_ENTITY   2
+
+
+namespace Level {
+
+
+static Rectangle rectangleUnion(Rectangle a, Rectangle b) {
+
+    float x = std::min(a.x, b.x);
+    float y = std::min(a.y, b.y);
+
+    return {
+        x, y,
+        std::max(a.x + a.width, b.x + b.width) - x,
+        std::max(a.y + a.height, b.y + b.height) - y
+    };
+}
+
+// The area the entity's origin occupies. Some queries use the origin with the hitbox's dimensions,
+// others use GetOriginHitbox(), and these are not always the same (e.g. moving platforms), so it covers both.
+// It also covers whatever the entity draws outside of its hitbox, for culling.
+static Rectangle originArea(Entity *entity) {
+
+    Rectangle a = entity->GetOriginHitbox();
+    Rectangle b = { entity->origin.x, entity->origin.y, entity->hitbox.width, entity->hitbox.height };
+
+    return rectangleUnion(rectangleUnion(a, b), entity->GetDrawArea());
+}
+
+void SpatialHash::Add(Entity *entity) {
+
+    if (entity->isIndexed) return;
+
+    entity->indexedHitboxCells = CellRangeOf(entity->hitbox);
+    entity->indexedOriginCells = CellRangeOf(originArea(entity));
+
+    cells.Insert(entity, entity->indexedHitboxCells);
+    cells.Insert(entity, entity->indexedOriginCells);
+
+    entity->isIndexed = true;
+}
+
+void SpatialHash::Remove(Entity *entity) {
+
+    if (!entity->isIndexed) return;
+
+    cells.Erase(entity, entity->indexedHitboxCells);
+    cells.Erase(entity, entity->indexedOriginCells);
+
+    entity->isIndexed = false;
+}
+
+void SpatialHash::Update(Entity *entity) {
+
+    if (!entity->isIndexed) return;
+
+    CellRange hitboxCells = CellRangeOf(entity->hitbox);
+    CellRange originCells = CellRangeOf(originArea(entity));
+
+    if (!CellRangeEquals(hitboxCells, entity->indexedHitboxCells)) {
+        cells.Erase(entity, entity->indexedHitboxCells);
+        cells.Insert(entity, hitboxCells);
+        entity->indexedHitboxCells = hitboxCells;
+    }
+
+    if (!CellRangeEquals(originCells, entity->indexedOriginCells)) {
+        cells.Erase(entity, entity->indexedOriginCells);
+        cells.Insert(entity, originCells);
+        entity->indexedOriginCells = originCells;
+    }
+}
+
+void SpatialHash::Reserve(size_t entityCount) {
+    cells.Reserve(entityCount * SPATIAL_HASH_LINKS_PER_ENTITY, entityCount * SPATIAL_HASH_CELLS_PER_ENTITY);
+}
+
+void SpatialHash::Clear() {
+
+    cells.ForEach([](Entity *entity) { entity->isIndexed = false; });
+    cells.Clear();
+}
+
+const std::vector<Entity *> &SpatialHash::Query(Rectangle area) {
+
+    cells.Query(CellRangeOf(area), &queryResult);
+    return queryResult;
+}
+
+
+} // namespace
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+#include "cell_buckets.hpp"
+
+
+namespace Level {
+
+
+class Entity;
+
+
+/*
+    Buckets the level entities by the LEVEL_GRID cells their hitbox and origin touch,
+    so collision queries only have to look at the entities near the area being queried.
+*/
+class SpatialHash {
+
+public:
+
+    // Starts indexing an entity
+    void Add(Entity *entity);
+
+    // Stops indexing an entity. Does nothing if it's not indexed.
+    void Remove(Entity *entity);
+
+    // Re-indexes an entity, if its hitbox or origin changed cells since it was last indexed
+    void Update(Entity *entity);
+
+    // Stops indexing all entities
+    void Clear();
+
+    // Makes room for indexing this many entities, so indexing them doesn't allocate
+    void Reserve(size_t entityCount);
+
+    // Returns the indexed entities near an area, without repetitions, in the
+    // same order they were added to the level. Valid until the next query.
+    const std::vector<Entity *> &Query(Rectangle area);
+
+private:
+
+    CellBuckets cells;
+
+    // Reused between queries, so they don't allocate
+    std::vector<Entity *> queryResult;
+};
+
+
+} // namespace
@@ -31,7 +31,7 @@ Textbox *Textbox::AddFromPersistence() {
 
 Textbox *Textbox::Add(Vector2 pos, int textId) {
 
-    Textbox *newTextbox = new Textbox();
+    Textbox *newTextbox = Level::EntityNew<Textbox>();
 
     Sprite *sprite = &SPRITES->TextboxButton;
     Rectangle hitbox = SpriteHitboxFromEdge(sprite, pos);
@@ -49,7 +49,7 @@ Textbox *Textbox::Add(Vector2 pos, int textId) {
 
     newTextbox->initializeAnimationSystem();
 
-    LinkedList::AddNode(&Level::STATE->listHead, newTextbox);
+    Level::EntityAdd(newTextbox);
 
     TraceLog(LOG_TRACE, "Added textbox button to level (x=%.1f, y=%.1f)",
                 newTextbox->hitbox.x, newTextbox->hitbox.y);
@@ -110,9 +110,7 @@ void Textbox::Toggle() {
 
 void Textbox::ReloadAllLevelTexboxes() {
     
-    for (Level::Entity *e = (Level::Entity *) Level::STATE->listHead;
-        e != 0;
-        e = (Level::Entity *) e->next) {
+    for (Level::Entity *e : Level::ENTITIES) {
 
             if (e->tags & Level::IS_TEXTBOX) {
                 auto box = (Textbox *) e;
@@ -164,22 +162,27 @@ void Textbox::updateSprite() {
     }
 }
 
-std::string Textbox::PersistanceSerialize() {
+void Textbox::PersistanceSerialize(std::string *line) {
 
-    std::string data = Level::Entity::PersistanceSerialize();
-    persistanceAddValue(&data, "textId", std::to_string(textId));
-    persistanceAddValue(&data, "isDevTextbox", std::to_string((int) isDevTextbox));
-    return data;
+    Level::Entity::PersistanceSerialize(line);
+    persistanceAddValue(line, "textId", textId);
+    persistanceAddValue(line, "isDevTextbox", (int) isDevTextbox);
 }
 
-void Textbox::PersistenceParse(const std::string &data) {
+bool Textbox::PersistenceParse(const PersistenceFields &fields) {
+
+    int id, isDev;
+
+    if (!Level::Entity::PersistenceParse(fields) ||
+        !fields.ReadInt("textId", &id) ||
+        !fields.ReadInt("isDevTextbox", &isDev)) return false;
 
-    Level::Entity::PersistenceParse(data);
-    int id = std::stoi(persistenceReadValue(data, "textId"));
     SetTextId(id);
-    isDevTextbox = (bool) std::stoi(persistenceReadValue(data, "isDevTextbox"));
+    isDevTextbox = (bool) isDev;
 
     updateSprite();
+
+    return true;
 }
 
 void Textbox::createAnimations() {
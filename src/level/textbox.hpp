@@ -10,6 +10,8 @@
 
 #define TEXTBOX_BUTTON_ENTITY_ID       "textbox_button"
 
+#define TEXTBOX_FONT_SIZE              30
+
 
 class Textbox : public Level::Entity, private Animation::IAnimated {
 
@@ -49,10 +51,12 @@ public:
 
     void Tick() override;
 
+    bool IsTickable() override { return true; }
+
     void Draw() override;
 
-    void PersistenceParse(const std::string &data) override;
-    std::string PersistanceSerialize() override;
+    bool PersistenceParse(const PersistenceFields &fields) override;
+    void PersistanceSerialize(std::string *line) override;
 
 private:
 
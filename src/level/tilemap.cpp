@@ -0,0 +1,202 @@
+#include <raylib.h>
+#include <math.h>
+#include <algorithm>
+
+#include "tilemap.hpp"
+#include "level.hpp"
+
+
+namespace Level {
+
+
+// The cell the entity's hitbox is in, if it's exactly on the grid
+static bool tileCell(Entity *entity, int *x, int *y) {
+
+    const Dimensions grid = LEVEL_GRID;
+
+    *x = (int) floorf(entity->hitbox.x / grid.width);
+    *y = (int) floorf(entity->hitbox.y / grid.height);
+
+    return *x * grid.width == entity->hitbox.x && *y * grid.height == entity->hitbox.y;
+}
+
+static unsigned char tileRotation(Entity *entity) {
+    return ((entity->GetTileRotation() / 90) % 4 + 4) % 4;
+}
+
+// The first cell of the chunk with the cell, along one axis
+static int chunkStart(int cell) {
+    return cell - ((cell % TILEMAP_CHUNK_SIDE) + TILEMAP_CHUNK_SIDE) % TILEMAP_CHUNK_SIDE;
+}
+
+void Tilemap::Add(Entity *entity) {
+
+    // All tiles are grid-locked, and that's cheaper to check first
+    if (entity->isInTilemap || !(entity->tags & IS_GRIDLOCKED) || !entity->IsTile()) return;
+
+    int x, y;
+    if (!tileCell(entity, &x, &y)) return;
+
+    unsigned char tile = tileOf(entity->sprite);
+    if (!tile) return;
+
+    TilemapChunk *chunk = chunkAt(x, y, true);
+
+    TilemapCell &cell = cellAt(chunk, x, y);
+    if (cell.tile) return; // taken
+
+    cell.tile = tile;
+    cell.rotation = tileRotation(entity);
+    markDirty(chunk, x, y);
+
+    entity->isInTilemap = true;
+    entity->tilemapCellX = x;
+    entity->tilemapCellY = y;
+}
+
+void Tilemap::Remove(Entity *entity) {
+
+    if (!entity->isInTilemap) return;
+
+    entity->isInTilemap = false;
+
+    // The tilemap might have been cleared since
+    const int x = entity->tilemapCellX, y = entity->tilemapCellY;
+    TilemapChunk *chunk = chunkAt(x, y, false);
+    if (!chunk) return;
+
+    cellAt(chunk, x, y) = {};
+    markDirty(chunk, x, y);
+}
+
+void Tilemap::Update(Entity *entity) {
+
+    if (!entity->isInTilemap) {
+        Add(entity);
+        return;
+    }
+
+    int x, y;
+    bool isOnGrid = tileCell(entity, &x, &y);
+
+    if (isOnGrid && x == entity->tilemapCellX && y == entity->tilemapCellY) {
+
+        unsigned char tile = tileOf(entity->sprite);
+        TilemapChunk *chunk = chunkAt(x, y, true);
+        TilemapCell &cell = cellAt(chunk, x, y);
+
+        if (tile && cell.tile == tile && cell.rotation == tileRotation(entity)) return;
+
+        if (tile) {
+            cell.tile = tile;
+            cell.rotation = tileRotation(entity);
+            markDirty(chunk, x, y);
+            return;
+        }
+    }
+
+    Remove(entity);
+    Add(entity);
+}
+
+void Tilemap::Clear() {
+
+    chunks.clear();
+    chunkIndexes.clear();
+    lastChunk = -1;
+
+    tileSprites.clear();
+
+    wasCleared = true;
+    dirtyChunks.clear();
+}
+
+const std::vector<TilemapChunk> &Tilemap::Chunks() {
+    return chunks;
+}
+
+const std::vector<Sprite *> &Tilemap::TileSprites() {
+    return tileSprites;
+}
+
+bool Tilemap::WasCleared() {
+    return wasCleared;
+}
+
+const std::vector<int> &Tilemap::DirtyChunks() {
+    return dirtyChunks;
+}
+
+void Tilemap::ClearChanges() {
+
+    for (int index : dirtyChunks) chunks[index].isDirty = false;
+    dirtyChunks.clear();
+
+    wasCleared = false;
+}
+
+unsigned char Tilemap::tileOf(Sprite *sprite) {
+
+    for (size_t i = 0; i < tileSprites.size(); i++) {
+        if (tileSprites[i] == sprite) return i + 1;
+    }
+
+    if (tileSprites.size() >= TILEMAP_MAX_TILE_TYPES) return 0;
+
+    // The renderer samples a single atlas page
+    if (!tileSprites.empty() && sprite->atlas.id != tileSprites[0]->atlas.id) return 0;
+
+    tileSprites.push_back(sprite);
+
+    return tileSprites.size();
+}
+
+TilemapChunk *Tilemap::chunkAt(int x, int y, bool isAdding) {
+
+    const int chunkX = chunkStart(x);
+    const int chunkY = chunkStart(y);
+
+    if (lastChunk != -1 && chunks[lastChunk].x == chunkX && chunks[lastChunk].y == chunkY) return &chunks[lastChunk];
+
+    auto found = chunkIndexes.find(CellKey(chunkX, chunkY));
+
+    if (found != chunkIndexes.end()) {
+        lastChunk = found->second;
+    }
+    else {
+        if (!isAdding) return 0;
+
+        TilemapChunk chunk = {};
+        chunk.x = chunkX;
+        chunk.y = chunkY;
+        chunk.cells.resize(TILEMAP_CHUNK_SIDE * TILEMAP_CHUNK_SIDE, TilemapCell{});
+
+        lastChunk = chunks.size();
+        chunks.push_back(std::move(chunk));
+        chunkIndexes[CellKey(chunkX, chunkY)] = lastChunk;
+    }
+
+    return &chunks[lastChunk];
+}
+
+TilemapCell &Tilemap::cellAt(TilemapChunk *chunk, int x, int y) {
+    return chunk->cells[(y - chunk->y) * TILEMAP_CHUNK_SIDE + (x - chunk->x)];
+}
+
+void Tilemap::markDirty(TilemapChunk *chunk, int x, int y) {
+
+    if (!chunk->isDirty) {
+        chunk->dirtyCells = { x, y, x, y };
+        chunk->isDirty = true;
+        dirtyChunks.push_back(chunk - chunks.data());
+        return;
+    }
+
+    chunk->dirtyCells = {
+        std::min(chunk->dirtyCells.x0, x), std::min(chunk->dirtyCells.y0, y),
+        std::max(chunk->dirtyCells.x1, x), std::max(chunk->dirtyCells.y1, y)
+    };
+}
+
+
+} // namespace
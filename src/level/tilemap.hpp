@@ -0,0 +1,117 @@
+#pragma once
+
+#include <raylib.h>
+#include <unordered_map>
+#include <vector>
+
+#include "../sprites.hpp"
+#include "cell_buckets.hpp"
+
+
+// How many cells a side of a tilemap chunk has. It's the smallest max texture size GL allows,
+// so a chunk fits in a texture on any GPU.
+#define TILEMAP_CHUNK_SIDE      64
+
+// How many different tile sprites the tilemap can have. Tiles of other sprites draw themselves.
+#define TILEMAP_MAX_TILE_TYPES  16
+
+
+
+namespace Level {
+
+
+class Entity;
+
+
+// A tilemap cell, laid out as an RGBA pixel so the tilemap can be uploaded as a texture
+typedef struct TilemapCell {
+    unsigned char tile;     // Index in the tilemap's TileSprites() plus one, or 0 if there's no tile
+    unsigned char rotation; // In steps of 90 degrees, clockwise
+    unsigned char unused[2];
+} TilemapCell;
+
+// A square of TILEMAP_CHUNK_SIDE cells of the tilemap, the part of it a single texture holds
+typedef struct TilemapChunk {
+
+    // The first cell it covers, a multiple of TILEMAP_CHUNK_SIDE
+    int x, y;
+
+    // TILEMAP_CHUNK_SIDE * TILEMAP_CHUNK_SIDE cells, row by row
+    std::vector<TilemapCell> cells;
+
+    // If some cell changed since the tilemap's ClearChanges(), and which
+    bool isDirty;
+    CellRange dirtyCells;
+} TilemapChunk;
+
+
+/*
+    The level's static tiles (blocks and acid blocks) laid out in a grid of LEVEL_GRID cells,
+    so the renderer can draw all of them at once instead of one by one.
+
+    The cells are kept in fixed size chunks, only where there are tiles, so the memory and the
+    textures follow the number of tiles and not how far apart they are.
+
+    A tile in the tilemap has isInTilemap set, and doesn't draw itself. Tiles that can't be
+    in it (e.g. off the grid, or in an already taken cell) are left out, and draw themselves.
+*/
+class Tilemap {
+
+public:
+
+    // Puts the entity in the tilemap, if it's a tile and it fits
+    void Add(Entity *entity);
+
+    // Takes the entity out of the tilemap. Does nothing if it's not in it.
+    void Remove(Entity *entity);
+
+    // Re-reads the tile's cell, sprite and rotation, if they changed
+    void Update(Entity *entity);
+
+    // Takes all tiles out
+    void Clear();
+
+    // The chunks with tiles, or that had them. A chunk keeps its index until Clear(), and new ones are added at the end.
+    const std::vector<TilemapChunk> &Chunks();
+
+    // The sprites the cells' tile refer to. They're all in the same atlas page.
+    const std::vector<Sprite *> &TileSprites();
+
+    // If the chunks were dropped since ClearChanges(), in which case the ones in Chunks() are all new
+    bool WasCleared();
+
+    // The index of the chunks with cells that changed since ClearChanges()
+    const std::vector<int> &DirtyChunks();
+
+    // Called once the changes were picked up, i.e. uploaded
+    void ClearChanges();
+
+private:
+
+    std::vector<TilemapChunk> chunks;
+
+    // The index of each chunk in chunks, by CellKey() of its first cell
+    std::unordered_map<long long, int> chunkIndexes;
+
+    // The chunk the last cell looked up was in, as tiles are mostly added next to each other
+    int lastChunk = -1;
+
+    std::vector<Sprite *> tileSprites;
+
+    bool wasCleared = false;
+    std::vector<int> dirtyChunks;
+
+
+    // The tile value of a sprite, adding it to the tile sprites if needed. Returns 0 if it can't be added.
+    unsigned char tileOf(Sprite *sprite);
+
+    // The chunk with the cell, or 0 if there's none. Adds it if there's none and isAdding.
+    TilemapChunk *chunkAt(int x, int y, bool isAdding);
+
+    TilemapCell &cellAt(TilemapChunk *chunk, int x, int y);
+
+    void markDirty(TilemapChunk *chunk, int x, int y);
+};
+
+
+} // namespace
@@ -0,0 +1,151 @@
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "files.hpp"
+#include "persistence_binary.hpp"
+
+
+/*
+    Converts levels between the text and the binary formats, writing each next to the original,
+    with the other extension.
+
+        jogo_level_convert <level file>...
+
+    Or checks that every text level in the folder converts to binary and back to the very same file,
+    and that the binary converts back to the very same binary.
+
+        jogo_level_convert --check [levels folder]
+
+    The game saves levels as text, so the binary ones should be converted again after editing.
+*/
+
+
+#define DEFAULT_LEVELS_DIR      "../levels"
+#define TEXT_FILE_EXTENSION     ".lvl"
+
+
+// The path with the extension replaced
+static std::string withExtension(const char *path, const char *extension) {
+
+    std::string result = path;
+
+    size_t dot = result.rfind('.');
+    if (dot != std::string::npos && result.find('/', dot) == std::string::npos) result.resize(dot);
+
+    return result + extension;
+}
+
+static bool convert(const char *path) {
+
+    if (IsFileExtension(path, LEVEL_BINARY_FILE_EXTENSION)) {
+
+        Files::MappedFile file = Files::Map(path);
+        if (!file.data) return false;
+
+        std::string text;
+        bool converted = PersistenceBinaryToText(file.data, file.size, &text);
+        Files::Unmap(file);
+
+        if (!converted) return false;
+
+        std::string textPath = withExtension(path, TEXT_FILE_EXTENSION);
+        if (!Files::BinarySave(textPath, text)) return false;
+
+        printf("%s -> %s\n", path, textPath.c_str());
+        return true;
+    }
+
+    if (!FileExists(path)) {
+        fprintf(stderr, "File not found: %s\n", path);
+        return false;
+    }
+
+    std::string binary;
+    if (!PersistenceBinaryFromText(Files::TextLoad(path), &binary)) return false;
+
+    std::string binaryPath = withExtension(path, LEVEL_BINARY_FILE_EXTENSION);
+    if (!Files::BinarySave(binaryPath, binary)) return false;
+
+    printf("%s -> %s\n", path, binaryPath.c_str());
+    return true;
+}
+
+// Converts the text level to binary and back, reporting if anything changed
+static bool roundTrip(const char *path) {
+
+    std::string text = Files::TextLoad(path);
+    std::string binary, textAgain, binaryAgain;
+
+    if (!PersistenceBinaryFromText(text, &binary) ||
+        !PersistenceBinaryToText((const unsigned char *) binary.data(), binary.size(), &textAgain) ||
+        !PersistenceBinaryFromText(textAgain, &binaryAgain)) {
+
+        printf("FAILED     %s: could not convert\n", path);
+        return false;
+    }
+
+    if (textAgain != text) {
+
+        size_t diff = 0;
+        while (diff < text.size() && diff < textAgain.size() && text[diff] == textAgain[diff]) diff++;
+
+        printf("FAILED     %s: text differs from byte %zu\n", path, diff);
+        return false;
+    }
+
+    if (binaryAgain != binary) {
+        printf("FAILED     %s: binary differs\n", path);
+        return false;
+    }
+
+    printf("OK         %s: %zu bytes as text, %zu as binary (%.0f%%)\n", path, text.size(), binary.size(),
+            100.0 * binary.size() / text.size());
+    return true;
+}
+
+static int check(const char *dir) {
+
+    FilePathList files = LoadDirectoryFilesEx(dir, TEXT_FILE_EXTENSION, false);
+
+    if (!files.count) {
+        fprintf(stderr, "No levels in %s\n", dir);
+        UnloadDirectoryFiles(files);
+        return 1;
+    }
+
+    unsigned int failed = 0;
+    for (unsigned int i = 0; i < files.count; i++) {
+        if (!roundTrip(files.paths[i])) failed++;
+    }
+
+    printf("%u of %u levels round tripped\n", files.count - failed, files.count);
+
+    UnloadDirectoryFiles(files);
+
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <level file>...\n"
+                        "       %s --check [levels folder]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    if (strcmp(argv[1], "--check") == 0) return check(argc > 2 ? argv[2] : DEFAULT_LEVELS_DIR);
+
+    int failed = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!convert(argv[i])) {
+            fprintf(stderr, "Could not convert %s\n", argv[i]);
+            failed++;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
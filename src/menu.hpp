@@ -3,9 +3,6 @@
 #include <string>
 #include <vector>
 
-#include <raylib.h>
-
-#include "render.hpp"
 
 
 class MenuItem {
@@ -22,7 +19,8 @@ public:
 
     void Select();
 
-    virtual void Draw(Vector2 pos);
+    // The text the item is shown with
+    virtual std::string Text();
 
 private:
 
@@ -38,7 +36,7 @@ public:
     MenuItemToggle(std::string label, void (*callback)(), bool (*isToggledMonitor)()) :
                         MenuItem(label, callback), isToggledMonitor(isToggledMonitor) {}
 
-    void Draw(Vector2 pos) override;
+    std::string Text() override;
 
 private:
 
@@ -62,7 +60,9 @@ public:
 
     void Down();
 
-    void Draw();
+    const std::vector<MenuItem*> &Items();
+
+    int ItemHighlighted();
 
 private:
 
@@ -72,3 +72,8 @@ private:
     int itemHighlighted;
 
 };
+
+
+// Adds the sound and video settings to a menu. Called by the simulation, and
+// stubbed by the headless runner, which has neither.
+void MenuAddSettingsItems(Menu *menu);
@@ -1,9 +1,10 @@
 #include <raylib.h>
 #include <stdlib.h>
+#include <algorithm>
 
 #include "overworld.hpp"
 #include "core.hpp"
-#include "assets.hpp"
+#include "sprites.hpp"
 #include "camera.hpp"
 #include "render.hpp"
 #include "persistence.hpp"
@@ -22,6 +23,9 @@ static double levelSelectedAgo = -1;
 // The name of the selected level
 static char *levelSelectedName = 0;
 
+// The name of the last level prefetched under the cursor
+static char *levelPrefetchedName = 0;
+
 
 static void initializeOverworldState() {
 
@@ -169,7 +173,7 @@ OverworldEntity *OverworldEntityGetAt(Vector2 pos) {
 
     while (entity != 0) {
 
-        if (CheckCollisionPointRec(pos, OverworldEntitySquare(entity))) {
+        if (PointInRectangle(pos, OverworldEntitySquare(entity))) {
 
                 return entity;
             }
@@ -202,7 +206,7 @@ void OverworldLevelSelect() {
     Render::LevelTransitionEffectStart(
         SpritePosMiddlePoint(OW_CURSOR->gridPos, OW_CURSOR->sprite), true);
 
-    levelSelectedAgo = GetTime();
+    levelSelectedAgo = GetSimulationTime();
     levelSelectedName = OW_STATE->tileUnderCursor->levelName;
 }
 
@@ -361,10 +365,10 @@ void OverworldTileRemoveAt(Vector2 pos) {
         return;
     }
 
-    bool isPartOfSelection = std::find(EDITOR_STATE->selectedEntities.begin(), EDITOR_STATE->selectedEntities.end(), entity) != EDITOR_STATE->selectedEntities.end();
+    bool isPartOfSelection = std::find(EDITOR_STATE->selectedOverworldEntities.begin(), EDITOR_STATE->selectedOverworldEntities.end(), entity) != EDITOR_STATE->selectedOverworldEntities.end();
     if (isPartOfSelection) {
 
-        for (auto e = EDITOR_STATE->selectedEntities.begin(); e < EDITOR_STATE->selectedEntities.end(); e++) {
+        for (auto e = EDITOR_STATE->selectedOverworldEntities.begin(); e < EDITOR_STATE->selectedOverworldEntities.end(); e++) {
             checkAndRemoveTile((OverworldEntity *) *e);
         }
 
@@ -389,7 +393,7 @@ OverworldEntity *OverworldCheckCollisionWithAnyTileExcept(Rectangle hitbox, std:
 
         if (entity->tileType == OW_NOT_TILE) goto next_entity;
 
-        if (!CheckCollisionRecs(hitbox, OverworldEntitySquare(entity))) goto next_entity;
+        if (!RectanglesCollide(hitbox, OverworldEntitySquare(entity))) goto next_entity;
 
         for (auto e = entitiesToIgnore.begin(); e < entitiesToIgnore.end(); e++) {
             if (*e == entity) goto next_entity;
@@ -404,6 +408,18 @@ next_entity:
     return 0;
 }
 
+// Starts reading the level under the cursor, so it's ready if it's entered
+static void prefetchLevelUnderCursor() {
+
+    OverworldEntity *tile = OW_STATE->tileUnderCursor;
+    if (!tile || !(tile->tags & OW_IS_LEVEL_DOT)) return;
+
+    if (!tile->levelName || !tile->levelName[0] || tile->levelName == levelPrefetchedName) return;
+
+    levelPrefetchedName = tile->levelName;
+    PersistenceLevelPrefetch(levelPrefetchedName);
+}
+
 void OverworldTick() {
 
     if (GAME_STATE->waitingForTextInput) return;
@@ -411,18 +427,21 @@ void OverworldTick() {
     // TODO check if having the first check before saves on processing,
     // of if it's just redundant. 
     if (levelSelectedAgo != -1 &&
-        GetTime() - levelSelectedAgo > LEVEL_TRANSITION_ANIMATION_DURATION) {
+        GetSimulationTime() - levelSelectedAgo > LEVEL_TRANSITION_ANIMATION_DURATION) {
 
         Level::Load(levelSelectedName);
 
         levelSelectedAgo = -1;
         levelSelectedName = 0;
+        levelPrefetchedName = 0;
 
         return;
     }
 
     updateCursorPosition();
 
+    prefetchLevelUnderCursor();
+
     CameraTick();    
 }
 
@@ -3,7 +3,7 @@
 
 #include <vector>
 
-#include "assets.hpp"
+#include "sprites.hpp"
 #include "linked_list.hpp"
 #include "persistence.hpp"
 #include "core.hpp"
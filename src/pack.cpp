@@ -0,0 +1,322 @@
+#include <raylib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "pack.hpp"
+#include "files.hpp"
+
+
+#define PACK_MAGIC              "JPAK"
+#define PACK_MAGIC_SIZE         4
+
+#define PACK_DATA_ALIGNMENT     16
+
+
+namespace Pack {
+
+
+typedef struct PackHeader {
+    char magic[PACK_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t entriesOffset;
+} PackHeader;
+
+typedef struct PackEntry {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t dataOffset;
+    uint32_t dataSize;
+    uint32_t checksum;
+} PackEntry;
+
+
+static Files::MappedFile file = { 0, 0 };
+
+// The data of each file, by its name. Guarded by the mutex, as levels are prefetched in another thread.
+static std::unordered_map<std::string_view, std::string_view> index;
+static std::mutex indexMutex;
+
+
+static void installFileCallbacks();
+static void removeFileCallbacks();
+
+
+unsigned int Checksum(std::string_view data) {
+
+    static uint32_t table[256];
+    static bool hasTable = false;
+
+    if (!hasTable) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++) value = (value & 1) ? 0xedb88320 ^ (value >> 1) : value >> 1;
+            table[i] = value;
+        }
+        hasTable = true;
+    }
+
+    uint32_t crc = 0xffffffff;
+    for (unsigned char byte : data) crc = table[(crc ^ byte) & 0xff] ^ (crc >> 8);
+
+    return crc ^ 0xffffffff;
+}
+
+// If the range is inside the pack, without overflowing
+static bool inBounds(uint64_t offset, uint64_t size) {
+    return offset <= file.size && size <= file.size - offset;
+}
+
+bool Open(const char *path) {
+
+    Close();
+
+    file = Files::Map(path);
+    if (!file.data) return false;
+
+    PackHeader header;
+    if (file.size >= sizeof(header)) memcpy(&header, file.data, sizeof(header));
+
+    if (file.size < sizeof(header) || memcmp(header.magic, PACK_MAGIC, PACK_MAGIC_SIZE) != 0) {
+        TraceLog(LOG_ERROR, "File %s is not a pack.", path);
+        Close();
+        return false;
+    }
+
+    if (header.version != PACK_VERSION) {
+        TraceLog(LOG_ERROR, "Pack %s has version %u, but only %d is supported.", path, header.version, PACK_VERSION);
+        Close();
+        return false;
+    }
+
+    if (!inBounds(header.entriesOffset, (uint64_t) header.entryCount * sizeof(PackEntry))) {
+        TraceLog(LOG_ERROR, "Pack %s has its table of contents out of the file.", path);
+        Close();
+        return false;
+    }
+
+    int corrupted = 0;
+
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+
+        PackEntry entry;
+        memcpy(&entry, file.data + header.entriesOffset + i * sizeof(PackEntry), sizeof(PackEntry));
+
+        if (!inBounds(entry.nameOffset, entry.nameLength) || !inBounds(entry.dataOffset, entry.dataSize)) {
+            TraceLog(LOG_ERROR, "Pack %s has file %u out of the pack.", path, i);
+            corrupted++;
+            continue;
+        }
+
+        std::string_view name((const char *) file.data + entry.nameOffset, entry.nameLength);
+        std::string_view data((const char *) file.data + entry.dataOffset, entry.dataSize);
+
+        if (Checksum(data) != entry.checksum) {
+            TraceLog(LOG_ERROR, "Pack %s has file %.*s corrupted, it'll be read from the disk.", path,
+                        (int) name.size(), name.data());
+            corrupted++;
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(indexMutex);
+        index[name] = data;
+    }
+
+    installFileCallbacks();
+
+    TraceLog(LOG_INFO, "Pack %s opened, %d files (%d corrupted).", path, (int) index.size(), corrupted);
+
+    return true;
+}
+
+void Close() {
+
+    if (!file.data) return;
+
+    removeFileCallbacks();
+
+    {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        index.clear();
+    }
+
+    Files::Unmap(file);
+    file = { 0, 0 };
+}
+
+bool IsOpen() {
+    return file.data != 0;
+}
+
+// The name in the pack of a file the game reads, or an empty name if it's out of the packed folders
+static std::string_view nameInPack(std::string_view path) {
+
+    if (!path.starts_with(PACK_ROOT)) return std::string_view();
+
+    return path.substr(sizeof(PACK_ROOT) - 1);
+}
+
+bool Find(std::string_view path, std::string_view *data) {
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+
+    if (index.empty()) return false;
+
+    auto found = index.find(nameInPack(path));
+    if (found == index.end()) return false;
+
+    *data = found->second;
+    return true;
+}
+
+void Drop(std::string_view path) {
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    index.erase(nameInPack(path));
+}
+
+int Count() {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    return index.size();
+}
+
+std::vector<std::string_view> Names() {
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+
+    std::vector<std::string_view> names;
+    names.reserve(index.size());
+
+    for (auto &entry : index) names.push_back(entry.first);
+
+    std::sort(names.begin(), names.end());
+
+    return names;
+}
+
+bool Write(const char *path, const std::vector<PackFile> &files) {
+
+    PackHeader header = {};
+    memcpy(header.magic, PACK_MAGIC, PACK_MAGIC_SIZE);
+    header.version = PACK_VERSION;
+    header.entryCount = files.size();
+    header.entriesOffset = sizeof(PackHeader);
+
+    std::vector<PackEntry> entries(files.size());
+
+    // The names right after the table of contents, then the data
+    uint64_t offset = header.entriesOffset + files.size() * sizeof(PackEntry);
+
+    for (size_t i = 0; i < files.size(); i++) {
+        entries[i].nameOffset = offset;
+        entries[i].nameLength = files[i].name.size();
+        offset += files[i].name.size();
+    }
+
+    for (size_t i = 0; i < files.size(); i++) {
+        offset = (offset + PACK_DATA_ALIGNMENT - 1) / PACK_DATA_ALIGNMENT * PACK_DATA_ALIGNMENT;
+        entries[i].dataOffset = offset;
+        entries[i].dataSize = files[i].data.size();
+        entries[i].checksum = Checksum(files[i].data);
+        offset += files[i].data.size();
+    }
+
+    if (offset > UINT32_MAX) {
+        TraceLog(LOG_ERROR, "Pack %s would be too big (%llu bytes).", path, (unsigned long long) offset);
+        return false;
+    }
+
+    std::string pack;
+    pack.reserve(offset);
+
+    pack.append((const char *) &header, sizeof(header));
+    pack.append((const char *) entries.data(), entries.size() * sizeof(PackEntry));
+
+    for (const PackFile &packed : files) pack += packed.name;
+
+    for (size_t i = 0; i < files.size(); i++) {
+        pack.resize(entries[i].dataOffset, '\0');
+        pack += files[i].data;
+    }
+
+    return Files::BinarySave(path, pack);
+}
+
+
+/*
+    raylib reads the assets through these, so they come from the pack when it has them.
+    What raylib loads is freed by it, so the data is copied into memory it can free.
+*/
+
+static unsigned char *readFromDisk(const char *fileName, int *dataSize, bool isText) {
+
+    *dataSize = 0;
+
+    FILE *diskFile = fopen(fileName, "rb");
+    if (!diskFile) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", fileName);
+        return 0;
+    }
+
+    fseek(diskFile, 0, SEEK_END);
+    long size = ftell(diskFile);
+    fseek(diskFile, 0, SEEK_SET);
+
+    if (size < 0) {
+        fclose(diskFile);
+        return 0;
+    }
+
+    unsigned char *data = (unsigned char *) MemAlloc(size + (isText ? 1 : 0));
+    *dataSize = fread(data, 1, size, diskFile);
+
+    fclose(diskFile);
+
+    return data;
+}
+
+static unsigned char *loadFileData(const char *fileName, int *dataSize) {
+
+    std::string_view packed;
+    if (!Find(fileName, &packed)) return readFromDisk(fileName, dataSize, false);
+
+    unsigned char *data = (unsigned char *) MemAlloc(packed.size());
+    memcpy(data, packed.data(), packed.size());
+    *dataSize = packed.size();
+
+    return data;
+}
+
+static char *loadFileText(const char *fileName) {
+
+    std::string_view packed;
+    int size;
+
+    if (!Find(fileName, &packed)) return (char *) readFromDisk(fileName, &size, true);
+
+    // MemAlloc() zeroes the memory, so the text is terminated
+    char *text = (char *) MemAlloc(packed.size() + 1);
+    memcpy(text, packed.data(), packed.size());
+
+    return text;
+}
+
+static void installFileCallbacks() {
+
+    SetLoadFileDataCallback(loadFileData);
+    SetLoadFileTextCallback(loadFileText);
+}
+
+static void removeFileCallbacks() {
+
+    SetLoadFileDataCallback(0);
+    SetLoadFileTextCallback(0);
+}
+
+
+} // namespace
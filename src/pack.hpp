@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+#define PACK_FILE_EXTENSION     ".pack"
+
+// Bumped whenever the layout of the pack changes
+#define PACK_VERSION            1
+
+// Where the folders packed are, relative to the working directory. Names in the pack are relative to it.
+#define PACK_ROOT               "../"
+
+
+/*
+    A single file bundling the game's files (levels, the overworld, the text bank and, optionally,
+    the assets), memory mapped once, so reading one of them is a lookup with no filesystem calls.
+
+        header      magic "JPAK", version, entry count, and where the table of contents is
+        contents    per file: where its name is, where its data is, its size and its CRC-32
+        names       the files' paths relative to PACK_ROOT, e.g. "levels/intro.lvl"
+        data        the files' data, each aligned to 16 bytes
+
+    Every checksum is verified when the pack is opened, and files that don't match are left out,
+    so they're read from the disk instead.
+*/
+namespace Pack {
+
+
+// A file to be packed
+typedef struct PackFile {
+    std::string name;   // Relative to PACK_ROOT
+    std::string data;
+} PackFile;
+
+
+// Opens the pack, replacing the one open. Returns 'false', logging why, if it can't be read.
+bool Open(const char *path);
+
+void Close();
+
+bool IsOpen();
+
+// The data of the file, if it's in the pack. The path is the one the game uses, e.g. "../levels/intro.lvl".
+// The data is valid until the pack is closed.
+bool Find(std::string_view path, std::string_view *data);
+
+// Leaves the file out of the pack, so it's read from the disk from now on, e.g. after it's saved
+void Drop(std::string_view path);
+
+// How many files the open pack has
+int Count();
+
+// The names of the files in the open pack, sorted
+std::vector<std::string_view> Names();
+
+// Writes the files to a new pack
+bool Write(const char *path, const std::vector<PackFile> &files);
+
+// The CRC-32 of the data, as stored in the table of contents
+unsigned int Checksum(std::string_view data);
+
+
+} // namespace
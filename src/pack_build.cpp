@@ -0,0 +1,185 @@
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "files.hpp"
+#include "pack.hpp"
+#include "persistence_binary.hpp"
+
+
+/*
+    Builds a pack with the levels, the overworld and the text bank, from their folders.
+
+        jogo_pack <pack file> [--binary] [--assets]
+
+    --binary packs the levels converted to the binary format, instead of as text.
+    --assets packs all the assets too, that the game otherwise reads from their folder.
+
+    Or lists the files in a pack, after verifying them.
+
+        jogo_pack --list <pack file>
+
+    Like the game, it looks for the folders in PACK_ROOT, so it should be run from the build folder.
+*/
+
+
+#define LEVELS_DIR              PACK_ROOT "levels"
+#define ASSETS_DIR              PACK_ROOT "assets"
+#define TEXT_BANK_PATH          PACK_ROOT "assets/textbank.txt"
+
+#define TEXT_LEVEL_EXTENSION    ".lvl"
+#define OVERWORLD_EXTENSION     ".ow"
+
+
+static bool add(std::vector<Pack::PackFile> *files, const std::string &path, std::string data) {
+
+    if (path.compare(0, sizeof(PACK_ROOT) - 1, PACK_ROOT) != 0) {
+        fprintf(stderr, "File out of the packed folders: %s\n", path.c_str());
+        return false;
+    }
+
+    files->push_back({ path.substr(sizeof(PACK_ROOT) - 1), std::move(data) });
+    return true;
+}
+
+static bool addLevels(std::vector<Pack::PackFile> *files, bool asBinary) {
+
+    FilePathList paths = LoadDirectoryFiles(LEVELS_DIR);
+    bool added = true;
+
+    for (unsigned int i = 0; i < paths.count && added; i++) {
+
+        std::string path = paths.paths[i];
+
+        if (IsFileExtension(path.c_str(), OVERWORLD_EXTENSION)) {
+            added = add(files, path, Files::TextLoad(path));
+            continue;
+        }
+
+        // Binary levels on disk may be older than the text ones, so they're converted again
+        if (!IsFileExtension(path.c_str(), TEXT_LEVEL_EXTENSION)) continue;
+
+        std::string text = Files::TextLoad(path);
+
+        if (!asBinary) {
+            added = add(files, path, std::move(text));
+            continue;
+        }
+
+        std::string binary;
+        if (!PersistenceBinaryFromText(text, &binary)) {
+            fprintf(stderr, "Could not convert %s\n", path.c_str());
+            added = false;
+            continue;
+        }
+
+        path.resize(path.size() - (sizeof(TEXT_LEVEL_EXTENSION) - 1));
+        added = add(files, path + LEVEL_BINARY_FILE_EXTENSION, std::move(binary));
+    }
+
+    UnloadDirectoryFiles(paths);
+
+    return added;
+}
+
+static bool addAssets(std::vector<Pack::PackFile> *files) {
+
+    FilePathList paths = LoadDirectoryFilesEx(ASSETS_DIR, 0, true);
+    bool added = true;
+
+    for (unsigned int i = 0; i < paths.count && added; i++) {
+        added = add(files, paths.paths[i], Files::TextLoad(paths.paths[i]));
+    }
+
+    UnloadDirectoryFiles(paths);
+
+    return added;
+}
+
+static int build(const char *packPath, bool asBinary, bool withAssets) {
+
+    std::vector<Pack::PackFile> files;
+
+    if (!addLevels(&files, asBinary)) return 1;
+
+    if (withAssets) {
+        if (!addAssets(&files)) return 1;
+    } else {
+        if (!add(&files, TEXT_BANK_PATH, Files::TextLoad(TEXT_BANK_PATH))) return 1;
+    }
+
+    // The same folders always give the same pack
+    std::sort(files.begin(), files.end(), [](const Pack::PackFile &a, const Pack::PackFile &b) { return a.name < b.name; });
+
+    if (!Pack::Write(packPath, files)) {
+        fprintf(stderr, "Could not write %s\n", packPath);
+        return 1;
+    }
+
+    size_t size = 0;
+    for (const Pack::PackFile &file : files) size += file.data.size();
+
+    printf("Packed %zu files, %zu KB, into %s\n", files.size(), size / 1024, packPath);
+    return 0;
+}
+
+static int list(const char *packPath) {
+
+    if (!Pack::Open(packPath)) return 1;
+
+    std::string_view data;
+    std::string path;
+
+    for (std::string_view name : Pack::Names()) {
+
+        path = PACK_ROOT;
+        path.append(name);
+        Pack::Find(path, &data);
+
+        printf("%10zu  %08x  %.*s\n", data.size(), Pack::Checksum(data), (int) name.size(), name.data());
+    }
+
+    printf("%d files verified\n", Pack::Count());
+
+    Pack::Close();
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <pack file> [--binary] [--assets]\n"
+                        "       %s --list <pack file>\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    if (strcmp(argv[1], "--list") == 0) {
+
+        if (argc < 3) {
+            fprintf(stderr, "Missing pack file\n");
+            return 1;
+        }
+
+        return list(argv[2]);
+    }
+
+    bool asBinary = false;
+    bool withAssets = false;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--binary") == 0)       asBinary = true;
+        else if (strcmp(argv[i], "--assets") == 0)  withAssets = true;
+        else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    return build(argv[1], asBinary, withAssets);
+}
@@ -1,7 +1,17 @@
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <string.h>
-#include <sstream>
+#include <string_view>
+#include <charconv>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "persistence.hpp"
 #include "linked_list.hpp"
@@ -9,14 +19,19 @@
 #include "files.hpp"
 #include "render.hpp"
 #include "overworld.hpp"
+#include "background.hpp"
+#include "persistence_binary.hpp"
+#include "pack.hpp"
 
 
-#define PERSISTENCE_DIR_NAME            "levels"
 #define PERSISTENCE_DIR                 "../" PERSISTENCE_DIR_NAME "/"
 #define PERSISTENCE_DIR_BUFFER_SIZE     20
 
-#define LEVEL_FILE_EXTENSION            ".lvl"
-#define LEVEL_PATH_BUFFER_SIZE          LEVEL_NAME_BUFFER_SIZE + PERSISTENCE_DIR_BUFFER_SIZE
+// A guess of how long an entity's line is, to reserve the file's data at once
+#define LEVEL_LINE_SIZE_ESTIMATE        96
+
+// How many prefetched levels are kept
+#define LEVEL_PREFETCH_CACHE_SIZE       4
 
 #define OW_FILE_NAME                    "overworld.ow"
 #define OW_PATH_BUFFER_SIZE             20 + PERSISTENCE_DIR_BUFFER_SIZE
@@ -39,121 +54,723 @@ typedef struct PersistenceOverworldEntity {
 } PersistenceOverworldEntity;
 
 
+bool PersistenceFields::Parse(std::string_view line) {
+
+    count = 0;
+
+    while (!line.empty()) {
+
+        size_t fieldEnd = line.find(';');
+        std::string_view field = line.substr(0, fieldEnd);
+        line = fieldEnd == std::string_view::npos ? std::string_view() : line.substr(fieldEnd + 1);
+
+        if (field.empty()) continue;
+
+        size_t separator = field.find('=');
+        if (separator == std::string_view::npos) {
+            TraceLog(LOG_ERROR, "Persisted field '%.*s' has no value.", (int) field.size(), field.data());
+            return false;
+        }
+
+        if (!AddText(field.substr(0, separator), field.substr(separator + 1))) return false;
+    }
+
+    return true;
+}
+
+bool PersistenceFields::add(Field field) {
+
+    if (count >= PERSISTENCE_MAX_FIELDS) {
+        TraceLog(LOG_ERROR, "Persisted line has more than %d fields.", PERSISTENCE_MAX_FIELDS);
+        return false;
+    }
+
+    fields[count] = field;
+    count++;
+
+    return true;
+}
+
+bool PersistenceFields::AddText(std::string_view field, std::string_view value) {
+    return add({ field, PERSISTENCE_VALUE_TEXT, value, 0, 0 });
+}
+
+bool PersistenceFields::AddFloat(std::string_view field, float value) {
+    return add({ field, PERSISTENCE_VALUE_FLOAT, {}, value, 0 });
+}
+
+bool PersistenceFields::AddInt(std::string_view field, int value) {
+    return add({ field, PERSISTENCE_VALUE_INT, {}, 0, value });
+}
+
+bool PersistenceFields::AddHex(std::string_view field, unsigned int value) {
+    return add({ field, PERSISTENCE_VALUE_HEX, {}, 0, (int) value });
+}
+
+const PersistenceFields::Field *PersistenceFields::find(std::string_view field) const {
+
+    for (int i = 0; i < count; i++) {
+        if (fields[i].key == field) return &fields[i];
+    }
+
+    return 0;
+}
+
+bool PersistenceFields::Get(std::string_view field, std::string_view *value) const {
+
+    const Field *found = find(field);
+    if (!found || found->kind != PERSISTENCE_VALUE_TEXT) return false;
+
+    *value = found->text;
+    return true;
+}
+
+// The field, logging if it's missing
+static bool requireField(const void *found, std::string_view field) {
+
+    if (found) return true;
+
+    TraceLog(LOG_ERROR, "Persisted field '%.*s' is missing.", (int) field.size(), field.data());
+    return false;
+}
+
+static bool wrongKind(std::string_view field) {
+
+    TraceLog(LOG_ERROR, "Persisted field '%.*s' has a value of the wrong kind.", (int) field.size(), field.data());
+    return false;
+}
+
+// If from_chars() read the whole value, logging it otherwise
+static bool checkConversion(std::string_view field, std::string_view value, std::from_chars_result result) {
+
+    if (result.ec == std::errc() && result.ptr == value.data() + value.size()) return true;
+
+    TraceLog(LOG_ERROR, "Persisted field '%.*s' has invalid value '%.*s'.",
+                (int) field.size(), field.data(), (int) value.size(), value.data());
+    return false;
+}
+
+bool PersistenceFields::ReadString(std::string_view field, std::string *value) const {
+
+    const Field *found = find(field);
+    if (!requireField(found, field)) return false;
+    if (found->kind != PERSISTENCE_VALUE_TEXT) return wrongKind(field);
+
+    value->assign(found->text);
+    return true;
+}
+
+bool PersistenceFields::ReadFloat(std::string_view field, float *value) const {
+
+    const Field *found = find(field);
+    if (!requireField(found, field)) return false;
+
+    if (found->kind == PERSISTENCE_VALUE_FLOAT) {
+        *value = found->floatValue;
+        return true;
+    }
+
+    if (found->kind != PERSISTENCE_VALUE_TEXT) return wrongKind(field);
+
+    std::string_view raw = found->text;
+    float parsed;
+    if (!checkConversion(field, raw, std::from_chars(raw.data(), raw.data() + raw.size(), parsed))) return false;
+
+    *value = parsed;
+    return true;
+}
+
+bool PersistenceFields::ReadInt(std::string_view field, int *value) const {
+
+    const Field *found = find(field);
+    if (!requireField(found, field)) return false;
+
+    if (found->kind == PERSISTENCE_VALUE_INT) {
+        *value = found->intValue;
+        return true;
+    }
+
+    if (found->kind != PERSISTENCE_VALUE_TEXT) return wrongKind(field);
+
+    std::string_view raw = found->text;
+    int parsed;
+    if (!checkConversion(field, raw, std::from_chars(raw.data(), raw.data() + raw.size(), parsed))) return false;
+
+    *value = parsed;
+    return true;
+}
+
+bool PersistenceFields::ReadHex(std::string_view field, unsigned int *value) const {
+
+    const Field *found = find(field);
+    if (!requireField(found, field)) return false;
+
+    if (found->kind == PERSISTENCE_VALUE_HEX) {
+        *value = (unsigned int) found->intValue;
+        return true;
+    }
+
+    if (found->kind != PERSISTENCE_VALUE_TEXT) return wrongKind(field);
+
+    std::string_view raw = found->text;
+    unsigned int parsed;
+    if (!checkConversion(field, raw, std::from_chars(raw.data(), raw.data() + raw.size(), parsed, 16))) return false;
+
+    *value = parsed;
+    return true;
+}
+
+void PersistenceFields::AppendTo(std::string *line) const {
+
+    char buffer[20];
+
+    for (int i = 0; i < count; i++) {
+
+        const Field &field = fields[i];
+
+        switch (field.kind) {
+        case PERSISTENCE_VALUE_FLOAT:
+            PersistenceAppendValue(line, field.key, field.floatValue);
+            break;
+        case PERSISTENCE_VALUE_INT:
+            PersistenceAppendValue(line, field.key, field.intValue);
+            break;
+        case PERSISTENCE_VALUE_HEX:
+            snprintf(buffer, sizeof(buffer), "%08x", (unsigned int) field.intValue);
+            PersistenceAppendValue(line, field.key, buffer);
+            break;
+        default:
+            PersistenceAppendValue(line, field.key, field.text);
+        }
+    }
+}
+
+void PersistenceAppendValue(std::string *line, std::string_view field, std::string_view value) {
+
+    line->append(field);
+    *line += '=';
+    line->append(value);
+    *line += ';';
+}
+
+void PersistenceAppendValue(std::string *line, std::string_view field, float value) {
+
+    char buffer[64];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+    PersistenceAppendValue(line, field, std::string_view(buffer, result.ptr - buffer));
+}
+
+void PersistenceAppendValue(std::string *line, std::string_view field, int value) {
+
+    char buffer[16];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    PersistenceAppendValue(line, field, std::string_view(buffer, result.ptr - buffer));
+}
+
 static void getFilePath(char *pathBuffer, size_t bufferSize, char *fileName) {
     
     strncat(pathBuffer, PERSISTENCE_DIR, bufferSize);
     strncat(pathBuffer, fileName, bufferSize);
 }
 
-void PersistenceLevelSave(char *levelName) {
+// The paths of the level in both formats, whichever of them its name is in
+static void getLevelPaths(const char *levelName, std::string *textPath, std::string *binaryPath) {
 
-    std::string data = "levelname:" + std::string(levelName) + "\n";
+    std::string_view name = levelName;
+    std::string_view base = name;
 
-    for (Level::Entity *entity = (Level::Entity *) Level::STATE->listHead;
-        entity;
-        entity = (Level::Entity *) entity->next) {
+    if (base.ends_with(LEVEL_BINARY_FILE_EXTENSION))    base.remove_suffix(sizeof(LEVEL_BINARY_FILE_EXTENSION) - 1);
+    else if (base.ends_with(LEVEL_FILE_EXTENSION))      base.remove_suffix(sizeof(LEVEL_FILE_EXTENSION) - 1);
 
-            if (!(entity->tags & Level::IS_PERSISTABLE)) continue;
+    *textPath = PERSISTENCE_DIR;
+    textPath->append(base);
+    if (base.size() != name.size()) *textPath += LEVEL_FILE_EXTENSION;
+
+    *binaryPath = PERSISTENCE_DIR;
+    binaryPath->append(base);
+    *binaryPath += LEVEL_BINARY_FILE_EXTENSION;
+}
+
+// Adds an entity or a background layer read from a level, in either format
+static bool addLoaded(std::string_view entityTag, const PersistenceFields &fields) {
+
+    if (entityTag == "background")  return Background::AddFromPersistence(fields);
+    else                            return Level::Entity::AddFromPersistence(entityTag, fields);
+}
 
-            data += entity->PersitenceEntityID() + ":" + entity->PersistanceSerialize() + '\n';
+static void addLoadedFromBinary(std::string_view entityTag, const PersistenceFields &fields, void *context) {
+
+    (void) context;
+
+    if (!addLoaded(entityTag, fields)) {
+        TraceLog(LOG_ERROR, "Could not parse loaded level entity of type %.*s.", (int) entityTag.size(), entityTag.data());
     }
+}
 
-    char *levelPath = (char *) MemAlloc(LEVEL_PATH_BUFFER_SIZE);
-    getFilePath(levelPath, LEVEL_PATH_BUFFER_SIZE, levelName);
+// Parses a text level, splitting it into lines in place
+static void parseText(std::string_view data) {
 
-    Files::TextSave(levelPath, data);
-    TraceLog(LOG_INFO, "Level saved: %s.", levelName);
-    Render::PrintSysMessage("Fase salva.");
+    // About one entity per line, so the level makes room for them all before they're added one by one
+    Level::EntitiesReserve(std::count(data.begin(), data.end(), '\n') + 1);
 
-    MemFree(levelPath);
+    // Reused for every line, and only holds views into the data
+    PersistenceFields fields;
 
-    return;
+    std::string_view rest = data;
+    while (!rest.empty()) {
+
+        size_t lineEnd = rest.find('\n');
+        std::string_view line = rest.substr(0, lineEnd);
+        rest = lineEnd == std::string_view::npos ? std::string_view() : rest.substr(lineEnd + 1);
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        size_t tagDelimiter = line.find(':');
+        std::string_view entityTag = line.substr(0, tagDelimiter);
+
+        if (entityTag == "levelname") continue; // TODO exhibit level name instead of filename
+
+        bool parsed = tagDelimiter != std::string_view::npos &&
+                        fields.Parse(line.substr(tagDelimiter + 1)) &&
+                        addLoaded(entityTag, fields);
+
+        if (!parsed) {
+            TraceLog(LOG_ERROR, "Could not parse loaded level entity (%.*s).", (int) line.size(), line.data());
+        }
+    }
 }
 
-bool PersistenceLevelLoad(char *levelName) {
+static bool parseBinary(std::string_view data) {
+
+    std::string_view levelName; // TODO exhibit level name instead of filename
 
-    char *levelPath = (char *) MemAlloc(LEVEL_PATH_BUFFER_SIZE);
-    getFilePath(levelPath, LEVEL_PATH_BUFFER_SIZE, levelName);
+    // So the level makes room for all entities before they're added one by one
+    Level::EntitiesReserve(PersistenceBinaryRecordCount((const unsigned char *) data.data(), data.size()));
 
+    return PersistenceBinaryRead((const unsigned char *) data.data(), data.size(), &levelName, addLoadedFromBinary, 0);
+}
+
+// Where a level is read from
+typedef enum LevelSource {
+    LEVEL_SOURCE_PACK_BINARY,
+    LEVEL_SOURCE_PACK_TEXT,
+    LEVEL_SOURCE_BINARY,
+    LEVEL_SOURCE_TEXT
+} LevelSource;
+
+// Finds where to read the level from. If it's in the pack, its data is set.
+static LevelSource findLevel(const std::string &textPath, const std::string &binaryPath, std::string_view *packed) {
+
+    // From the pack it's just a lookup, with no filesystem calls
+    if (Pack::Find(binaryPath, packed))     return LEVEL_SOURCE_PACK_BINARY;
+    if (Pack::Find(textPath, packed))       return LEVEL_SOURCE_PACK_TEXT;
 
-    std::string data = Files::TextLoad(levelPath);
+    // The binary version of the level is loaded, unless the text one was saved after it
+    if (Files::Exists(binaryPath) &&
+        (!Files::Exists(textPath) || Files::ModTime(binaryPath) >= Files::ModTime(textPath))) {
+
+        return LEVEL_SOURCE_BINARY;
+    }
+
+    return LEVEL_SOURCE_TEXT;
+}
 
-    std::stringstream stream(data);
-    std::string line;
-    while (std::getline(stream, line)) {
+static bool loadBinary(const std::string &levelPath) {
 
-        try {
+    Files::MappedFile file = Files::Map(levelPath.c_str());
+    if (!file.data) return false;
 
-            size_t tagDelimiter = line.find(":");
-            std::string entityTag = line.substr(0, tagDelimiter);
-            std::string entityData = line.substr(tagDelimiter, line.size());
+    bool loaded = parseBinary(std::string_view((const char *) file.data, file.size));
 
-            if (entityTag == "levelname") continue; // TODO exhibit level name instead of filename
+    Files::Unmap(file);
 
-            Level::Entity::AddFromPersistence(entityTag, entityData);
+    return loaded;
+}
+
+/*
+    Reads levels in a worker thread before they're loaded, e.g. the one under the overworld's cursor,
+    converting them to the binary format, so loading one of them is only creating its entities.
+
+    The entities themselves are still created when the level is loaded, in the main thread,
+    as creating them changes the level's state.
+*/
+class LevelPrefetcher {
+
+public:
+
+    ~LevelPrefetcher() { Stop(); }
+
+    // Starts reading the level, if it's not read already
+    void Request(const char *levelName);
+
+    // The level in the binary format. Null if it wasn't prefetched, or its files changed since,
+    // or it's not read yet, as it's loaded faster by reading it than by waiting for it.
+    // A level still waiting to be read isn't read anymore.
+    std::shared_ptr<const std::string> Take(const char *levelName);
+
+    // If the level is read and current, so Take() has it
+    bool IsReady(const char *levelName);
+
+    void Forget(const char *levelName);
+
+    // Stops the worker, after the level it's reading
+    void Stop();
+
+private:
+
+    typedef struct PrefetchedLevel {
+        std::string name;
+        bool isReady;
+        std::shared_ptr<const std::string> batch;   // Null if it couldn't be read
+        long textModTime;                           // Of the files when the level was read, 0 if there was none
+        long binaryModTime;
+        unsigned long lastUsed;
+    } PrefetchedLevel;
+
+    std::vector<PrefetchedLevel> levels;
+    std::deque<std::string> queue;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread worker;
+    bool isStopping = false;
+
+    unsigned long useCount = 0;
+
+    PrefetchedLevel *find(const char *levelName);
+    bool isCurrent(const PrefetchedLevel &level);
+    void work();
+};
+
+static LevelPrefetcher prefetcher;
+
+
+// Reads the level as the loader would, in the binary format. Null if it can't be read.
+static std::shared_ptr<const std::string> readLevelBatch(const char *levelName) {
+
+    std::string textPath, binaryPath;
+    getLevelPaths(levelName, &textPath, &binaryPath);
+
+    std::shared_ptr<std::string> batch = std::make_shared<std::string>();
+    std::string_view packed;
+    bool read;
+
+    switch (findLevel(textPath, binaryPath, &packed)) {
+    case LEVEL_SOURCE_PACK_BINARY:
+        batch->assign(packed);
+        read = true;
+        break;
+    case LEVEL_SOURCE_PACK_TEXT:
+        read = PersistenceBinaryFromText(packed, batch.get());
+        break;
+    case LEVEL_SOURCE_BINARY:
+        *batch = Files::TextLoad(binaryPath);
+        read = !batch->empty();
+        break;
+    default:
+        read = Files::Exists(textPath) && PersistenceBinaryFromText(Files::TextLoad(textPath), batch.get());
+    }
+
+    if (!read) return nullptr;
+
+    return batch;
+}
+
+LevelPrefetcher::PrefetchedLevel *LevelPrefetcher::find(const char *levelName) {
+
+    for (PrefetchedLevel &level : levels) {
+        if (level.name == levelName) return &level;
+    }
+
+    return 0;
+}
+
+// If the level's files didn't change since it was read
+bool LevelPrefetcher::isCurrent(const PrefetchedLevel &level) {
+
+    std::string textPath, binaryPath;
+    getLevelPaths(level.name.c_str(), &textPath, &binaryPath);
+
+    return Files::ModTime(textPath) == level.textModTime &&
+            Files::ModTime(binaryPath) == level.binaryModTime;
+}
+
+void LevelPrefetcher::Request(const char *levelName) {
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    useCount++;
+
+    PrefetchedLevel *level = find(levelName);
+
+    if (level && (!level->isReady || isCurrent(*level))) {
+        level->lastUsed = useCount;
+        return;
+    }
+
+    if (!level) {
+
+        // Makes room, dropping the level used the longest ago that's not being read
+        if (levels.size() >= LEVEL_PREFETCH_CACHE_SIZE) {
+
+            auto oldest = levels.end();
+            for (auto it = levels.begin(); it != levels.end(); it++) {
+                if (it->isReady && (oldest == levels.end() || it->lastUsed < oldest->lastUsed)) oldest = it;
+            }
+
+            if (oldest == levels.end()) return; // all being read
+            levels.erase(oldest);
         }
 
-        catch (const std::exception &ex) {
-            TraceLog(LOG_ERROR, "Could not parse loaded level entity (%s): %s", line.c_str(), ex.what());
+        levels.push_back({ levelName, false, nullptr, 0, 0, useCount });
+        level = &levels.back();
+    }
+
+    level->isReady = false;
+    level->lastUsed = useCount;
+
+    queue.push_back(levelName);
+
+    if (!worker.joinable()) worker = std::thread(&LevelPrefetcher::work, this);
+
+    changed.notify_all();
+}
+
+std::shared_ptr<const std::string> LevelPrefetcher::Take(const char *levelName) {
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    PrefetchedLevel *level = find(levelName);
+    if (!level) return nullptr;
+
+    if (!level->isReady) {
+
+        // Not being read yet, and it's about to be read by the loader
+        auto queued = std::find(queue.begin(), queue.end(), levelName);
+        if (queued != queue.end()) {
+            queue.erase(queued);
+            levels.erase(levels.begin() + (level - levels.data()));
         }
+
+        TraceLog(LOG_DEBUG, "Prefetched level %s is not read yet.", levelName);
+        return nullptr;
     }
 
-    MemFree(levelPath);
+    if (!level->batch || !isCurrent(*level)) {
+        TraceLog(LOG_DEBUG, "Prefetched level %s is out of date.", levelName);
+        levels.erase(levels.begin() + (level - levels.data()));
+        return nullptr;
+    }
 
-    TraceLog(LOG_TRACE, "Level loaded: %s.", levelName);
+    level->lastUsed = ++useCount;
 
-    return true;
+    return level->batch;
 }
 
-bool PersistenceGetDroppedLevelName(char *nameBuffer) {
-    
-    FilePathList fileList = LoadDroppedFiles();
-    bool result = false;
+bool LevelPrefetcher::IsReady(const char *levelName) {
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    PrefetchedLevel *level = find(levelName);
+
+    return level && level->isReady && level->batch && isCurrent(*level);
+}
+
+void LevelPrefetcher::Forget(const char *levelName) {
 
-    char *filePath = fileList.paths[0];
+    std::lock_guard<std::mutex> lock(mutex);
 
-    // Ideally we'd support loading levels from anywhere,
-    // but this would involve rewriting the InitializeLevel logic.
-    // ATTENTION: It presumes the working dir is next to the 'levels' dir (i.e., it's the 'build' dir)
-    const char *fileDir = GetDirectoryPath(filePath);
-    const char *projectRootPath = GetPrevDirectoryPath(GetWorkingDirectory());
-    const char *fileName = GetFileName(filePath);
+    PrefetchedLevel *level = find(levelName);
+    if (level) levels.erase(levels.begin() + (level - levels.data()));
 
-    if (fileList.count > 1) {
-        TraceLog(LOG_ERROR, "Multiple files dropped. Ignoring them.");
-        goto return_result;
+    changed.notify_all();
+}
+
+void LevelPrefetcher::Stop() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+        queue.clear();
+        levels.clear();
+    }
+
+    changed.notify_all();
+
+    if (worker.joinable()) worker.join();
+
+    isStopping = false;
+}
+
+void LevelPrefetcher::work() {
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+
+        changed.wait(lock, [this] { return isStopping || !queue.empty(); });
+        if (isStopping) return;
+
+        std::string levelName = queue.front();
+        queue.pop_front();
+
+        // Read before the files, so a change while reading makes it out of date
+        std::string textPath, binaryPath;
+        getLevelPaths(levelName.c_str(), &textPath, &binaryPath);
+
+        lock.unlock();
+
+        long textModTime = Files::ModTime(textPath);
+        long binaryModTime = Files::ModTime(binaryPath);
+
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<const std::string> batch = readLevelBatch(levelName.c_str());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+
+        // It may have been forgotten meanwhile
+        PrefetchedLevel *level = find(levelName.c_str());
+        if (!level) continue;
+
+        level->isReady = true;
+        level->batch = batch;
+        level->textModTime = textModTime;
+        level->binaryModTime = binaryModTime;
+
+        TraceLog(LOG_DEBUG, "Level prefetched: %s, %zu bytes in %.1f ms.", levelName.c_str(),
+                    batch ? batch->size() : 0, elapsed.count() * 1000);
+
+        changed.notify_all();
+    }
+}
+
+void PersistenceLevelSave(char *levelName) {
+
+    // Every line is appended to the same string, allocated once up front
+    std::string data;
+    data.reserve((Level::ENTITIES.Count() + Background::Layers().size() + 1) * LEVEL_LINE_SIZE_ESTIMATE);
+
+    data += "levelname:";
+    data += levelName;
+    data += '\n';
+
+    for (Background::Layer layer : Background::Layers()) {
+        data += layer.PersitenceEntityID();
+        data += ':';
+        layer.PersistanceSerialize(&data);
+        data += '\n';
     }
 
-    if (strcmp(projectRootPath, GetPrevDirectoryPath(fileDir)) != 0 ||
-        strcmp(GetFileName(fileDir), PERSISTENCE_DIR_NAME) != 0) {
+    for (Level::Entity *entity : Level::ENTITIES) {
+
+            if (!(entity->tags & Level::IS_PERSISTABLE)) continue;
 
-            TraceLog(LOG_ERROR, "Dropped file is not on 'levels' directory.");
-            Render::PrintSysMessage("Arquivo não é parte do jogo");
-            goto return_result;
+            data += entity->PersitenceEntityID();
+            data += ':';
+            entity->PersistanceSerialize(&data);
+            data += '\n';
     }
 
-    if (strcmp(GetFileExtension(filePath), LEVEL_FILE_EXTENSION) != 0) {
-        TraceLog(LOG_ERROR, "Dropped file extension is not %s. Ignoring it",
-                    LEVEL_FILE_EXTENSION);
-        Render::PrintSysMessage("Arquivo não é fase");
-        goto return_result;
+    std::string textPath, binaryPath;
+    getLevelPaths(levelName, &textPath, &binaryPath);
+
+    // Always saved as text, that can be edited and diffed
+    Files::TextSave(textPath, data);
+
+    // What's in the pack, or was prefetched, is older now
+    Pack::Drop(textPath);
+    Pack::Drop(binaryPath);
+    prefetcher.Forget(levelName);
+
+    TraceLog(LOG_INFO, "Level saved: %s.", levelName);
+    Render::PrintSysMessage("Fase salva.");
+
+    // A binary version of the level is converted again, or it'd be loaded instead of what was just saved
+    if (Files::Exists(binaryPath)) {
+
+        std::string binary;
+        if (!PersistenceBinaryFromText(data, &binary) || !Files::BinarySave(binaryPath, binary)) {
+            TraceLog(LOG_ERROR, "Could not update binary level %s, removing it.", binaryPath.c_str());
+            remove(binaryPath.c_str());
+        }
     }
 
-    if (strcmp(fileName, LEVEL_BLUEPRINT_NAME) == 0 ||
-        strlen(fileName) > LEVEL_NAME_BUFFER_SIZE) {
+    return;
+}
+
+bool PersistenceLevelLoad(char *levelName) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::string textPath, binaryPath;
+    getLevelPaths(levelName, &textPath, &binaryPath);
+
+    std::string_view packed;
+    const char *source;
+    bool loaded = true;
+
+    Background::Clear();
+
+    // Already read and parsed, what's left is creating the entities
+    std::shared_ptr<const std::string> prefetched = prefetcher.Take(levelName);
 
-            TraceLog(LOG_ERROR, "Dropped file has invalid level name %s.",
-                        fileName);
-            Render::PrintSysMessage("Nome de fase proibido");
-            goto return_result;
+    if (prefetched) {
+        source = "prefetched";
+        loaded = parseBinary(*prefetched);
     }
+    else switch (findLevel(textPath, binaryPath, &packed)) {
+    case LEVEL_SOURCE_PACK_BINARY:
+        source = "pack, binary";
+        loaded = parseBinary(packed);
+        break;
+    case LEVEL_SOURCE_PACK_TEXT:
+        source = "pack";
+        parseText(packed);
+        break;
+    case LEVEL_SOURCE_BINARY:
+        source = "binary";
+        loaded = loadBinary(binaryPath);
+        break;
+    default:
+        source = "text";
+        parseText(Files::TextLoad(textPath));
+    }
+
+    if (!loaded) {
+        TraceLog(LOG_ERROR, "Could not load binary level %s.", levelName);
+        return false;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    TraceLog(LOG_INFO, "Level loaded: %s (%s), %zu entities in %.1f ms.", levelName, source,
+                Level::ENTITIES.Count(), elapsed.count() * 1000);
+
+    return true;
+}
+
+void PersistenceLevelPrefetch(const char *levelName) {
+    prefetcher.Request(levelName);
+}
+
+bool PersistenceLevelIsPrefetched(const char *levelName) {
+    return prefetcher.IsReady(levelName);
+}
+
+void PersistenceLevelPrefetchStop() {
+    prefetcher.Stop();
+}
+
+bool PersistenceLevelExists(char *levelName) {
+
+    std::string textPath, binaryPath;
+    getLevelPaths(levelName, &textPath, &binaryPath);
 
-    strcpy(nameBuffer, fileName);
-    result = true;
+    std::string_view packed;
 
-return_result:
-    UnloadDroppedFiles(fileList);
-    return result;
+    return Pack::Find(textPath, &packed) || Pack::Find(binaryPath, &packed) ||
+            Files::Exists(textPath) || Files::Exists(binaryPath);
 }
 
 void PersistenceOverworldSave() {
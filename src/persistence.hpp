@@ -4,9 +4,96 @@
 
 #include <stdbool.h>
 #include <string>
+#include <string_view>
 
 #define LEVEL_NAME_BUFFER_SIZE 400
 
+// The folder the levels are in, next to the one the game runs from
+#define PERSISTENCE_DIR_NAME            "levels"
+
+#define LEVEL_FILE_EXTENSION            ".lvl"
+
+
+// The most fields a persisted line can have
+#define PERSISTENCE_MAX_FIELDS 16
+
+
+// How a field's value is held: as written in a text level, or already converted, as read from a binary one
+typedef enum PersistenceValueKind {
+	PERSISTENCE_VALUE_TEXT,
+	PERSISTENCE_VALUE_FLOAT,
+	PERSISTENCE_VALUE_INT,
+	PERSISTENCE_VALUE_HEX
+} PersistenceValueKind;
+
+
+/*
+	The fields of a persisted line, e.g. "originX=1.0;originY=2.0;", tokenized once.
+
+	Keys and text values are views into the line, so it must outlive this.
+	Reading a field that's missing or malformed logs it and returns 'false', it doesn't throw.
+*/
+class PersistenceFields {
+
+public:
+
+	// Tokenizes the line, without the type tag. Returns 'false' if it's malformed or has too many fields.
+	bool Parse(std::string_view line);
+
+	void Clear() { count = 0; }
+
+	// Add a field. Return 'false' if there are too many fields.
+	bool AddText(std::string_view field, std::string_view value);
+	bool AddFloat(std::string_view field, float value);
+	bool AddInt(std::string_view field, int value);
+	bool AddHex(std::string_view field, unsigned int value);
+
+	// The raw value of a text field. Returns 'false' if there's no such field, or it's not text.
+	bool Get(std::string_view field, std::string_view *value) const;
+
+	// If the line has the field, for the optional ones
+	bool Has(std::string_view field) const { return find(field) != 0; }
+
+	bool ReadString(std::string_view field, std::string *value) const;
+	bool ReadFloat(std::string_view field, float *value) const;
+	bool ReadInt(std::string_view field, int *value) const;
+
+	// An unsigned int written in hexadecimal, e.g. a color
+	bool ReadHex(std::string_view field, unsigned int *value) const;
+
+	// Appends the fields to the line, in order, the same as the entities write them
+	void AppendTo(std::string *line) const;
+
+	int Count() const { return count; }
+
+	std::string_view Key(int index) const { return fields[index].key; }
+
+private:
+
+	typedef struct Field {
+		std::string_view key;
+		PersistenceValueKind kind;
+		std::string_view text;
+		float floatValue;
+		int intValue;
+	} Field;
+
+	Field fields[PERSISTENCE_MAX_FIELDS];
+	int count = 0;
+
+	const Field *find(std::string_view field) const;
+	bool add(Field field);
+};
+
+
+/*
+	Append a field and its value to a persisted line.
+	Floats are written with six decimals, as std::to_string() did.
+*/
+void PersistenceAppendValue(std::string *line, std::string_view field, std::string_view value);
+void PersistenceAppendValue(std::string *line, std::string_view field, float value);
+void PersistenceAppendValue(std::string *line, std::string_view field, int value);
+
 
 // To be implemented by persistable entities
 class IPersistable { 
@@ -15,25 +102,32 @@ class IPersistable {
 	Persisted levels are text files following roughly this format:
 	
 	levelname:My Level
+	background:item1=x;item2=y;item3=z
 	entity_type_1:item1=x;item2=y;item3=z
 	entity_type_2:item1=a;item2=b;item3=c
+
+	The background lines are the level's background layers (see background.hpp).
+	They can also be converted to a compact binary format (see persistence_binary.hpp),
+	that's read into the same fields.
 */
 
 public:
 
-	// Returns a string with the entity's data to be saved to persistence.
-	// The string should be assembled by adding the persisting fields using persistenceAddValue().
-	virtual std::string PersistanceSerialize() = 0;
+	// Appends the entity's data to be saved to persistence to the line, that's shared by
+	// the whole file so it's allocated only once.
+	// The data should be assembled by adding the persisting fields using persistanceAddValue().
+	virtual void PersistanceSerialize(std::string *line) = 0;
 
 	// Loads persistence data to an existing entity.
-	// To extract each field using persistenceReadValue() and initialize the entity accordingly.
+	// To read each field from the already tokenized line and initialize the entity accordingly.
+	// Returns 'false' if a field was missing or malformed.
 	// NOTE: Ideally this would be a static function creating a new instance of the entity,
 	// but C++ doesn't support virtual static member functions.
-	virtual void PersistenceParse(const std::string &data) = 0;
+	virtual bool PersistenceParse(const PersistenceFields &fields) = 0;
 
 	// The ID unique to an entity type that can be persisted.
 	// This ID should be associated to the entity's initalization function at PersistenceLevelLoad().
-	virtual const std::string &PersitenceEntityID() = 0;
+	virtual std::string_view PersitenceEntityID() = 0;
 
 	/*
 		Adds a value to a data string. To be used inside PersistenceSerialize().
@@ -41,22 +135,16 @@ public:
 		@param field The field to be added to the line
 		@param value The value to be added to the field
 	*/
-	virtual void persistanceAddValue(std::string *line, const std::string &field, const std::string &value) final {
-		*line += field + "=" + value + ";";
+	virtual void persistanceAddValue(std::string *line, std::string_view field, std::string_view value) final {
+		PersistenceAppendValue(line, field, value);
 	}
 
-	/*
-		Searches for a value in a data string. To be used inside PersistenceParse().
-		@param line The line to be searched
-		@param field The field to be searched in the line
-		@return The value corresponding to the field
-	*/
-	virtual std::string persistenceReadValue(const std::string &line, const std::string &field) final {
-		std::string label = field + "=";
-		size_t labelStart = line.find(label);
-		size_t valueStart = labelStart + label.length();
-		size_t valueEnd = line.find(";", valueStart); 
-		return line.substr(valueStart, valueEnd - valueStart);
+	virtual void persistanceAddValue(std::string *line, std::string_view field, float value) final {
+		PersistenceAppendValue(line, field, value);
+	}
+
+	virtual void persistanceAddValue(std::string *line, std::string_view field, int value) final {
+		PersistenceAppendValue(line, field, value);
 	}
 };
 
@@ -67,8 +155,17 @@ void PersistenceLevelSave(char *levelName);
 
 bool PersistenceLevelLoad(char *levelName);
 
-// Copies the name of the dropped level into the buffer. Returns 'true' if successful.
-bool PersistenceGetDroppedLevelName(char *nameBuffer);
+// Starts reading and parsing the level in the background, so loading it later only creates its entities
+void PersistenceLevelPrefetch(const char *levelName);
+
+// If the level was prefetched and didn't change since, so loading it doesn't read it
+bool PersistenceLevelIsPrefetched(const char *levelName);
+
+// Stops prefetching levels, and forgets the ones prefetched
+void PersistenceLevelPrefetchStop();
+
+// If there's a level file with this name
+bool PersistenceLevelExists(char *levelName);
 
 
 // Overworld
@@ -0,0 +1,560 @@
+#include <raylib.h>
+#include <stdint.h>
+#include <string.h>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "persistence_binary.hpp"
+#include "level/block.hpp"
+#include "level/textbox.hpp"
+#include "level/moving_platform.hpp"
+
+
+#define BINARY_MAGIC            "LVLB"
+#define BINARY_MAGIC_SIZE       4
+
+#define BACKGROUND_TYPE_ID      "background"
+#define LEVEL_NAME_TYPE_ID      "levelname"
+
+// The most optional fields a type can have, one bit each in the record's first byte
+#define MAX_OPTIONAL_FIELDS     8
+
+
+typedef enum BinaryFieldType {
+    BINARY_FLOAT32,
+    BINARY_INT16,
+    BINARY_INT32,
+    BINARY_BOOL8,
+    BINARY_STRING16,    // Index in the string table
+    BINARY_COLOR32      // RGBA, read as a hex value, as the text format writes colors
+} BinaryFieldType;
+
+typedef struct BinaryField {
+    const char *name;
+    BinaryFieldType type;
+    bool isOptional;
+} BinaryField;
+
+// The fields of a type's records, in the order they're written
+typedef struct BinarySchema {
+    const char *type;
+    const BinaryField *fields;
+    int fieldCount;
+} BinarySchema;
+
+
+typedef struct BinaryHeader {
+    char magic[BINARY_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t levelName;         // Index in the string table
+    uint32_t sectionCount;
+    uint32_t sectionsOffset;
+    uint32_t stringCount;
+    uint32_t stringsOffset;
+} BinaryHeader;
+
+typedef struct BinarySection {
+    uint32_t type;              // Index in the string table
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint32_t recordsOffset;
+} BinarySection;
+
+typedef struct BinaryString {
+    uint32_t offset;
+    uint32_t length;
+} BinaryString;
+
+
+// Entities that persist only where they are
+static const BinaryField entityFields[] = {
+    { "originX", BINARY_FLOAT32, false },
+    { "originY", BINARY_FLOAT32, false },
+};
+
+static const BinaryField blockFields[] = {
+    { "originX", BINARY_FLOAT32, false },
+    { "originY", BINARY_FLOAT32, false },
+    { "rotation", BINARY_INT16, true },     // Older blocks don't have a rotation nor a tile type
+    { "tileType", BINARY_STRING16, true },
+};
+
+static const BinaryField textboxFields[] = {
+    { "originX", BINARY_FLOAT32, false },
+    { "originY", BINARY_FLOAT32, false },
+    { "textId", BINARY_INT32, false },
+    { "isDevTextbox", BINARY_BOOL8, false },
+};
+
+static const BinaryField movingPlatformFields[] = {
+    { "originX", BINARY_FLOAT32, false },
+    { "originY", BINARY_FLOAT32, false },
+    { "startPosX", BINARY_FLOAT32, false },
+    { "startPosY", BINARY_FLOAT32, false },
+    { "endPosX", BINARY_FLOAT32, false },
+    { "endPosY", BINARY_FLOAT32, false },
+    { "size", BINARY_INT32, false },
+};
+
+static const BinaryField backgroundFields[] = {
+    { "image", BINARY_STRING16, false },
+    { "x", BINARY_FLOAT32, false },
+    { "y", BINARY_FLOAT32, false },
+    { "scale", BINARY_FLOAT32, false },
+    { "parallax", BINARY_FLOAT32, false },
+    { "tint", BINARY_COLOR32, false },
+    { "repeat", BINARY_STRING16, true },
+};
+
+#define SCHEMA(type, fields) { type, fields, sizeof(fields) / sizeof(BinaryField) }
+
+// The types with more than an origin. Any other type is an entity that only has its origin.
+static const BinarySchema schemas[] = {
+    SCHEMA(BLOCK_ENTITY_ID, blockFields),
+    SCHEMA(TEXTBOX_BUTTON_ENTITY_ID, textboxFields),
+    SCHEMA(MOVING_PLATFORM_ENTITY_ID, movingPlatformFields),
+    SCHEMA(BACKGROUND_TYPE_ID, backgroundFields),
+};
+
+static const BinarySchema entitySchema = SCHEMA("", entityFields);
+
+
+static const BinarySchema &schemaFor(std::string_view type) {
+
+    for (const BinarySchema &schema : schemas) {
+        if (type == schema.type) return schema;
+    }
+
+    return entitySchema;
+}
+
+static size_t fieldSize(BinaryFieldType type) {
+
+    switch (type) {
+    case BINARY_INT16:      return sizeof(int16_t);
+    case BINARY_BOOL8:      return sizeof(uint8_t);
+    case BINARY_STRING16:   return sizeof(uint16_t);
+    default:                return sizeof(uint32_t);
+    }
+}
+
+static bool hasOptionalFields(const BinarySchema &schema) {
+
+    for (int i = 0; i < schema.fieldCount; i++) {
+        if (schema.fields[i].isOptional) return true;
+    }
+
+    return false;
+}
+
+static size_t recordSize(const BinarySchema &schema) {
+
+    size_t size = hasOptionalFields(schema) ? sizeof(uint8_t) : 0;
+
+    for (int i = 0; i < schema.fieldCount; i++) size += fieldSize(schema.fields[i].type);
+
+    return size;
+}
+
+template <typename T>
+static void appendBytes(std::string *out, T value) {
+    out->append((const char *) &value, sizeof(T));
+}
+
+// Records aren't aligned, so they're read byte by byte
+template <typename T>
+static T readBytes(const unsigned char *data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+
+// The file being written, assembled at the end when every offset is known
+typedef struct BinaryWriter {
+    std::vector<std::string_view> strings;
+    std::unordered_map<std::string_view, uint32_t> stringIndexes;
+    std::vector<BinarySection> sections;
+    std::string records;
+} BinaryWriter;
+
+static uint32_t intern(BinaryWriter *writer, std::string_view string) {
+
+    auto found = writer->stringIndexes.find(string);
+    if (found != writer->stringIndexes.end()) return found->second;
+
+    uint32_t index = writer->strings.size();
+    writer->strings.push_back(string);
+    writer->stringIndexes[string] = index;
+
+    return index;
+}
+
+static bool packRecord(BinaryWriter *writer, const BinarySchema &schema, const PersistenceFields &fields) {
+
+    std::string &records = writer->records;
+
+    const bool hasOptional = hasOptionalFields(schema);
+    const size_t maskPos = records.size();
+    uint8_t mask = 0;
+
+    if (hasOptional) appendBytes<uint8_t>(&records, 0);
+
+    for (int i = 0; i < schema.fieldCount; i++) {
+
+        const BinaryField &field = schema.fields[i];
+
+        if (field.isOptional) {
+
+            if (i >= MAX_OPTIONAL_FIELDS) {
+                TraceLog(LOG_ERROR, "Binary level field '%s' is optional, but too far in its record.", field.name);
+                return false;
+            }
+
+            if (!fields.Has(field.name)) {
+                records.append(fieldSize(field.type), '\0');
+                continue;
+            }
+
+            mask |= 1 << i;
+        }
+
+        float floatValue;
+        int intValue;
+        unsigned int hexValue;
+        std::string_view stringValue;
+
+        switch (field.type) {
+
+        case BINARY_FLOAT32:
+            if (!fields.ReadFloat(field.name, &floatValue)) return false;
+            appendBytes<float>(&records, floatValue);
+            break;
+
+        case BINARY_INT16:
+            if (!fields.ReadInt(field.name, &intValue)) return false;
+            if (intValue < INT16_MIN || intValue > INT16_MAX) {
+                TraceLog(LOG_ERROR, "Binary level field '%s' doesn't fit %d.", field.name, intValue);
+                return false;
+            }
+            appendBytes<int16_t>(&records, intValue);
+            break;
+
+        case BINARY_INT32:
+            if (!fields.ReadInt(field.name, &intValue)) return false;
+            appendBytes<int32_t>(&records, intValue);
+            break;
+
+        case BINARY_BOOL8:
+            if (!fields.ReadInt(field.name, &intValue)) return false;
+            if (intValue < 0 || intValue > UINT8_MAX) {
+                TraceLog(LOG_ERROR, "Binary level field '%s' doesn't fit %d.", field.name, intValue);
+                return false;
+            }
+            appendBytes<uint8_t>(&records, intValue);
+            break;
+
+        case BINARY_STRING16:
+            if (!fields.Get(field.name, &stringValue)) {
+                TraceLog(LOG_ERROR, "Persisted field '%s' is missing.", field.name);
+                return false;
+            }
+            intValue = intern(writer, stringValue);
+            if (intValue > UINT16_MAX) {
+                TraceLog(LOG_ERROR, "Binary level has more than %d strings.", UINT16_MAX + 1);
+                return false;
+            }
+            appendBytes<uint16_t>(&records, intValue);
+            break;
+
+        case BINARY_COLOR32:
+            if (!fields.ReadHex(field.name, &hexValue)) return false;
+            appendBytes<uint32_t>(&records, hexValue);
+            break;
+        }
+    }
+
+    if (hasOptional) records[maskPos] = mask;
+
+    return true;
+}
+
+// If every field of the line has a place in the type's records, so none is lost
+static bool fitsSchema(const BinarySchema &schema, const PersistenceFields &fields) {
+
+    for (int i = 0; i < fields.Count(); i++) {
+
+        bool found = false;
+        for (int f = 0; f < schema.fieldCount && !found; f++) found = fields.Key(i) == schema.fields[f].name;
+
+        if (!found) {
+            std::string_view key = fields.Key(i);
+            TraceLog(LOG_ERROR, "Persisted field '%.*s' has no place in the binary level format.", (int) key.size(), key.data());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PersistenceBinaryFromText(std::string_view text, std::string *binary) {
+
+    BinaryWriter writer;
+    PersistenceFields fields;
+    uint32_t levelName = intern(&writer, "");
+
+    std::string_view rest = text;
+    while (!rest.empty()) {
+
+        size_t lineEnd = rest.find('\n');
+        std::string_view line = rest.substr(0, lineEnd);
+        rest = lineEnd == std::string_view::npos ? std::string_view() : rest.substr(lineEnd + 1);
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        size_t tagDelimiter = line.find(':');
+        if (tagDelimiter == std::string_view::npos) {
+            TraceLog(LOG_ERROR, "Level line has no type (%.*s).", (int) line.size(), line.data());
+            return false;
+        }
+
+        std::string_view tag = line.substr(0, tagDelimiter);
+        std::string_view data = line.substr(tagDelimiter + 1);
+
+        if (tag == LEVEL_NAME_TYPE_ID) {
+            levelName = intern(&writer, data);
+            continue;
+        }
+
+        const BinarySchema &schema = schemaFor(tag);
+
+        if (!fields.Parse(data) || !fitsSchema(schema, fields)) {
+            TraceLog(LOG_ERROR, "Could not convert level line (%.*s).", (int) line.size(), line.data());
+            return false;
+        }
+
+        uint32_t type = intern(&writer, tag);
+
+        // A new section whenever the type changes, to keep the order of the lines
+        if (writer.sections.empty() || writer.sections.back().type != type) {
+            writer.sections.push_back({ type, (uint32_t) recordSize(schema), 0, (uint32_t) writer.records.size() });
+        }
+
+        if (!packRecord(&writer, schema, fields)) {
+            TraceLog(LOG_ERROR, "Could not convert level line (%.*s).", (int) line.size(), line.data());
+            return false;
+        }
+
+        writer.sections.back().recordCount++;
+    }
+
+
+    BinaryHeader header = {};
+    memcpy(header.magic, BINARY_MAGIC, BINARY_MAGIC_SIZE);
+    header.version = LEVEL_BINARY_VERSION;
+    header.levelName = levelName;
+    header.sectionCount = writer.sections.size();
+    header.sectionsOffset = sizeof(BinaryHeader);
+    header.stringCount = writer.strings.size();
+    header.stringsOffset = header.sectionsOffset + writer.sections.size() * sizeof(BinarySection);
+
+    size_t stringBytes = 0;
+    for (std::string_view string : writer.strings) stringBytes += string.size();
+
+    const size_t stringBytesOffset = header.stringsOffset + writer.strings.size() * sizeof(BinaryString);
+    const size_t recordsOffset = stringBytesOffset + stringBytes;
+    const size_t totalSize = recordsOffset + writer.records.size();
+
+    if (totalSize > UINT32_MAX) {
+        TraceLog(LOG_ERROR, "Level is too big for the binary format (%zu bytes).", totalSize);
+        return false;
+    }
+
+    binary->clear();
+    binary->reserve(totalSize);
+
+    appendBytes(binary, header);
+
+    for (BinarySection section : writer.sections) {
+        section.recordsOffset += recordsOffset;
+        appendBytes(binary, section);
+    }
+
+    uint32_t stringOffset = stringBytesOffset;
+    for (std::string_view string : writer.strings) {
+        appendBytes(binary, BinaryString{ stringOffset, (uint32_t) string.size() });
+        stringOffset += string.size();
+    }
+
+    for (std::string_view string : writer.strings) binary->append(string);
+
+    binary->append(writer.records);
+
+    return true;
+}
+
+
+// If the range is inside the file, without overflowing
+static bool inBounds(size_t fileSize, uint64_t offset, uint64_t count, uint64_t itemSize) {
+    return offset <= fileSize && count * itemSize <= fileSize - offset;
+}
+
+static bool readString(const unsigned char *data, size_t size, const BinaryHeader &header,
+                        uint32_t index, std::string_view *string) {
+
+    if (index >= header.stringCount) {
+        TraceLog(LOG_ERROR, "Binary level refers to string %u, but has %u.", index, header.stringCount);
+        return false;
+    }
+
+    BinaryString entry = readBytes<BinaryString>(data + header.stringsOffset + index * sizeof(BinaryString));
+
+    if (!inBounds(size, entry.offset, entry.length, 1)) {
+        TraceLog(LOG_ERROR, "Binary level string %u is out of the file.", index);
+        return false;
+    }
+
+    *string = std::string_view((const char *) data + entry.offset, entry.length);
+    return true;
+}
+
+size_t PersistenceBinaryRecordCount(const unsigned char *data, size_t size) {
+
+    if (size < sizeof(BinaryHeader) || memcmp(data, BINARY_MAGIC, BINARY_MAGIC_SIZE) != 0) return 0;
+
+    const BinaryHeader header = readBytes<BinaryHeader>(data);
+
+    if (header.version != LEVEL_BINARY_VERSION ||
+        !inBounds(size, header.sectionsOffset, header.sectionCount, sizeof(BinarySection))) {
+
+        return 0;
+    }
+
+    size_t count = 0;
+
+    for (uint32_t s = 0; s < header.sectionCount; s++) {
+        count += readBytes<BinarySection>(data + header.sectionsOffset + s * sizeof(BinarySection)).recordCount;
+    }
+
+    return count;
+}
+
+bool PersistenceBinaryRead(const unsigned char *data, size_t size, std::string_view *levelName,
+                            PersistenceBinaryEntityCallback onEntity, void *context) {
+
+    if (size < sizeof(BinaryHeader) || memcmp(data, BINARY_MAGIC, BINARY_MAGIC_SIZE) != 0) {
+        TraceLog(LOG_ERROR, "File is not a binary level.");
+        return false;
+    }
+
+    const BinaryHeader header = readBytes<BinaryHeader>(data);
+
+    if (header.version != LEVEL_BINARY_VERSION) {
+        TraceLog(LOG_ERROR, "Binary level has version %u, but only %d is supported.", header.version, LEVEL_BINARY_VERSION);
+        return false;
+    }
+
+    if (!inBounds(size, header.sectionsOffset, header.sectionCount, sizeof(BinarySection)) ||
+        !inBounds(size, header.stringsOffset, header.stringCount, sizeof(BinaryString))) {
+
+        TraceLog(LOG_ERROR, "Binary level's tables are out of the file.");
+        return false;
+    }
+
+    if (!readString(data, size, header, header.levelName, levelName)) return false;
+
+    PersistenceFields fields;
+
+    for (uint32_t s = 0; s < header.sectionCount; s++) {
+
+        const BinarySection section = readBytes<BinarySection>(data + header.sectionsOffset + s * sizeof(BinarySection));
+
+        std::string_view type;
+        if (!readString(data, size, header, section.type, &type)) return false;
+
+        const BinarySchema &schema = schemaFor(type);
+        const bool hasOptional = hasOptionalFields(schema);
+
+        if (section.recordSize != recordSize(schema) ||
+            !inBounds(size, section.recordsOffset, section.recordCount, section.recordSize)) {
+
+            TraceLog(LOG_ERROR, "Binary level section %u, of type %.*s, is malformed.", s, (int) type.size(), type.data());
+            return false;
+        }
+
+        const unsigned char *record = data + section.recordsOffset;
+
+        for (uint32_t r = 0; r < section.recordCount; r++) {
+
+            const unsigned char *pos = record;
+            uint8_t mask = 0xff;
+
+            if (hasOptional) {
+                mask = *pos;
+                pos++;
+            }
+
+            fields.Clear();
+
+            for (int i = 0; i < schema.fieldCount; i++) {
+
+                const BinaryField &field = schema.fields[i];
+                const unsigned char *value = pos;
+                pos += fieldSize(field.type);
+
+                if (field.isOptional && !(mask & (1 << i))) continue;
+
+                std::string_view string;
+
+                switch (field.type) {
+                case BINARY_FLOAT32:    fields.AddFloat(field.name, readBytes<float>(value)); break;
+                case BINARY_INT16:      fields.AddInt(field.name, readBytes<int16_t>(value)); break;
+                case BINARY_INT32:      fields.AddInt(field.name, readBytes<int32_t>(value)); break;
+                case BINARY_BOOL8:      fields.AddInt(field.name, readBytes<uint8_t>(value)); break;
+                case BINARY_COLOR32:    fields.AddHex(field.name, readBytes<uint32_t>(value)); break;
+                case BINARY_STRING16:
+                    if (!readString(data, size, header, readBytes<uint16_t>(value), &string)) return false;
+                    fields.AddText(field.name, string);
+                    break;
+                }
+            }
+
+            onEntity(type, fields, context);
+
+            record += section.recordSize;
+        }
+    }
+
+    return true;
+}
+
+
+static void appendLine(std::string_view type, const PersistenceFields &fields, void *context) {
+
+    std::string *text = (std::string *) context;
+
+    text->append(type);
+    *text += ':';
+    fields.AppendTo(text);
+    *text += '\n';
+}
+
+bool PersistenceBinaryToText(const unsigned char *data, size_t size, std::string *text) {
+
+    std::string lines;
+    std::string_view levelName;
+
+    if (!PersistenceBinaryRead(data, size, &levelName, appendLine, &lines)) return false;
+
+    text->clear();
+    text->reserve(lines.size() + levelName.size() + sizeof(LEVEL_NAME_TYPE_ID) + 1);
+
+    *text += LEVEL_NAME_TYPE_ID ":";
+    text->append(levelName);
+    *text += '\n';
+    text->append(lines);
+
+    return true;
+}
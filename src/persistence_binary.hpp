@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <string>
+#include <string_view>
+
+#include "persistence.hpp"
+
+
+#define LEVEL_BINARY_FILE_EXTENSION     ".lvlb"
+
+// Bumped whenever the layout of the file, or of any record, changes
+#define LEVEL_BINARY_VERSION            1
+
+
+/*
+    The binary level format, a compact version of the text one, read with a single pass over the file.
+
+        header          magic "LVLB", version, the level name, and where the tables below are
+        sections        one per run of consecutive entities of the same type: its type, record size and count
+        strings         offset and length of each string, then their bytes: type IDs, tile types, images...
+        records         the sections' fixed-size records, packed
+
+    A record holds its type's fields (see the schemas in persistence_binary.cpp) in order, with no padding.
+    If the type has optional fields, the record starts with a byte flagging which of them are there.
+    Numbers are in the machine's byte order, i.e. little endian in every platform the game runs on.
+
+    The sections follow the order of the text file, so converting back and forth gives the same file.
+*/
+
+
+// Called for every entity of a binary level, in order, with its fields already read
+typedef void (*PersistenceBinaryEntityCallback)(std::string_view type, const PersistenceFields &fields, void *context);
+
+
+// Converts a text level to binary. Returns 'false', logging why, if a line can't be converted.
+bool PersistenceBinaryFromText(std::string_view text, std::string *binary);
+
+// Converts a binary level to text, the same as the game saves it. Returns 'false' if the level is malformed.
+bool PersistenceBinaryToText(const unsigned char *data, size_t size, std::string *text);
+
+// How many entities (and background layers) a binary level has, from its sections, without reading them.
+// Returns 0 if the level is malformed, which PersistenceBinaryRead() tells why.
+size_t PersistenceBinaryRecordCount(const unsigned char *data, size_t size);
+
+// Reads a binary level, calling onEntity for each entity. Returns 'false', logging why, if it's malformed.
+bool PersistenceBinaryRead(const unsigned char *data, size_t size, std::string_view *levelName,
+                            PersistenceBinaryEntityCallback onEntity, void *context);
@@ -0,0 +1,305 @@
+#include <raylib.h>
+#include <rlgl.h>
+#include <math.h>
+#include <algorithm>
+
+#include "post_process.hpp"
+#include "render_stats.hpp"
+
+
+// How much each frame weighs in the moving average of the frame time
+#define FRAME_TIME_SMOOTHING    0.1
+
+// Frame times are capped at this many target frame times, so a hitch (e.g. loading a level) doesn't skew the average
+#define FRAME_TIME_MAX_SAMPLE   4
+
+// Over this fraction of the target frame time the render scale goes down, and under this one it goes up
+#define FRAME_TIME_OVER_BUDGET  1.05
+#define FRAME_TIME_UNDER_BUDGET 0.75
+
+
+namespace Render {
+
+
+RenderTexture2D RenderTargetPool::Acquire(int width, int height) {
+
+    for (PooledTarget &pooled : targets) {
+        if (!pooled.isInUse && pooled.target.texture.width == width && pooled.target.texture.height == height) {
+            pooled.isInUse = true;
+            pooled.lastUsedFrame = frame;
+            return pooled.target;
+        }
+    }
+
+    RenderTexture2D target = LoadRenderTexture(width, height);
+    targets.push_back({ target, true, frame });
+
+    TraceLog(LOG_DEBUG, "Render target pool loaded a %dx%d target, %d in total.", width, height, (int) targets.size());
+
+    return target;
+}
+
+void RenderTargetPool::Release(RenderTexture2D target) {
+
+    for (PooledTarget &pooled : targets) {
+        if (pooled.target.id == target.id) {
+            pooled.isInUse = false;
+            return;
+        }
+    }
+
+    TraceLog(LOG_ERROR, "Render target pool was given back a target it doesn't have, id=%d.", target.id);
+}
+
+void RenderTargetPool::ReleaseIdle() {
+
+    frame++;
+
+    for (auto t = targets.begin(); t != targets.end();) {
+
+        if (!t->isInUse && frame - t->lastUsedFrame > RENDER_TARGET_IDLE_FRAMES) {
+
+            TraceLog(LOG_DEBUG, "Render target pool unloaded an idle %dx%d target.",
+                        t->target.texture.width, t->target.texture.height);
+
+            UnloadRenderTexture(t->target);
+            t = targets.erase(t);
+        }
+        else t++;
+    }
+}
+
+void RenderTargetPool::Clear() {
+
+    for (PooledTarget &pooled : targets) UnloadRenderTexture(pooled.target);
+
+    targets.clear();
+}
+
+int RenderTargetPool::Count() {
+    return targets.size();
+}
+
+void PostProcessChain::AddPass(PostProcessPass pass) {
+
+    passes.push_back(pass);
+}
+
+void PostProcessChain::BeginFrame() {
+
+    // The targets are sized after the screen, so they're useless once it changes
+    if (GetScreenWidth() != screenWidth || GetScreenHeight() != screenHeight) {
+
+        pool.Clear();
+
+        screenWidth = GetScreenWidth();
+        screenHeight = GetScreenHeight();
+    }
+
+    BeginDrawing();
+
+    isDrawingToTarget = std::any_of(passes.begin(), passes.end(), [](PostProcessPass &p) { return p.isEnabled(); });
+
+    if (!isDrawingToTarget) return;
+
+    frameTarget = pool.Acquire(screenWidth, screenHeight);
+
+    StatsTargetSwitch();
+    BeginTextureMode(frameTarget);
+}
+
+void PostProcessChain::BeginScene() {
+
+    isSceneScaled = renderScale != 1;
+
+    if (!isSceneScaled) return;
+
+    // Rounded up, so it covers the whole screen at the render scale
+    sceneTarget = pool.Acquire(ceilf(screenWidth * renderScale), ceilf(screenHeight * renderScale));
+
+    StatsTargetSwitch();
+    BeginTextureMode(sceneTarget);
+
+    ClearBackground(BLACK);
+
+    ApplyRenderScale();
+}
+
+void PostProcessChain::EndScene() {
+
+    if (!isSceneScaled) return;
+
+    // Back to where the frame is being drawn
+    StatsTargetSwitch();
+    EndTextureMode();
+    if (isDrawingToTarget) {
+        StatsTargetSwitch();
+        BeginTextureMode(frameTarget);
+    }
+
+    // The part of the target the screen was drawn in. The target is upside down, so it's at its bottom.
+    const float width = screenWidth * renderScale;
+    const float height = screenHeight * renderScale;
+    Rectangle source = { 0, sceneTarget.texture.height - height, width, -height };
+
+    DrawTexturePro(sceneTarget.texture, source, { 0, 0, (float) screenWidth, (float) screenHeight }, { 0, 0 }, 0, WHITE);
+
+    pool.Release(sceneTarget);
+
+    isSceneScaled = false;
+}
+
+void PostProcessChain::EndFrame() {
+
+    lastPassCount = 0;
+
+    if (!isDrawingToTarget) {
+        pool.ReleaseIdle();
+        StatsFlush();
+        EndDrawing();
+        return;
+    }
+
+    StatsTargetSwitch();
+    EndTextureMode();
+
+    enabledPasses.clear();
+    for (PostProcessPass &pass : passes) {
+        if (pass.isEnabled()) enabledPasses.push_back(&pass);
+    }
+
+    const Rectangle dest = { 0, 0, (float) screenWidth, (float) screenHeight };
+
+    RenderTexture2D input = frameTarget;
+
+    for (size_t i = 0; i < enabledPasses.size(); i++) {
+
+        // The last pass draws to the screen, and the others to the next target
+        if (i == enabledPasses.size() - 1) {
+            ClearBackground(BLACK);
+            enabledPasses[i]->apply(input.texture, dest);
+        }
+        else {
+            RenderTexture2D output = pool.Acquire(screenWidth, screenHeight);
+
+            StatsTargetSwitch();
+            BeginTextureMode(output);
+                ClearBackground(BLACK);
+                enabledPasses[i]->apply(input.texture, dest);
+            StatsTargetSwitch();
+            EndTextureMode();
+
+            pool.Release(input);
+            input = output;
+        }
+
+        lastPassCount++;
+    }
+
+    if (enabledPasses.empty()) {
+
+        // The passes that were enabled were done by the end of the frame (e.g. a finished transition)
+        ClearBackground(BLACK);
+        DrawTextureRec(input.texture, { 0, 0, (float) input.texture.width, (float) -input.texture.height }, { 0, 0 }, WHITE);
+    }
+
+    pool.Release(input);
+
+    pool.ReleaseIdle();
+
+    StatsFlush();
+    EndDrawing();
+}
+
+void PostProcessChain::ApplyRenderScale() {
+
+    if (isSceneScaled) rlScalef(renderScale, renderScale, 1);
+}
+
+Camera2D PostProcessChain::ScaleCamera(Camera2D camera) {
+
+    if (!isSceneScaled) return camera;
+
+    camera.offset = { camera.offset.x * renderScale, camera.offset.y * renderScale };
+    camera.zoom *= renderScale;
+
+    return camera;
+}
+
+void PostProcessChain::ReleaseTargets() {
+
+    pool.Clear();
+}
+
+void PostProcessChain::SetRenderScale(float scale) {
+
+    renderScale = std::clamp(scale, RENDER_SCALE_MIN, 1.0f);
+}
+
+float PostProcessChain::GetRenderScale() {
+    return renderScale;
+}
+
+int PostProcessChain::LastPassCount() {
+    return lastPassCount;
+}
+
+int PostProcessChain::TargetCount() {
+    return pool.Count();
+}
+
+void DynamicRenderScale::Configure(float minScale, float maxScale, double targetFrameTime) {
+
+    this->minScale = std::clamp(minScale, RENDER_SCALE_MIN, 1.0f);
+    this->maxScale = std::clamp(maxScale, this->minScale, 1.0f);
+    this->targetFrameTime = targetFrameTime;
+
+    TraceLog(LOG_INFO, "Dynamic render scale set from %.2f to %.2f, for frames of %.1f ms.",
+                this->minScale, this->maxScale, targetFrameTime * 1000);
+}
+
+float DynamicRenderScale::Update(double frameTime, float currentScale) {
+
+    frameTime = std::min(frameTime, targetFrameTime * FRAME_TIME_MAX_SAMPLE);
+
+    if (averageFrameTime == 0) averageFrameTime = targetFrameTime;
+    averageFrameTime += (frameTime - averageFrameTime) * FRAME_TIME_SMOOTHING;
+
+    float scale = std::clamp(currentScale, minScale, maxScale);
+
+    framesSinceChange++;
+    if (framesSinceChange < DYNAMIC_SCALE_COOLDOWN_FRAMES) return scale;
+
+    if (averageFrameTime > targetFrameTime * FRAME_TIME_OVER_BUDGET) {
+
+        // The cost of the scene goes with its pixel count, the square of the scale
+        float wanted = scale * sqrt(targetFrameTime / averageFrameTime);
+        scale = std::min(scale - DYNAMIC_SCALE_STEP, floorf(wanted / DYNAMIC_SCALE_STEP) * DYNAMIC_SCALE_STEP);
+    }
+    else if (averageFrameTime < targetFrameTime * FRAME_TIME_UNDER_BUDGET) {
+
+        // Goes back up slowly, so it doesn't go over budget again right away
+        scale += DYNAMIC_SCALE_STEP;
+    }
+
+    scale = std::clamp(roundf(scale / DYNAMIC_SCALE_STEP) * DYNAMIC_SCALE_STEP, minScale, maxScale);
+
+    if (scale != currentScale) framesSinceChange = 0;
+
+    return scale;
+}
+
+float DynamicRenderScale::MinScale() {
+    return minScale;
+}
+
+float DynamicRenderScale::MaxScale() {
+    return maxScale;
+}
+
+double DynamicRenderScale::AverageFrameTime() {
+    return averageFrameTime;
+}
+
+
+} // namespace
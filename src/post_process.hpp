@@ -0,0 +1,185 @@
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+
+namespace Render {
+
+
+// The lowest internal render scale, so the scene doesn't become a few pixels
+#define RENDER_SCALE_MIN    0.25f
+
+// How many frames a render target can go unused before it's unloaded
+#define RENDER_TARGET_IDLE_FRAMES   120
+
+// The frames the dynamic render scale waits after a change, for the frame time average to catch up
+#define DYNAMIC_SCALE_COOLDOWN_FRAMES   30
+
+// The render scale changes in steps of this, so it doesn't need a new render target every frame
+#define DYNAMIC_SCALE_STEP  0.05f
+
+
+// An effect applied to the whole frame after it's drawn
+typedef struct PostProcessPass {
+
+    const char *name;
+
+    // Checked every frame. Disabled passes are skipped, and don't need a render target.
+    bool (*isEnabled)();
+
+    // Draws the input, the frame so far, over dest in the current render target, with the effect applied.
+    // The input is a render texture, so it's upside down.
+    void (*apply)(Texture2D input, Rectangle dest);
+
+} PostProcessPass;
+
+
+/*
+    Keeps the render targets between frames, so they are loaded once and not every frame.
+    Targets not used for RENDER_TARGET_IDLE_FRAMES are unloaded, e.g. after the render scale changed.
+*/
+class RenderTargetPool {
+
+public:
+
+    // A target of these dimensions that's not in use, loading a new one if there's none
+    RenderTexture2D Acquire(int width, int height);
+
+    // Lets a target be acquired again
+    void Release(RenderTexture2D target);
+
+    // Unloads the targets that weren't used in a while. Called once per frame.
+    void ReleaseIdle();
+
+    // Unloads all targets
+    void Clear();
+
+    // How many targets are loaded
+    int Count();
+
+private:
+
+    typedef struct PooledTarget {
+        RenderTexture2D target;
+        bool isInUse;
+        long lastUsedFrame;
+    } PooledTarget;
+
+    std::vector<PooledTarget> targets;
+
+    long frame = 0;
+};
+
+
+/*
+    Draws the frame into a render target, then runs it through the enabled passes,
+    in the order they were added, and onto the screen.
+
+    The scene, between BeginScene() and EndScene(), is drawn at the internal render scale
+    and upscaled into the frame, and what's drawn after it (e.g. the HUD) at the screen's resolution.
+    Either way, everything is drawn in screen coordinates.
+
+    If no pass is enabled the frame is drawn straight to the screen, and if the render scale is 1 so is the scene.
+*/
+class PostProcessChain {
+
+public:
+
+    void AddPass(PostProcessPass pass);
+
+    // Starts drawing a frame, in place of BeginDrawing()
+    void BeginFrame();
+
+    // Starts drawing the scene, at the render scale
+    void BeginScene();
+
+    // Puts the scene in the frame
+    void EndScene();
+
+    // Applies the passes and shows the frame, in place of EndDrawing()
+    void EndFrame();
+
+    // Scales what's drawn next in the scene to the render scale, so it can still be drawn in screen coordinates.
+    // Must be called again after EndMode2D(), as it resets the scaling.
+    void ApplyRenderScale();
+
+    // The camera, scaled to the render scale, for BeginMode2D() in the scene
+    Camera2D ScaleCamera(Camera2D camera);
+
+    // Unloads the render targets, to be loaded again when needed. Not to be called mid-frame.
+    void ReleaseTargets();
+
+    // The resolution the scene is drawn in, relative to the screen's. From RENDER_SCALE_MIN to 1.
+    void SetRenderScale(float scale);
+    float GetRenderScale();
+
+    // How many passes were applied to the last frame
+    int LastPassCount();
+
+    // How many render targets are loaded
+    int TargetCount();
+
+private:
+
+    std::vector<PostProcessPass> passes;
+
+    // The passes enabled this frame
+    std::vector<PostProcessPass *> enabledPasses;
+
+    RenderTargetPool pool;
+
+    float renderScale = 1;
+
+    // What the pool's targets were sized after
+    int screenWidth = 0;
+    int screenHeight = 0;
+
+    // The target the frame is being drawn in, if it's not drawn straight to the screen
+    bool isDrawingToTarget = false;
+    RenderTexture2D frameTarget = {};
+
+    // The target the scene is being drawn in, if it's scaled
+    bool isSceneScaled = false;
+    RenderTexture2D sceneTarget = {};
+
+    int lastPassCount = 0;
+};
+
+
+/*
+    Picks the render scale from how long the frames are taking, lowering it when they're
+    over the target frame time and raising it back when there's time to spare.
+
+    The frame time is measured from the start of a frame to its buffer swap, so it covers
+    both the CPU and the GPU work, but not the wait for the frame rate cap.
+*/
+class DynamicRenderScale {
+
+public:
+
+    // The bounds of the render scale, and the frame time it's trying to keep under, in seconds
+    void Configure(float minScale, float maxScale, double targetFrameTime);
+
+    // The render scale to use, given how long the last frame took and the current scale
+    float Update(double frameTime, float currentScale);
+
+    float MinScale();
+    float MaxScale();
+
+    // The moving average of the frame time, in seconds
+    double AverageFrameTime();
+
+private:
+
+    float minScale = RENDER_SCALE_MIN;
+    float maxScale = 1;
+    double targetFrameTime = 1.0 / 60;
+
+    double averageFrameTime = 0;
+
+    int framesSinceChange = 0;
+};
+
+
+} // namespace
@@ -1,9 +1,12 @@
 #include <raylib.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
+#include <algorithm>
 
 #include "core.hpp"
 #include "assets.hpp"
+#include "frontend.hpp"
 #include "level/level.hpp"
 #include "level/player.hpp"
 #include "level/textbox.hpp"
@@ -13,6 +16,11 @@
 #include "debug.hpp"
 #include "input.hpp"
 #include "menu.hpp"
+#include "render_queue.hpp"
+#include "post_process.hpp"
+#include "text_cache.hpp"
+#include "render_stats.hpp"
+#include "background.hpp"
 
 #pragma GCC diagnostic push 
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -28,8 +36,22 @@
 #define FIRST_LAYER -1
 #define LAST_LAYER  1
 
+// Drawn over every level layer
+#define EDITOR_GHOST_LAYER (LAST_LAYER + 1)
+
+// The layer of the level's tiles
+#define TILEMAP_LAYER 0
+
 #define SYS_MESSAGE_SECONDS 2
 
+#define MENU_ORIGIN                 (float)GetScreenWidth()/2-70, 360
+
+#define MENU_HEADER_FONT_SIZE       30
+#define MENU_LABEL_FONT_SIZE        20
+
+#define MENU_SPACING_HEADER_BODY    100
+#define MENU_SPACING_LABELS         50
+
 
 namespace Render {
 
@@ -55,17 +77,44 @@ bool isFullscreen = false;
 bool isCrtEnabled = true;
 
 
-// Texture covering the whole screen, used to render shaders
-RenderTexture2D levelTransitionShaderTexture;
-RenderTexture2D crtShaderTexture;
 LevelTransitionShaderControl levelTransitionShaderControl;
 
+// The effects applied to the whole frame, and the render targets they use
+static PostProcessChain postProcess;
+
+static DynamicRenderScale dynamicScale;
+static bool isDynamicResolutionEnabled = true;
+
+// Frames per second, or 0 if uncapped
+static int frameRateCap = DEFAULT_FRAME_RATE_CAP;
+
+// When the last frame's wait ended, and how long the frame took before it, in seconds
+static double frameStartTime = 0;
+static double frameWorkTime = 0;
+
+// The texts drawn recently, already laid out
+static TextCache textCache;
+
+// The level's background layers, baked, and the Background::Version() they were baked from
+static std::vector<Texture2D> backgroundTextures;
+static long backgroundVersion = -1;
 
-void reloadShaders() {
-    levelTransitionShaderTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-    crtShaderTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+// The level entities on the screen this frame
+static std::vector<Level::Entity *> visibleEntities;
 
-    ShaderCrtSetUniforms();
+// The draw calls of the level entities, while they're being drawn
+static RenderQueue levelQueue;
+
+// The level's tilemap chunks, one pixel per cell, as they were last uploaded. In the order of Tilemap::Chunks().
+static std::vector<Texture2D> tilemapTextures;
+
+// Reused when uploading the changed cells of the tilemap
+static std::vector<Level::TilemapCell> tilemapUploadBuffer;
+
+
+// The targets are loaded again, at the new screen size, in the next frame
+void releaseRenderTargets() {
+    postProcess.ReleaseTargets();
 }
 
 
@@ -90,7 +139,7 @@ static void handleFullscreenChange() {
 
     if (framesSinceFullscreenChange == 1) {
         CameraAdjustForFullscreen(isFullscreen);
-        reloadShaders();
+        releaseRenderTargets();
         framesSinceFullscreenChange = -1;
     }
 
@@ -102,7 +151,8 @@ void drawTextboxContent(Textbox *box) {
     if (box->isDevTextbox && !IsDevTextboxEnabled()) return;
 
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), { 0x00, 0x00, 0x00, 0xBB });
-    DrawText((box->textContent).c_str(), CAMERA->sceneXOffset + 120, 100, 30, box->isDevTextbox ? GREEN : RAYWHITE);
+    // Laid out the first frame it's shown, and kept in the cache while it is
+    DrawTextRun(textCache.Get(box->textContent, TEXTBOX_FONT_SIZE), { (float) CAMERA->sceneXOffset + 120, 100 }, box->isDevTextbox ? GREEN : RAYWHITE);
 } 
 
 // Returns the given color, with the given transparency level. 
@@ -112,15 +162,6 @@ Color getColorTransparency(Color color, int transparency) {
                 (unsigned char) transparency };
 }
 
-// Draws rectangle with scene-based position
-void drawSceneRectangle(Rectangle rect, Color color) {
-
-    Vector2 scenePos = PosInSceneToScreen({ rect.x, rect.y });
-    Dimensions sceneDim = DimensionsInSceneToScreen({ rect.width, rect.height });
-    Rectangle screenRect = { scenePos.x, scenePos.y, sceneDim.width, sceneDim.height };
-    DrawRectangleRec(screenRect, color);
-}
-
 // So the scene maintains the screen ratio in an ultrawide screen
 void drawFullScreenBlackbars() {
 
@@ -132,40 +173,96 @@ void drawFullScreenBlackbars() {
     DrawRectangleRec(rightBar, BLACK);
 }
 
-// Draws sprite in the background, with effects applied.
-void drawSpriteInBackground(Sprite *sprite, Vector2 pos, int layer) {
+// Draws a sprite straight to the screen, outside of the level queue, like raylib's DrawTextureEx()
+static void drawSprite(Sprite *sprite, Vector2 pos, float scale, Color tint) {
 
-    float scale = 1;
-    Color tint = { 0xFF, 0xFF, 0xFF, 0xFF };
-    float parallaxSpeed = 1;
+    Rectangle dest = {
+        pos.x,
+        pos.y,
+        sprite->source.width * scale,
+        sprite->source.height * scale
+    };
 
-    switch (layer) {
+    DrawTexturePro(sprite->atlas, sprite->source, dest, { 0, 0 }, 0, tint);
+}
 
-    case -1:
-        scale = 0.7;
-        tint = { 0xFF, 0xFF, 0xFF, 0x88 };
-        parallaxSpeed = 0.4;
-        break;
+// Loads the layer's image into a texture, scaled and tinted, so drawing it takes no more than a quad
+static Texture2D bakeBackgroundLayer(const Background::Layer &layer) {
 
-    case -2:
-        scale = 0.3;
-        tint = { 0xFF, 0xFF, 0xFF, 0x44 };
-        parallaxSpeed = 0.25;
-        break;
+    std::string path = BACKGROUND_IMAGES_DIR + layer.image;
 
-    default:
-        TraceLog(LOG_ERROR, "No code found for drawing in the bg layer %d.", layer);
-        return;
+    Image image = LoadImage(path.c_str());
+    if (!image.data) {
+        TraceLog(LOG_ERROR, "Couldn't read background layer image %s.", path.c_str());
+        return {};
+    }
+
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    // Nearest neighbor, as the sprites are drawn
+    ImageResizeNN(&image, image.width * layer.scale, image.height * layer.scale);
+    ImageColorTint(&image, layer.tint);
+
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    SetTextureWrap(texture, TEXTURE_WRAP_REPEAT);
+
+    return texture;
+}
+
+// Bakes the layers again if they changed since they were last baked
+static void syncBackgroundTextures() {
+
+    if (backgroundVersion == Background::Version()) return;
+
+    for (Texture2D &texture : backgroundTextures) {
+        if (texture.id) UnloadTexture(texture);
     }
+    backgroundTextures.clear();
+
+    for (const Background::Layer &layer : Background::Layers()) backgroundTextures.push_back(bakeBackgroundLayer(layer));
+
+    backgroundVersion = Background::Version();
+}
+
+// Draws a background layer as a single quad, covering the view if it repeats, with the layer's own camera
+static void drawBackgroundLayer(const Background::Layer &layer, Texture2D texture) {
+
+    if (!texture.id) return;
 
-    scale = ScaleInSceneToScreen(scale);
+    // Each layer moves at its own speed, so it has its own camera
+    Camera2D camera = CameraSceneCamera2D(layer.parallax);
 
-    pos.x = pos.x * scale;
-    pos.y = pos.y * scale;
+    // What the screen shows, in the layer's coordinates
+    Rectangle view = {
+        camera.target.x - camera.offset.x / camera.zoom,
+        camera.target.y - camera.offset.y / camera.zoom,
+        GetScreenWidth() / camera.zoom,
+        GetScreenHeight() / camera.zoom
+    };
+
+    Rectangle dest = { layer.pos.x, layer.pos.y, (float) texture.width, (float) texture.height };
+
+    if (layer.repeat != Background::LAYER_REPEAT_NONE) {
+        dest.x = view.x;
+        dest.width = view.width;
+    }
+
+    if (layer.repeat == Background::LAYER_REPEAT_XY) {
+        dest.y = view.y;
+        dest.height = view.height;
+    }
 
-    pos = PosInSceneToScreenParallax(pos, parallaxSpeed);
+    // Past the image's edges, the texture wraps around
+    Rectangle source = { dest.x - layer.pos.x, dest.y - layer.pos.y, dest.width, dest.height };
 
-    DrawTextureEx(sprite->sprite, pos, 0, (scale * sprite->scale), tint);
+    StatsFlush();
+    BeginMode2D(postProcess.ScaleCamera(camera));
+        DrawTexturePro(texture, source, dest, { 0, 0 }, 0, WHITE);
+    StatsFlush();
+    EndMode2D();
+    postProcess.ApplyRenderScale();
 }
 
 void drawBackground() {
@@ -187,18 +284,18 @@ void drawBackground() {
         DrawRectangle(0, levelBottomOnScreen.y, GetScreenWidth(), GetScreenHeight(), BLACK);
 
         if (!GAME_STATE->showBackground) return; 
-        drawSpriteInBackground(&SPRITES->Nightclub,   { 1250, 250 },    -1);
-        drawSpriteInBackground(&SPRITES->BGHouse,     { 600, 300 },     -2);
+
+        // Declared by the level
+        syncBackgroundTextures();
+
+        const std::vector<Background::Layer> &layers = Background::Layers();
+        for (size_t i = 0; i < layers.size(); i++) drawBackgroundLayer(layers[i], backgroundTextures[i]);
     }
 }
 
 void drawOverworldEntity(OverworldEntity *entity) {
 
-    Vector2 pos = PosInSceneToScreen({
-                                        entity->gridPos.x,
-                                        entity->gridPos.y });
-
-    DrawTexture(entity->sprite, { pos.x, pos.y }, WHITE, entity->rotation, false);
+    DrawTexture(entity->sprite, entity->gridPos, WHITE, entity->rotation, false);
 }
 
 // Draws the ghost of an editor's selected entity being moved
@@ -208,42 +305,218 @@ void drawOverworldEntityMoveGhost(OverworldEntity *entity) {
                                                     entity->gridPos.x,
                                                     entity->gridPos.y });
 
-    pos = PosInSceneToScreen(pos);
-
     Color color =  { WHITE.r, WHITE.g, WHITE.b,
                             EDITOR_SELECTION_MOVE_TRANSPARENCY };
 
     DrawTexture(entity->sprite, pos, color, entity->rotation, false);
 }
 
-void drawEntities() {
+// Uploads what changed in the level's tilemap since the last frame
+static void uploadTilemap() {
 
-    for (int layer = FIRST_LAYER; layer <= LAST_LAYER; layer++) {
+    Level::Tilemap &tilemap = Level::GetTilemap();
+    const std::vector<Level::TilemapChunk> &chunks = tilemap.Chunks();
+
+    if (tilemap.WasCleared()) {
+        for (Texture2D &texture : tilemapTextures) UnloadTexture(texture);
+        tilemapTextures.clear();
+    }
+
+    // Only the cells that changed, in the chunks that were already uploaded
+    for (int index : tilemap.DirtyChunks()) {
+
+        if (index >= (int) tilemapTextures.size()) continue;
+
+        const Level::TilemapChunk &chunk = chunks[index];
+        const Level::CellRange dirty = chunk.dirtyCells;
+        const int width = dirty.x1 - dirty.x0 + 1;
+        const int height = dirty.y1 - dirty.y0 + 1;
+
+        tilemapUploadBuffer.resize(width * height);
+        for (int row = 0; row < height; row++) {
+            const Level::TilemapCell *src = &chunk.cells[(dirty.y0 - chunk.y + row) * TILEMAP_CHUNK_SIDE + (dirty.x0 - chunk.x)];
+            std::copy_n(src, width, &tilemapUploadBuffer[row * width]);
+        }
+
+        Rectangle rect = { (float) dirty.x0 - chunk.x, (float) dirty.y0 - chunk.y, (float) width, (float) height };
+        UpdateTextureRec(tilemapTextures[index], rect, tilemapUploadBuffer.data());
+    }
+
+    // The new chunks, whole
+    for (size_t i = tilemapTextures.size(); i < chunks.size(); i++) {
+        Image image = { (void *) chunks[i].cells.data(), TILEMAP_CHUNK_SIDE, TILEMAP_CHUNK_SIDE, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        tilemapTextures.push_back(LoadTextureFromImage(image));
+    }
+
+    tilemap.ClearChanges();
+}
+
+// Draws the level's tiles on the screen in a single quad per chunk on the screen, whatever the number of tiles
+static void drawTilemap() {
+
+    uploadTilemap();
+
+    Level::Tilemap &tilemap = Level::GetTilemap();
+    if (tilemapTextures.empty() || tilemap.TileSprites().empty()) return;
+
+    const Level::CellRange view = Level::CellRangeOf(CameraSceneView());
+    const Dimensions grid = LEVEL_GRID;
+    const std::vector<Sprite *> &tileSprites = tilemap.TileSprites();
+    const std::vector<Level::TilemapChunk> &chunks = tilemap.Chunks();
+
+    StatsFlush();
+    BeginShaderMode(ShaderTilemap);
+
+        ShaderTilemapSetUniforms(tileSprites[0]->atlas, { TILEMAP_CHUNK_SIDE, TILEMAP_CHUNK_SIDE },
+                                    tileSprites.data(), tileSprites.size());
+
+        for (size_t i = 0; i < chunks.size(); i++) {
+
+            // The chunk's visible cells
+            Level::CellRange cells = view;
+            cells.x0 = std::max(cells.x0, chunks[i].x);
+            cells.y0 = std::max(cells.y0, chunks[i].y);
+            cells.x1 = std::min(cells.x1, chunks[i].x + TILEMAP_CHUNK_SIDE - 1);
+            cells.y1 = std::min(cells.y1, chunks[i].y + TILEMAP_CHUNK_SIDE - 1);
+            if (cells.x0 > cells.x1 || cells.y0 > cells.y1) continue;
+
+            const float columns = cells.x1 - cells.x0 + 1;
+            const float rows = cells.y1 - cells.y0 + 1;
+
+            Rectangle source = { (float) cells.x0 - chunks[i].x, (float) cells.y0 - chunks[i].y, columns, rows };
+
+            Rectangle dest = { cells.x0 * grid.width, cells.y0 * grid.height, columns * grid.width, rows * grid.height };
+
+            DrawTexturePro(tilemapTextures[i], source, dest, { 0, 0 }, 0, WHITE);
+        }
+
+    StatsFlush();
+    EndShaderMode();
+}
+
+// Collects the level entities on the screen into visibleEntities
+static void cullLevelEntities() {
 
-        LinkedList::Node *node = GetEntityListHead();
+    Rectangle view = CameraSceneView();
 
-        while (node != 0) {
+    // Some sprites are a bit larger than their hitboxes
+    const Dimensions margin = LEVEL_GRID;
+    view = { view.x - margin.width, view.y - margin.height,
+                view.width + margin.width * 2, view.height + margin.height * 2 };
 
-            if (GAME_STATE->mode == MODE_IN_LEVEL) {
+    visibleEntities.clear();
+
+    for (Level::Entity *entity : Level::EntitiesNear(view)) {
+
+        // The editor shows everything, the game doesn't show what's asleep
+        if (entity->isAsleep && !EDITOR_STATE->isEnabled) continue;
+
+        visibleEntities.push_back(entity);
+    }
+}
 
-                Level::Entity *entity = (Level::Entity *) node;
-                if (entity->layer != layer) goto next_entity;                
-                entity->Draw();
+// Queued with the level entities while they're being drawn, like DrawSceneLine()
+static void drawSceneRectangle(Rectangle rect, Color color) {
+
+    if (levelQueue.IsOpen()) {
+        levelQueue.AddRectangle(rect, color);
+        return;
+    }
+
+    DrawRectangleRec(rect, color);
+}
+
+// The selected entities, or their ghosts while they're being moved. In a level, inside the level's queue.
+void drawEditorEntitySelection() {
+
+    if (EDITOR_STATE->isSelectingEntities)
+        drawSceneRectangle(EditorSelectionGetRect(), EDITOR_SELECTION_RECT_COLOR);
+
+    const Color color = EDITOR_SELECTION_ENTITY_COLOR;
+
+    if (GAME_STATE->mode == MODE_IN_LEVEL) {
+
+        for (auto e = EDITOR_STATE->selectedEntities.begin(); e < EDITOR_STATE->selectedEntities.end(); e++) {
+
+            Level::Entity *entity = Level::EntityGet(*e);
+            if (!entity) continue; // it's gone
+
+            if (EDITOR_STATE->isMovingSelectedEntities) {
+                entity->DrawMoveGhost();
+            } else {
+                if (!entity->IsDisabled()) drawSceneRectangle(entity->hitbox, color);
+                drawSceneRectangle(entity->GetOriginHitbox(), color);
             }
+        }
+    }
 
-            else if (GAME_STATE->mode == MODE_OVERWORLD) {
+    else if (GAME_STATE->mode == MODE_OVERWORLD) {
 
-                OverworldEntity *entity = (OverworldEntity *) node;
-                if (entity->layer != layer) goto next_entity;
-                drawOverworldEntity(entity);
+        for (auto e = EDITOR_STATE->selectedOverworldEntities.begin(); e < EDITOR_STATE->selectedOverworldEntities.end(); e++) {
+
+            OverworldEntity *entity = (OverworldEntity *) *e;
+
+            if (EDITOR_STATE->isMovingSelectedEntities) {
+                drawOverworldEntityMoveGhost(entity);
+            } else {
+                drawSceneRectangle(OverworldEntitySquare(entity), color);
             }
+        }
+    }
+}
+
+void drawEntities() {
+
+    if (GAME_STATE->mode == MODE_IN_LEVEL) {
+
+        cullLevelEntities();
 
-            else return;
+        // The queue takes care of the layers
+        levelQueue.Begin();
 
-next_entity:
-            node = node->next;
+        levelQueue.SetLayer(TILEMAP_LAYER);
+        levelQueue.AddCallback(drawTilemap);
+
+        for (Level::Entity *entity : visibleEntities) {
+
+            if (entity->layer < FIRST_LAYER || entity->layer > LAST_LAYER) continue;
+
+            if (entity->isInTilemap) continue; // drawn by drawTilemap()
+
+            levelQueue.SetLayer(entity->layer);
+            entity->Draw();
         }
+
+        if (EDITOR_STATE->isEnabled) {
+            levelQueue.SetLayer(EDITOR_GHOST_LAYER);
+            drawEditorEntitySelection();
+        }
+
+        levelQueue.Submit();
+
+        StatsSetEntities(visibleEntities.size(), Level::ENTITIES.Count() - visibleEntities.size());
+
+        return;
+    }
+
+    for (int layer = FIRST_LAYER; layer <= LAST_LAYER; layer++) {
+
+        if (GAME_STATE->mode == MODE_OVERWORLD) {
+
+            for (LinkedList::Node *node = OW_STATE->listHead; node != 0; node = node->next) {
+
+                OverworldEntity *entity = (OverworldEntity *) node;
+                if (entity->layer == layer) drawOverworldEntity(entity);
+            }
+
+            // The overworld is small enough to always be drawn whole
+            if (layer == FIRST_LAYER) StatsSetEntities(LinkedList::CountNodes(OW_STATE->listHead), 0);
+        }
+
+        else return;
     }
+
+    if (EDITOR_STATE->isEnabled) drawEditorEntitySelection();
 }
 
 void drawSysMessages() {
@@ -266,7 +539,7 @@ void drawSysMessages() {
         x = 15;
         y = GetScreenHeight() - 15 - (30 * currentMsg);
 
-        DrawText(msg->msg, x, y, 30, RAYWHITE);
+        textCache.Draw(msg->msg, x, y, 30, RAYWHITE);
         
         currentMsg++;
         msg->secondsUntilDisappear -= GetFrameTime();
@@ -287,7 +560,7 @@ void drawDebugGrid() {
     else if (GAME_STATE->mode == MODE_IN_LEVEL) grid = LEVEL_GRID;
     else return;
 
-    Vector2 offset = DistanceFromGrid(CAMERA->pos, grid);
+    Vector2 offset = DistanceFromGrid(CAMERA->renderPos, grid);
 
     for (float lineX = offset.x; lineX <= GetScreenWidth(); lineX += grid.width) {
         DrawLine(lineX, 0, lineX, GetScreenHeight(), BLUE);
@@ -302,23 +575,24 @@ void drawLevelHud() {
 
     if (EDITOR_STATE->isEnabled) return;
 
-    DrawTextureEx(SPRITES->LevelCheckpointFlag.sprite,
+    drawSprite(&SPRITES->LevelCheckpointFlag,
                     { (float) CAMERA->sceneXOffset + 100, (float)GetScreenHeight()-65 },
-                        0, SPRITES->LevelCheckpointFlag.scale/1.7, WHITE);
-    DrawText(std::string("x " + std::to_string(Level::STATE->checkpointsLeft)).c_str(),
-                CAMERA->sceneXOffset + 149, GetScreenHeight() - 56, 30, RAYWHITE);
+                        SPRITES->LevelCheckpointFlag.scale/1.7, WHITE);
+    char buffer[20];
+    snprintf(buffer, sizeof(buffer), "x %d", Level::STATE->checkpointsLeft);
+    textCache.Draw(buffer, CAMERA->sceneXOffset + 149, GetScreenHeight() - 56, 30, RAYWHITE);
 
-    DrawTextureEx(SPRITES->Coin1.sprite,
+    drawSprite(&SPRITES->Coin1,
                     { (float) CAMERA->sceneXOffset + 222, (float)GetScreenHeight()-54 },
-                        0, SPRITES->Coin1.scale, WHITE);
-    DrawText(std::string("x " + std::to_string(GAME_STATE->coinsCollected)).c_str(),
-                CAMERA->sceneXOffset + 259, GetScreenHeight() - 56, 30, RAYWHITE);
+                        SPRITES->Coin1.scale, WHITE);
+    snprintf(buffer, sizeof(buffer), "x %d", GAME_STATE->coinsCollected);
+    textCache.Draw(buffer, CAMERA->sceneXOffset + 259, GetScreenHeight() - 56, 30, RAYWHITE);
         
     if (PLAYER && PLAYER->isDead)
-        DrawText("VOCÊ MORREU", GetScreenWidth()/2-200, 330, 60, RAYWHITE);
+        textCache.Draw("VOCÊ MORREU", GetScreenWidth()/2-200, 330, 60, RAYWHITE);
     
     if (Level::STATE->levelName[0] == '\0')
-        DrawText("Arraste uma fase para cá", GetScreenWidth()/2-300, 350, 40, RAYWHITE);
+        textCache.Draw("Arraste uma fase para cá", GetScreenWidth()/2-300, 350, 40, RAYWHITE);
 }
 
 void drawOverworldHud() {
@@ -330,7 +604,7 @@ void drawOverworldHud() {
         // Draw level name
 
         Vector2 pos = PosInSceneToScreen({ tile->gridPos.x - 20,
-                            tile->gridPos.y + (tile->sprite->sprite.height * tile->sprite->scale) });
+                            tile->gridPos.y + (tile->sprite->source.height * tile->sprite->scale) });
 
         char levelName[LEVEL_NAME_BUFFER_SIZE];
 
@@ -341,33 +615,14 @@ void drawOverworldHud() {
 
         else strcpy(levelName, "[sem fase]");
 
-        DrawText(levelName, pos.x, pos.y, 20, RAYWHITE);
+        textCache.Draw(levelName, pos.x, pos.y, 20, RAYWHITE);
     }
 }
 
-void drawDebugEntityInfo(LinkedList::Node *entity) {
+void drawDebugEntityInfo(Rectangle hitbox, const std::string &str) {
 
-    Rectangle hitbox;
     Vector2 screenPos;
     Dimensions screenDim;
-    std::string str;
-
-    switch (GAME_STATE->mode) {
-    case MODE_IN_LEVEL:
-        hitbox = ((Level::Entity *) entity)->hitbox;
-        str = ((Level::Entity *) entity)->GetEntityDebugString();
-        break;
-
-    case MODE_OVERWORLD:
-        RectangleSetPos(&hitbox, ((OverworldEntity *) entity)->gridPos);
-        RectangleSetDimensions(&hitbox, OW_GRID);
-        str = std::string("x=" + std::to_string((int) hitbox.x) +
-                            "\ny=" + std::to_string((int) hitbox.y)); // TODO create Overworld Entity
-        break;
-
-    default:
-        return;
-    }
 
     screenPos = PosInSceneToScreen(RectangleGetPos(hitbox));
     screenDim = DimensionsInSceneToScreen({ hitbox.width, hitbox.height });
@@ -377,33 +632,117 @@ void drawDebugEntityInfo(LinkedList::Node *entity) {
     DrawRectangleLines(screenPos.x, screenPos.y,
             screenDim.width, screenDim.height, GREEN);
 
-    DrawText(str.c_str(), screenPos.x, screenPos.y, 20, WHITE);
+    textCache.Draw(str, screenPos.x, screenPos.y, 20, WHITE);
 }
 
 void drawDebugHud() {
 
-    if (CameraIsPanned()) DrawText("Câmera deslocada",
+    if (CameraIsPanned()) textCache.Draw("Câmera deslocada",
                                     GetScreenWidth() - 300, GetScreenHeight() - 45, 30, RAYWHITE);
 
-    LinkedList::Node *listHead = GetEntityListHead();
-    if (listHead) {
-        char buffer[50];
-        sprintf(buffer, "%d entidades", LinkedList::CountNodes(listHead));
-        DrawText(buffer, 10, 20, 20, WHITE);
+    int entityCount = -1;
+    if (GAME_STATE->mode == MODE_IN_LEVEL) entityCount = Level::ENTITIES.Count();
+    else if (GAME_STATE->mode == MODE_OVERWORLD) entityCount = LinkedList::CountNodes(OW_STATE->listHead);
+
+    if (entityCount > 0) {
+        char buffer[100];
+        if (GAME_STATE->mode == MODE_IN_LEVEL)
+            sprintf(buffer, "%d entidades (%d atualizadas, %d visíveis)", entityCount,
+                        (int) Level::TickedEntitiesCount(), (int) visibleEntities.size());
+        else
+            sprintf(buffer, "%d entidades", entityCount);
+        textCache.Draw(buffer, 10, 20, 20, WHITE);
+    }
+
+    if (GAME_STATE->mode == MODE_IN_LEVEL) {
+
+        // Allocations per entity type
+        int y = 45;
+        for (Level::EntityPool *pool : Level::EntityPools()) {
+
+            if (!pool->ReservedBytes()) continue;
+
+            char buffer[100];
+            snprintf(buffer, sizeof(buffer), "%s: %zu (%zu alocações, %.1f/%.1f KB)", pool->typeName.c_str(), pool->liveCount,
+                        pool->allocationCount, pool->LiveBytes() / 1024.0f, pool->ReservedBytes() / 1024.0f);
+            textCache.Draw(buffer, 10, y, 10, WHITE);
+
+            y += 12;
+        }
     }
 
-    DrawText((std::to_string(GetFPS()) + " FPS").c_str(), GetScreenWidth() - 100, 20, 20, WHITE);
+    {
+        char buffer[100];
+        snprintf(buffer, sizeof(buffer), "%d FPS", GetFPS());
+        textCache.Draw(buffer, GetScreenWidth() - 100, 20, 20, WHITE);
+
+        snprintf(buffer, sizeof(buffer), "Resolução %.0f%% (%.1f ms), %d efeitos, %d alvos de renderização",
+                    postProcess.GetRenderScale() * 100, dynamicScale.AverageFrameTime() * 1000,
+                    postProcess.LastPassCount(), postProcess.TargetCount());
+        textCache.Draw(buffer, GetScreenWidth() - textCache.Get(buffer, 20).size.x - 10, 45, 20, WHITE);
+
+        // Texts laid out last frame, i.e. that changed
+        snprintf(buffer, sizeof(buffer), "%d textos em cache (%d novos)", textCache.Count(), textCache.LastLayoutCount());
+        textCache.Draw(buffer, GetScreenWidth() - textCache.Get(buffer, 20).size.x - 10, 70, 20, WHITE);
+    }
+
+    {
+        // The last frame's, as this one isn't done yet
+        const RenderStats &stats = LastFrameStats();
+        char buffer[120];
+        int y = 95;
+
+        snprintf(buffer, sizeof(buffer), "%d chamadas de desenho, %d descargas do lote, %d trocas de textura",
+                    stats.drawCalls, stats.batchFlushes, stats.textureSwitches);
+        textCache.Draw(buffer, GetScreenWidth() - textCache.Get(buffer, 20).size.x - 10, y, 20, WHITE);
+        y += 25;
+
+        snprintf(buffer, sizeof(buffer), "%d vértices, %d trocas de alvo de renderização",
+                    stats.vertices, stats.renderTargetSwitches);
+        textCache.Draw(buffer, GetScreenWidth() - textCache.Get(buffer, 20).size.x - 10, y, 20, WHITE);
+        y += 25;
+
+        snprintf(buffer, sizeof(buffer), "%d entidades desenhadas, %d descartadas", stats.entitiesDrawn, stats.entitiesCulled);
+        textCache.Draw(buffer, GetScreenWidth() - textCache.Get(buffer, 20).size.x - 10, y, 20, WHITE);
+        y += 25;
+
+        snprintf(buffer, sizeof(buffer), "Fundo %.2f ms, entidades %.2f ms, HUD %.2f ms, efeitos %.2f ms%s",
+                    stats.phaseTime[RENDER_PHASE_BACKGROUND] * 1000, stats.phaseTime[RENDER_PHASE_ENTITIES] * 1000,
+                    stats.phaseTime[RENDER_PHASE_HUD] * 1000, stats.phaseTime[RENDER_PHASE_POST_PROCESS] * 1000,
+                    IsDumpingStats() ? " (salvando)" : "");
+        textCache.Draw(buffer, GetScreenWidth() - textCache.Get(buffer, 20).size.x - 10, y, 20, WHITE);
+    }
 
     if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
         Vector2 mousePos = GetMousePosition();
         Vector2 mousePosScene = PosInScreenToScene(mousePos); 
         char buffer[50];
         sprintf(buffer, "Tela: x=%.0f, y=%.0f; Cena: x=%.0f, y=%.0f", mousePos.x, mousePos.y, mousePosScene.x, mousePosScene.y);
-        DrawText(buffer, 600, 20, 20, WHITE);
+        textCache.Draw(buffer, 600, 20, 20, WHITE);
     }
 
-    for (auto e = DEBUG_ENTITY_INFO_HEAD.begin(); e < DEBUG_ENTITY_INFO_HEAD.end(); e++) {
-        drawDebugEntityInfo(*e);
+    if (GAME_STATE->mode == MODE_IN_LEVEL) {
+
+        for (auto e = DEBUG_ENTITY_INFO_HEAD.begin(); e < DEBUG_ENTITY_INFO_HEAD.end(); e++) {
+
+            Level::Entity *entity = Level::EntityGet(*e);
+            if (!entity) continue; // it's gone
+
+            drawDebugEntityInfo(entity->hitbox, entity->GetEntityDebugString());
+        }
+    }
+
+    else if (GAME_STATE->mode == MODE_OVERWORLD) {
+
+        for (auto e = DEBUG_OW_ENTITY_INFO_HEAD.begin(); e < DEBUG_OW_ENTITY_INFO_HEAD.end(); e++) {
+
+            Rectangle hitbox;
+            RectangleSetPos(&hitbox, ((OverworldEntity *) *e)->gridPos);
+            RectangleSetDimensions(&hitbox, OW_GRID);
+
+            drawDebugEntityInfo(hitbox, std::string("x=" + std::to_string((int) hitbox.x) +
+                                                    "\ny=" + std::to_string((int) hitbox.y))); // TODO create Overworld Entity
+        }
     }
 }
 
@@ -464,41 +803,6 @@ next_button:
     }
 }
 
-void drawEditorEntitySelection() {
-
-    if (EDITOR_STATE->isSelectingEntities)
-        drawSceneRectangle(EditorSelectionGetRect(), EDITOR_SELECTION_RECT_COLOR);
-
-    for (auto e = EDITOR_STATE->selectedEntities.begin(); e < EDITOR_STATE->selectedEntities.end(); e++) {
-
-        const Color color = EDITOR_SELECTION_ENTITY_COLOR;
-
-        if (GAME_STATE->mode == MODE_IN_LEVEL) {
-
-            Level::Entity *entity = (Level::Entity *) *e;
-
-            if (EDITOR_STATE->isMovingSelectedEntities) {
-                entity->DrawMoveGhost();
-            } else {
-                if (!entity->IsDisabled()) drawSceneRectangle(entity->hitbox, color);
-                drawSceneRectangle(entity->GetOriginHitbox(), color);
-            }
-
-        }
-        else if (GAME_STATE->mode == MODE_OVERWORLD) {
-
-            OverworldEntity *entity = (OverworldEntity *) *e;
-
-            if (EDITOR_STATE->isMovingSelectedEntities) {
-                drawOverworldEntityMoveGhost(entity);
-            } else {
-                drawSceneRectangle(OverworldEntitySquare(entity), color);
-            }
-            
-        }
-    }
-}
-
 void drawEditorCursor() {
 
     EditorEntityButton* b = EDITOR_STATE->toggledEntityButton;
@@ -507,7 +811,7 @@ void drawEditorCursor() {
     Vector2 m = GetMousePosition();
     if (!IsInMouseArea(m)) return;
 
-    DrawTexture(b->sprite->sprite, m.x, m.y, getColorTransparency(WHITE, 96));
+    drawSprite(b->sprite, m, 1, getColorTransparency(WHITE, 96));
 }
 
 void drawEditor() {
@@ -516,8 +820,6 @@ void drawEditor() {
     float divisorY = EditorBarGetDivisorY();
 
 
-    drawEditorEntitySelection();
-
     DrawLine(rect.x,
                 rect.y,
                 rect.x,
@@ -543,30 +845,59 @@ void drawEditor() {
     drawEditorCursor();
 }
 
-void drawLevelTransitionShader() {
+static bool isLevelTransitionEnabled() {
+    return levelTransitionShaderControl.timer != -1;
+}
+
+// Covers the frame in black, except for a circle around the focus point that closes on it or opens from it
+static void applyLevelTransition(Texture2D input, Rectangle dest) {
 
-    double elapsedTime = GetTime() - levelTransitionShaderControl.timer;
+    DrawTexturePro(input, { 0, 0, (float) input.width, (float) -input.height }, dest, { 0, 0 }, 0, WHITE);
+
+    // Follows the simulation clock, like the level and overworld transitions it goes together with
+    double elapsedTime = GetSimulationTime() + GetTickInterpolation() * TICK_DURATION - levelTransitionShaderControl.timer;
 
                                                             // small buffer 
-    if (elapsedTime >= LEVEL_TRANSITION_ANIMATION_DURATION + GetFrameTime()) {
+    if (elapsedTime >= LEVEL_TRANSITION_ANIMATION_DURATION + TICK_DURATION) {
         TraceLog(LOG_TRACE, "ShaderLevelTransition finished.");
         levelTransitionShaderControl.timer = -1;
         return;
     }
 
+    // The focus point is in screen coordinates, and dest might be at the render scale
+    float scale = dest.width / GetScreenWidth();
+    Vector2 focusPoint = {
+        levelTransitionShaderControl.focusPoint.x * scale,
+        dest.height - levelTransitionShaderControl.focusPoint.y * scale // Fix for how GLSL works
+    };
+
     ShaderLevelTransitionSetUniforms(
-        { (float) GetScreenWidth(), (float) GetScreenHeight() },
-        levelTransitionShaderControl.focusPoint,
+        { dest.width, dest.height },
+        focusPoint,
         LEVEL_TRANSITION_ANIMATION_DURATION,
         elapsedTime,
         (int) levelTransitionShaderControl.isClose
     );
 
+    StatsFlush();
     BeginShaderMode(ShaderLevelTransition);
-        DrawTextureRec(levelTransitionShaderTexture.texture,
-                         { 0, 0, (float)levelTransitionShaderTexture.texture.width, (float)-levelTransitionShaderTexture.texture.height },
-                         { 0, 0 },
-                        WHITE );
+        DrawRectangleRec(dest, WHITE);
+    StatsFlush();
+    EndShaderMode();
+}
+
+static bool isCrtPassEnabled() {
+    return isCrtEnabled;
+}
+
+static void applyCrt(Texture2D input, Rectangle dest) {
+
+    ShaderCrtSetUniforms({ dest.width, dest.height });
+
+    StatsFlush();
+    BeginShaderMode(ShaderCRT);
+        DrawTexturePro(input, { 0, 0, (float) input.width, (float) -input.height }, dest, { 0, 0 }, 0, WHITE);
+    StatsFlush();
     EndShaderMode();
 }
 
@@ -578,29 +909,112 @@ void drawTextInput() {
     DrawText(std::string("> " + Input::STATE.textInputed).c_str(), 120, 100, 60, RAYWHITE);
 }
 
-void Initialize() {
+void drawMenu(Menu *menu) {
+
+    Vector2 pos = { MENU_ORIGIN };
+
+    // Darken background
+    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), { 0x00, 0x00, 0x00, 0xaa });
+
+    // TODO fix pause state (let pause in ow, don't let pause if there's no level loaded)
+    // and set this to always show
+    if (Level::STATE->isPaused && PLAYER && !PLAYER->isDead)
+        DrawText("PAUSADO", pos.x, pos.y, MENU_HEADER_FONT_SIZE, RAYWHITE);
+
+    pos.y += MENU_SPACING_HEADER_BODY;
+    int itemCount = 0;
+
+    for (auto item : menu->Items()) {
+
+        DrawText(item->Text().c_str(), pos.x, pos.y, MENU_LABEL_FONT_SIZE, WHITE);
+
+        if (itemCount == menu->ItemHighlighted()) {
+            DrawText("=>", pos.x - 45, pos.y, MENU_LABEL_FONT_SIZE, WHITE);
+        }
+
+        pos.y += MENU_SPACING_LABELS;
+        itemCount++;
+    }
+}
 
-    reloadShaders();
+void Initialize() {
 
     levelTransitionShaderControl.timer = -1;
 
+    StatsInitialize();
+
+    // In the order they're applied
+    postProcess.AddPass({ "level transition", &isLevelTransitionEnabled, &applyLevelTransition });
+    postProcess.AddPass({ "CRT", &isCrtPassEnabled, &applyCrt });
+
+    dynamicScale.Configure(DYNAMIC_RESOLUTION_MIN_SCALE, 1, DYNAMIC_RESOLUTION_FRAME_TIME);
+
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    FrameRateCapSet(refreshRate > 0 ? refreshRate : DEFAULT_FRAME_RATE_CAP);
+
+    frameStartTime = GetTime();
+
     // Line spacing of DrawText() 's containing line break
-    SetTextLineSpacing(35);
+    SetTextLineSpacing(DRAW_TEXT_LINE_SPACING);
 
     TraceLog(LOG_INFO, "Render initialized.");
 }
 
+/*
+    Waits out the rest of the frame under the frame rate cap, after the buffer swap.
+    The dynamic resolution goes by the time before the wait, i.e. the game's actual work.
+*/
+static void waitFrameRateCap() {
+
+    double now = GetTime();
+    frameWorkTime = now - frameStartTime;
+
+    if (frameRateCap && frameWorkTime < 1.0 / frameRateCap) {
+        WaitTime(1.0 / frameRateCap - frameWorkTime);
+        now = GetTime();
+    }
+
+    frameStartTime = now;
+}
+
 void Render() {
 
+    StatsBeginFrame();
+
+    CameraScreenSizeSet({ (float) GetScreenWidth(), (float) GetScreenHeight() });
+
     handleFullscreenChange();
 
-    BeginTextureMode(crtShaderTexture);
+    CameraInterpolate();
+
+    if (isDynamicResolutionEnabled)
+        postProcess.SetRenderScale(dynamicScale.Update(frameWorkTime, postProcess.GetRenderScale()));
+
+    postProcess.BeginFrame();
 
         ClearBackground(BLACK);
 
-        drawBackground();
+        // At the render scale, while the HUD and text after it are at the screen's resolution
+        postProcess.BeginScene();
+
+            StatsPhaseStart(RENDER_PHASE_BACKGROUND);
+
+            drawBackground();
+
+            StatsPhaseStart(RENDER_PHASE_ENTITIES);
+
+            // The scene, in in game coordinates
+            StatsFlush();
+            BeginMode2D(postProcess.ScaleCamera(CameraSceneCamera2D()));
 
-        drawEntities();
+                drawEntities();
+
+            StatsFlush();
+            EndMode2D();
+
+        postProcess.EndScene();
+
+        StatsPhaseStart(RENDER_PHASE_HUD);
 
         if (!EDITOR_STATE->isEnabled &&
             !GAME_STATE->showDebugHUD && isFullscreen)      drawFullScreenBlackbars();
@@ -613,32 +1027,26 @@ void Render() {
         if      (Textbox::TextboxDisplaying &&
                 !EDITOR_STATE->isEnabled)                   drawTextboxContent(Textbox::TextboxDisplaying);
 
-        if      (levelTransitionShaderControl.timer != -1)  drawLevelTransitionShader();
-
         if      (GAME_STATE->showDebugHUD)                  drawDebugHud();
 
         if      (GAME_STATE->waitingForTextInput)           drawTextInput();
 
         if      (GAME_STATE->menu &&
-                !EDITOR_STATE->isEnabled)                   GAME_STATE->menu->Draw();
+                !EDITOR_STATE->isEnabled)                   drawMenu(GAME_STATE->menu);
 
         drawSysMessages();
 
         if (EDITOR_STATE->isEnabled) drawEditor();
-    
-    EndTextureMode();
-
-    BeginDrawing();
 
-        ClearBackground(BLACK);
-
-        if (isCrtEnabled) { ShaderCrtSetUniforms(); BeginShaderMode(ShaderCRT); }
+    StatsPhaseStart(RENDER_PHASE_POST_PROCESS);
+    
+    postProcess.EndFrame();
 
-            DrawTextureRec(crtShaderTexture.texture, { 0, 0, (float)crtShaderTexture.texture.width, (float)-crtShaderTexture.texture.height }, { 0, 0 }, WHITE);
+    StatsEndFrame();
 
-        if (isCrtEnabled) EndShaderMode();
+    textCache.EndFrame();
 
-    EndDrawing();
+    waitFrameRateCap();
 }
 
 bool IsFullscreen() {
@@ -652,8 +1060,7 @@ bool IsCrtEnabled()
 
 void DrawTexture(Sprite *sprite, Vector2 pos, Color tint, int rotation, bool flipHorizontally) {
 
-    Dimensions dimensions = DimensionsInSceneToScreen(
-                                SpriteScaledDimensions(sprite));
+    Dimensions dimensions = SpriteScaledDimensions(sprite);
 
 
     // Raylib's draw function rotates the sprite around the origin, instead of its middle point.
@@ -665,21 +1072,11 @@ void DrawTexture(Sprite *sprite, Vector2 pos, Color tint, int rotation, bool fli
 
 
 
-    if (!flipHorizontally) {
-        DrawTextureEx(sprite->sprite,
-                    pos,
-                    rotation,
-                    ScaleInSceneToScreen(sprite->scale),
-                    tint);    
-        
-        return;
-    }
-
     Rectangle source = {
-        0.0,
-        0.0,
-        (float) -sprite->sprite.width,
-        (float) sprite->sprite.height
+        sprite->source.x,
+        sprite->source.y,
+        flipHorizontally ? -sprite->source.width : sprite->source.width,
+        sprite->source.height
     };
 
     Rectangle destination = {
@@ -689,40 +1086,55 @@ void DrawTexture(Sprite *sprite, Vector2 pos, Color tint, int rotation, bool fli
         dimensions.height
     };
 
-    DrawTexturePro(sprite->sprite,
+    if (levelQueue.IsOpen()) {
+        levelQueue.AddTexture(sprite->atlas, source, destination, rotation, tint);
+        return;
+    }
+
+    DrawTexturePro(sprite->atlas,
                     source,
                     destination,
                     { 0, 0 },
-                    rotation,
-                    tint);    
+                    (float) rotation,
+                    tint);
 }
 
-void DrawLevelEntity(Level::Entity *entity) {
+void DrawSceneLine(Vector2 start, Vector2 end, float thickness, Color color) {
 
-    Vector2 pos = PosInSceneToScreen({
-                                        entity->hitbox.x,
-                                        entity->hitbox.y });
+    if (levelQueue.IsOpen()) {
+        levelQueue.AddLine(start, end, thickness, color);
+        return;
+    }
 
-    DrawTexture(entity->sprite, { pos.x, pos.y }, WHITE, 0, !entity->isFacingRight);
+    DrawLineEx(start, end, thickness, color);
 }
 
-void DrawLevelEntityOriginGhost(Level::Entity *entity) {
+void DrawSceneCircleLines(Vector2 center, float radius, Color color) {
 
-    Vector2 pos = PosInSceneToScreen({
-                                        entity->origin.x,
-                                        entity->origin.y });
+    if (levelQueue.IsOpen()) {
+        levelQueue.AddCircleLines(center, radius, color);
+        return;
+    }
 
-    DrawTexture(entity->sprite, { pos.x, pos.y },
+    DrawCircleLines(center.x, center.y, radius, color);
+}
+
+void DrawLevelEntity(Level::Entity *entity) {
+
+    DrawTexture(entity->sprite, entity->GetRenderPos(), WHITE, 0, !entity->isFacingRight);
+}
+
+void DrawLevelEntityOriginGhost(Level::Entity *entity) {
+
+    DrawTexture(entity->sprite, entity->origin,
                  { WHITE.r, WHITE.g, WHITE.b, ORIGIN_GHOST_TRANSPARENCY }, 0, false);
 }
 
 void DrawLevelEntityMoveGhost(Level::Entity *entity) {
 
-    Vector2 pos = PosInSceneToScreen(
-                    EditorEntitySelectionCalcMove({ entity->hitbox.x,
-                                                    entity->hitbox.y }));
-    Vector2 originPos = PosInSceneToScreen(
-                            EditorEntitySelectionCalcMove(entity->origin));
+    Vector2 pos = EditorEntitySelectionCalcMove({ entity->hitbox.x,
+                                                    entity->hitbox.y });
+    Vector2 originPos = EditorEntitySelectionCalcMove(entity->origin);
 
     Color color =  { WHITE.r, WHITE.g, WHITE.b,
                             EDITOR_SELECTION_MOVE_TRANSPARENCY };
@@ -749,15 +1161,12 @@ void PrintSysMessage(const std::string &msg) {
 
 void LevelTransitionEffectStart(Vector2 sceneFocusPoint, bool isClose) {
 
-    levelTransitionShaderControl.timer = GetTime();
+    levelTransitionShaderControl.timer = GetSimulationTime();
     levelTransitionShaderControl.focusPoint = PosInSceneToScreen(sceneFocusPoint);
     levelTransitionShaderControl.isClose = isClose;
 
     TraceLog(LOG_TRACE, "ShaderLevelTransition started from x=%.1f, y=%.1f.",
         levelTransitionShaderControl.focusPoint.x, levelTransitionShaderControl.focusPoint.y);
-
-    // Fix for how GLSL works
-    levelTransitionShaderControl.focusPoint.y = GetScreenHeight() - levelTransitionShaderControl.focusPoint.y;
 }
 
 void FullscreenToggle() {
@@ -766,7 +1175,7 @@ void FullscreenToggle() {
 
     ToggleBorderlessWindowed();
 
-    reloadShaders(); // TODO why does removing this from here breaks the FS camera on Linux?
+    releaseRenderTargets(); // TODO why does removing this from here breaks the FS camera on Linux?
 }
 
 void CrtToggle() {
@@ -774,4 +1183,40 @@ void CrtToggle() {
     isCrtEnabled = !isCrtEnabled;
 }
 
+void DynamicResolutionToggle() {
+
+    isDynamicResolutionEnabled = !isDynamicResolutionEnabled;
+
+    if (!isDynamicResolutionEnabled) postProcess.SetRenderScale(dynamicScale.MaxScale());
+}
+
+bool IsDynamicResolutionEnabled() {
+    return isDynamicResolutionEnabled;
+}
+
+void DynamicResolutionConfigure(float minScale, float maxScale, double targetFrameTime) {
+
+    dynamicScale.Configure(minScale, maxScale, targetFrameTime);
+}
+
+void FrameRateCapSet(int framesPerSecond) {
+
+    frameRateCap = framesPerSecond > 0 ? framesPerSecond : 0;
+
+    if (frameRateCap) TraceLog(LOG_INFO, "Frame rate capped at %d FPS.", frameRateCap);
+    else TraceLog(LOG_INFO, "Frame rate uncapped.");
+}
+
+int GetFrameRateCap() {
+    return frameRateCap;
+}
+
+void SetRenderScale(float scale) {
+    postProcess.SetRenderScale(scale);
+}
+
+float GetRenderScale() {
+    return postProcess.GetRenderScale();
+}
+
 } // namespace
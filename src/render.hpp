@@ -3,7 +3,7 @@
 
 #include "string"
 
-#include "assets.hpp"
+#include "sprites.hpp"
 
 
 #define SYS_MSG_BUFFER_SIZE 1000
@@ -12,6 +12,13 @@
 
 #define ORIGIN_GHOST_TRANSPARENCY 30
 
+// The default bounds of the dynamic resolution: the lowest render scale, and the frame time it tries to keep under
+#define DYNAMIC_RESOLUTION_MIN_SCALE    0.5f
+#define DYNAMIC_RESOLUTION_FRAME_TIME   (1.0 / 60)
+
+// The frame rate cap if the monitor's refresh rate can't be read
+#define DEFAULT_FRAME_RATE_CAP          60
+
 
 namespace Level { class Entity; }
 
@@ -26,15 +33,19 @@ public:
 };
 
 
-void Initialize();
+/*
+    Called by the simulation, which draws its entities and shows messages through them.
+    The headless runner has nothing to draw in, and stubs them out.
+*/
 
-void Render();
+// These draw the scene, in in game coordinates, inside the scene's BeginMode2D().
+// While the level entities are being drawn, they are queued and drawn later, grouped by layer and texture.
 
-bool IsFullscreen();
+void DrawTexture(Sprite *sprite, Vector2 pos, Color tint, int rotation, bool flipHorizontally);
 
-bool IsCrtEnabled();
+void DrawSceneLine(Vector2 start, Vector2 end, float thickness, Color color);
 
-void DrawTexture(Sprite *sprite, Vector2 pos, Color tint, int rotation, bool flipHorizontally);
+void DrawSceneCircleLines(Vector2 center, float radius, Color color);
 
 void DrawLevelEntity(Level::Entity *entity);
 
@@ -53,12 +64,45 @@ void PrintSysMessage(const std::string &msg);
 */
 void LevelTransitionEffectStart(Vector2 sceneFocusPont, bool isClose);
 
+
+// The renderer itself, for the game
+
+void Initialize();
+
+void Render();
+
+bool IsFullscreen();
+
+bool IsCrtEnabled();
+
 // Toggles between full screen and windowed
 void FullscreenToggle();
 
 // Toggles the CRT effect
 void CrtToggle();
 
+/*
+    Toggles the dynamic resolution, that lowers the resolution the scene is drawn in when
+    the frames take too long, upscaling it to the screen's, and raises it back when they don't.
+    The HUD and text are always drawn at the screen's resolution.
+*/
+void DynamicResolutionToggle();
+
+bool IsDynamicResolutionEnabled();
+
+// The bounds of the dynamic resolution's render scale, and the frame time it tries to keep under, in seconds
+void DynamicResolutionConfigure(float minScale, float maxScale, double targetFrameTime);
+
+// Caps the frames rendered per second, waiting at the end of each frame, or not if 0.
+// The simulation runs at TICKS_PER_SECOND regardless. By default it's the monitor's refresh rate.
+void FrameRateCapSet(int framesPerSecond);
+int GetFrameRateCap();
+
+// The resolution the scene is drawn in, relative to the screen's, from RENDER_SCALE_MIN to 1.
+// Overriden every frame while the dynamic resolution is enabled.
+void SetRenderScale(float scale);
+float GetRenderScale();
+
 
 } // namespace
 
@@ -0,0 +1,142 @@
+#include <raylib.h>
+#include <algorithm>
+
+#include "render_queue.hpp"
+
+
+namespace Render {
+
+
+// The texture a command draws with. Primitives and callbacks get 0, which no texture has,
+// so they are grouped together before the textures of their layer.
+static unsigned int textureKey(const DrawCommand &command) {
+    return command.type == DRAW_COMMAND_TEXTURE ? command.texture.id : 0;
+}
+
+static void execute(const DrawCommand &command) {
+
+    switch (command.type) {
+
+    case DRAW_COMMAND_TEXTURE:
+        DrawTexturePro(command.texture, command.source, command.dest, { 0, 0 }, command.rotation, command.tint);
+        break;
+
+    case DRAW_COMMAND_LINE:
+        DrawLineEx({ command.dest.x, command.dest.y }, { command.dest.width, command.dest.height },
+                    command.rotation, command.tint);
+        break;
+
+    case DRAW_COMMAND_CIRCLE_LINES:
+        DrawCircleLines(command.dest.x, command.dest.y, command.dest.width, command.tint);
+        break;
+
+    case DRAW_COMMAND_RECTANGLE:
+        DrawRectangleRec(command.dest, command.tint);
+        break;
+
+    case DRAW_COMMAND_CALLBACK:
+        command.callback();
+        break;
+    }
+}
+
+void RenderQueue::Begin() {
+
+    commands.clear();
+    layer = 0;
+    isOpen = true;
+}
+
+bool RenderQueue::IsOpen() {
+    return isOpen;
+}
+
+void RenderQueue::SetLayer(int layer) {
+    this->layer = layer;
+}
+
+void RenderQueue::AddTexture(Texture2D texture, Rectangle source, Rectangle dest, float rotation, Color tint) {
+
+    DrawCommand command;
+    command.type = DRAW_COMMAND_TEXTURE;
+    command.texture = texture;
+    command.source = source;
+    command.dest = dest;
+    command.rotation = rotation;
+    command.tint = tint;
+
+    add(command);
+}
+
+void RenderQueue::AddLine(Vector2 start, Vector2 end, float thickness, Color color) {
+
+    DrawCommand command = {};
+    command.type = DRAW_COMMAND_LINE;
+    command.dest = { start.x, start.y, end.x, end.y };
+    command.rotation = thickness;
+    command.tint = color;
+
+    add(command);
+}
+
+void RenderQueue::AddCircleLines(Vector2 center, float radius, Color color) {
+
+    DrawCommand command = {};
+    command.type = DRAW_COMMAND_CIRCLE_LINES;
+    command.dest = { center.x, center.y, radius, 0 };
+    command.tint = color;
+
+    add(command);
+}
+
+void RenderQueue::AddRectangle(Rectangle rect, Color color) {
+
+    DrawCommand command = {};
+    command.type = DRAW_COMMAND_RECTANGLE;
+    command.dest = rect;
+    command.tint = color;
+
+    add(command);
+}
+
+void RenderQueue::AddCallback(void (*draw)()) {
+
+    DrawCommand command = {};
+    command.type = DRAW_COMMAND_CALLBACK;
+    command.callback = draw;
+
+    add(command);
+}
+
+void RenderQueue::Submit() {
+
+    isOpen = false;
+
+    lastCommandCount = commands.size();
+
+    // The sequence makes it a stable sort, without the buffer std::stable_sort allocates
+    std::sort(commands.begin(), commands.end(), [](const DrawCommand &a, const DrawCommand &b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (textureKey(a) != textureKey(b)) return textureKey(a) < textureKey(b);
+        return a.sequence < b.sequence;
+    });
+
+    for (const DrawCommand &command : commands) execute(command);
+
+    commands.clear();
+}
+
+int RenderQueue::LastCommandCount() {
+    return lastCommandCount;
+}
+
+void RenderQueue::add(DrawCommand command) {
+
+    command.layer = layer;
+    command.sequence = commands.size();
+
+    commands.push_back(command);
+}
+
+
+} // namespace
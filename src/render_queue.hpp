@@ -0,0 +1,91 @@
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+
+namespace Render {
+
+
+typedef enum DrawCommandType {
+    DRAW_COMMAND_TEXTURE,
+    DRAW_COMMAND_LINE,
+    DRAW_COMMAND_CIRCLE_LINES,
+    DRAW_COMMAND_RECTANGLE,
+    DRAW_COMMAND_CALLBACK
+} DrawCommandType;
+
+/*
+    A single deferred draw call, in in game coordinates, as it's drawn inside the scene's BeginMode2D().
+
+    Lines use dest as { start.x, start.y, end.x, end.y } and rotation as their thickness.
+    Circles use dest as { center.x, center.y, radius, 0 }.
+    Rectangles are filled, and use dest and tint.
+    Callbacks only use callback.
+*/
+typedef struct DrawCommand {
+    DrawCommandType type;
+    int layer;
+    unsigned int sequence; // Submission order, to keep it among commands with the same texture
+    Texture2D texture;
+    Rectangle source;
+    Rectangle dest;
+    float rotation;
+    Color tint;
+    void (*callback)();
+} DrawCommand;
+
+
+/*
+    Collects the draw calls of a frame instead of drawing them right away, so they can be
+    drawn layer by layer and, inside a layer, grouped by texture. Every texture change forces
+    raylib to flush its batch, so grouping them means fewer draw calls.
+
+    Primitives (lines, circles and rectangles) and callbacks don't use a texture, and are drawn under the textures of their layer.
+*/
+class RenderQueue {
+
+public:
+
+    // Starts collecting commands
+    void Begin();
+
+    // If commands are being collected, i.e. if Begin() was called and Submit() wasn't yet
+    bool IsOpen();
+
+    // The layer of the next commands added
+    void SetLayer(int layer);
+
+    void AddTexture(Texture2D texture, Rectangle source, Rectangle dest, float rotation, Color tint);
+
+    void AddLine(Vector2 start, Vector2 end, float thickness, Color color);
+
+    void AddCircleLines(Vector2 center, float radius, Color color);
+
+    void AddRectangle(Rectangle rect, Color color);
+
+    // For what draws itself some other way, e.g. with a shader
+    void AddCallback(void (*draw)());
+
+    // Sorts and draws everything collected since Begin(), and stops collecting
+    void Submit();
+
+    // How many commands the last Submit() drew
+    int LastCommandCount();
+
+private:
+
+    // Reused between frames, so the queue doesn't allocate once it has grown
+    std::vector<DrawCommand> commands;
+
+    bool isOpen = false;
+    int layer = 0;
+
+    int lastCommandCount = 0;
+
+
+    void add(DrawCommand command);
+};
+
+
+} // namespace
@@ -0,0 +1,152 @@
+#include <raylib.h>
+#include <rlgl.h>
+#include <stdio.h>
+
+#include "render_stats.hpp"
+#include "render.hpp"
+
+
+namespace Render {
+
+
+/*
+    rlgl draws through its active batch, so the stats make it one of their own, and count
+    what is in it right before it's drawn. That's where the draw calls, vertices and texture
+    switches of a frame are decided, and reading it only takes rlgl's public API.
+*/
+static rlRenderBatch batch;
+static bool isBatchLoaded = false;
+
+// The frame being counted
+static RenderStats current;
+
+static RenderStats last;
+
+// The texture of the last draw call, to count the switches across flushes
+static unsigned int lastTextureId = 0;
+
+static RenderPhase phase = RENDER_PHASE_COUNT;
+static double phaseStartTime = 0;
+
+static FILE *dumpFile = 0;
+static long dumpedFrames = 0;
+
+
+void StatsInitialize() {
+
+    if (isBatchLoaded) return;
+
+    batch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    isBatchLoaded = true;
+
+    // Draws what's in rlgl's own batch first
+    rlSetRenderBatchActive(&batch);
+}
+
+void StatsFlush() {
+
+    bool hasVertices = false;
+
+    for (int i = 0; i < batch.drawCounter; i++) {
+
+        const rlDrawCall &draw = batch.draws[i];
+        if (!draw.vertexCount) continue;
+
+        current.drawCalls++;
+        current.vertices += draw.vertexCount;
+
+        if (draw.textureId != lastTextureId) current.textureSwitches++;
+        lastTextureId = draw.textureId;
+
+        hasVertices = true;
+    }
+
+    if (hasVertices) current.batchFlushes++;
+
+    rlDrawRenderBatchActive();
+}
+
+void StatsTargetSwitch() {
+
+    StatsFlush();
+
+    current.renderTargetSwitches++;
+}
+
+void StatsBeginFrame() {
+
+    current = {};
+    lastTextureId = 0;
+    phase = RENDER_PHASE_COUNT;
+}
+
+void StatsPhaseStart(RenderPhase newPhase) {
+
+    double now = GetTime();
+
+    if (phase != RENDER_PHASE_COUNT) current.phaseTime[phase] += now - phaseStartTime;
+
+    phase = newPhase;
+    phaseStartTime = now;
+}
+
+void StatsSetEntities(int drawn, int culled) {
+
+    current.entitiesDrawn = drawn;
+    current.entitiesCulled = culled;
+}
+
+void StatsEndFrame() {
+
+    StatsPhaseStart(RENDER_PHASE_COUNT);
+
+    last = current;
+
+    if (!dumpFile) return;
+
+    fprintf(dumpFile, "%ld,%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f\n", dumpedFrames,
+                last.drawCalls, last.batchFlushes, last.textureSwitches, last.vertices, last.renderTargetSwitches,
+                last.entitiesDrawn, last.entitiesCulled,
+                last.phaseTime[RENDER_PHASE_BACKGROUND] * 1000, last.phaseTime[RENDER_PHASE_ENTITIES] * 1000,
+                last.phaseTime[RENDER_PHASE_HUD] * 1000, last.phaseTime[RENDER_PHASE_POST_PROCESS] * 1000);
+
+    dumpedFrames++;
+}
+
+const RenderStats &LastFrameStats() {
+    return last;
+}
+
+void StatsDumpToggle() {
+
+    if (dumpFile) {
+
+        fclose(dumpFile);
+        dumpFile = 0;
+
+        TraceLog(LOG_INFO, "Render stats of %ld frames dumped to %s.", dumpedFrames, RENDER_STATS_FILE_NAME);
+        PrintSysMessage("Estatísticas salvas em " RENDER_STATS_FILE_NAME);
+        return;
+    }
+
+    dumpFile = fopen(RENDER_STATS_FILE_NAME, "w");
+
+    if (!dumpFile) {
+        TraceLog(LOG_ERROR, "Couldn't open %s to dump the render stats.", RENDER_STATS_FILE_NAME);
+        PrintSysMessage("Erro ao salvar estatísticas");
+        return;
+    }
+
+    fprintf(dumpFile, "frame,draw_calls,batch_flushes,texture_switches,vertices,render_target_switches,"
+                        "entities_drawn,entities_culled,background_ms,entities_ms,hud_ms,post_process_ms\n");
+    dumpedFrames = 0;
+
+    PrintSysMessage("Salvando estatísticas de renderização");
+}
+
+bool IsDumpingStats() {
+    return dumpFile != 0;
+}
+
+
+} // namespace
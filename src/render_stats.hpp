@@ -0,0 +1,69 @@
+#pragma once
+
+
+// Where the stats are dumped to, in the working directory
+#define RENDER_STATS_FILE_NAME  "render_stats.csv"
+
+
+namespace Render {
+
+
+// The parts of a frame timed separately
+typedef enum RenderPhase {
+    RENDER_PHASE_BACKGROUND,
+    RENDER_PHASE_ENTITIES,
+    RENDER_PHASE_HUD,
+    RENDER_PHASE_POST_PROCESS, // The passes, and showing the frame
+    RENDER_PHASE_COUNT
+} RenderPhase;
+
+/*
+    What a frame cost to render.
+
+    The draw calls, batch flushes, texture switches and vertices are counted at StatsFlush().
+    rlgl also draws its batch on its own when it fills up, which isn't counted, so with more than
+    a batch's worth of drawing between two flushes (256 draw calls, or 8192 quads) these are lower bounds.
+*/
+typedef struct RenderStats {
+    int drawCalls;              // With vertices, one per texture or primitive mode change in the batch
+    int batchFlushes;           // Times rlgl's batch was drawn with something in it
+    int textureSwitches;
+    int vertices;
+    int renderTargetSwitches;   // Into and out of render textures
+    int entitiesDrawn;
+    int entitiesCulled;         // Not drawn for being off the screen or asleep
+    double phaseTime[RENDER_PHASE_COUNT]; // CPU time, in seconds
+} RenderStats;
+
+
+// Makes rlgl draw through a batch the stats can count. Must be called after the window is created.
+void StatsInitialize();
+
+// Draws rlgl's batch, counting what it draws. Must be called right before anything that makes
+// rlgl draw it (Begin/End of Mode2D, ShaderMode and TextureMode, and EndDrawing), or it's drawn uncounted.
+void StatsFlush();
+
+// Flushes, and counts a switch of render target. In place of StatsFlush() before Begin/EndTextureMode.
+void StatsTargetSwitch();
+
+// Starts counting a new frame
+void StatsBeginFrame();
+
+// Starts timing a phase of the frame, ending the previous one
+void StatsPhaseStart(RenderPhase phase);
+
+void StatsSetEntities(int drawn, int culled);
+
+// Ends the frame, dumping its stats if it's dumping them
+void StatsEndFrame();
+
+// The stats of the last complete frame
+const RenderStats &LastFrameStats();
+
+// Starts or stops dumping the stats of every frame to RENDER_STATS_FILE_NAME, one line per frame
+void StatsDumpToggle();
+
+bool IsDumpingStats();
+
+
+} // namespace
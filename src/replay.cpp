@@ -0,0 +1,306 @@
+#include <raylib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "replay.hpp"
+#include "level/level.hpp"
+#include "persistence.hpp"
+#include "render.hpp"
+
+
+#define REPLAY_MAGIC            "JRPL"
+#define REPLAY_VERSION          1
+
+#define INPUT_MOVE_MASK         3
+#define INPUT_RUN               4
+#define INPUT_JUMP              8
+#define INPUT_CHECKPOINT        16
+#define INPUT_HOOK              32
+#define INPUT_CONTINUE          64
+
+
+namespace Replay {
+
+
+typedef enum {
+    REPLAY_IDLE,
+    REPLAY_RECORDING,
+    REPLAY_PLAYING,
+} ReplayMode;
+
+typedef struct TickRecord {
+    uint8_t input;
+    uint32_t stateHash;
+} TickRecord;
+
+
+static ReplayMode mode = REPLAY_IDLE;
+
+// If the mode only starts once the level is loaded
+static bool isWaitingForLevel = false;
+
+static std::string levelName;
+static std::vector<TickRecord> ticks;
+
+// The tick being recorded or played back
+static size_t currentTick = 0;
+
+static long divergedAt = -1;
+
+// If the level continued after the player died since the last tick recorded
+static bool continuedSinceLastTick = false;
+
+
+static uint8_t packInput(const Input::InputState *input) {
+
+    uint8_t bits = (uint8_t) input->playerMoveDirection & INPUT_MOVE_MASK;
+    if (input->isHoldingRun)            bits |= INPUT_RUN;
+    if (input->pressedJump)             bits |= INPUT_JUMP;
+    if (input->pressedCheckpoint)       bits |= INPUT_CHECKPOINT;
+    if (input->pressedGrapplingHook)    bits |= INPUT_HOOK;
+    return bits;
+}
+
+static void unpackInput(uint8_t bits, Input::InputState *input) {
+
+    input->playerMoveDirection = (Input::PlayerMoveDirection) (bits & INPUT_MOVE_MASK);
+    input->isHoldingRun = bits & INPUT_RUN;
+    input->pressedJump = bits & INPUT_JUMP;
+    input->pressedCheckpoint = bits & INPUT_CHECKPOINT;
+    input->pressedGrapplingHook = bits & INPUT_HOOK;
+}
+
+static void writeUint(std::vector<unsigned char> &data, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) data.push_back((value >> (8 * i)) & 0xff);
+}
+
+static uint32_t readUint(const unsigned char *data, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= (uint32_t) data[i] << (8 * i);
+    return value;
+}
+
+static bool save(const char *filePath) {
+
+    std::vector<unsigned char> data(REPLAY_MAGIC, REPLAY_MAGIC + strlen(REPLAY_MAGIC));
+    data.push_back(REPLAY_VERSION);
+
+    writeUint(data, levelName.size(), 2);
+    data.insert(data.end(), levelName.begin(), levelName.end());
+
+    for (const TickRecord &tick : ticks) {
+        data.push_back(tick.input);
+        writeUint(data, tick.stateHash, 4);
+    }
+
+    return SaveFileData(filePath, data.data(), data.size());
+}
+
+static bool load(const char *filePath) {
+
+    int size;
+    unsigned char *data = LoadFileData(filePath, &size);
+    if (!data) return false;
+
+    const size_t headerSize = strlen(REPLAY_MAGIC) + 1 + 2;
+    bool ok = false;
+
+    if ((size_t) size >= headerSize &&
+        memcmp(data, REPLAY_MAGIC, strlen(REPLAY_MAGIC)) == 0 &&
+        data[strlen(REPLAY_MAGIC)] == REPLAY_VERSION) {
+
+        size_t nameLength = readUint(data + strlen(REPLAY_MAGIC) + 1, 2);
+        size_t ticksStart = headerSize + nameLength;
+
+        if ((size_t) size >= ticksStart && (size - ticksStart) % 5 == 0) {
+
+            levelName.assign((char *) data + headerSize, nameLength);
+
+            ticks.clear();
+            for (size_t i = ticksStart; i < (size_t) size; i += 5)
+                ticks.push_back({ data[i], readUint(data + i + 1, 4) });
+
+            ok = true;
+        }
+    }
+
+    UnloadFileData(data);
+    return ok;
+}
+
+// Loads the level in the recording, from the start
+static void loadLevel() {
+
+    char name[LEVEL_NAME_BUFFER_SIZE] = { 0 };
+    strncpy(name, levelName.c_str(), LEVEL_NAME_BUFFER_SIZE - 1);
+
+    Level::Load(name);
+}
+
+void RecordingStart() {
+
+    if (mode != REPLAY_IDLE) return;
+
+    if (Level::STATE->levelName[0] == '\0') {
+        TraceLog(LOG_WARNING, "Can't record replay, no level loaded.");
+        return;
+    }
+
+    levelName = Level::STATE->levelName;
+    ticks.clear();
+
+    mode = REPLAY_RECORDING;
+    isWaitingForLevel = true;
+
+    loadLevel();
+
+    Render::PrintSysMessage("Gravando replay");
+}
+
+void RecordingStop() {
+
+    if (mode != REPLAY_RECORDING) return;
+
+    mode = REPLAY_IDLE;
+    isWaitingForLevel = false;
+
+    // In case it stopped between a tick's input and its state
+    ticks.resize(currentTick);
+
+    if (!save(REPLAY_FILE_NAME)) {
+        TraceLog(LOG_ERROR, "Couldn't save replay to %s.", REPLAY_FILE_NAME);
+        Render::PrintSysMessage("Erro ao salvar replay");
+        return;
+    }
+
+    TraceLog(LOG_INFO, "Replay of %s saved to %s (%zu ticks).", levelName.c_str(), REPLAY_FILE_NAME, ticks.size());
+    Render::PrintSysMessage("Replay salvo em " REPLAY_FILE_NAME);
+}
+
+void RecordingToggle() {
+
+    if (IsRecording()) RecordingStop();
+    else RecordingStart();
+}
+
+bool IsRecording() {
+    return mode == REPLAY_RECORDING;
+}
+
+bool PlaybackStart(const char *filePath) {
+
+    if (mode == REPLAY_RECORDING) RecordingStop();
+
+    if (!load(filePath)) {
+        TraceLog(LOG_ERROR, "Couldn't read replay %s.", filePath);
+        return false;
+    }
+
+    mode = REPLAY_PLAYING;
+    isWaitingForLevel = true;
+    divergedAt = -1;
+
+    loadLevel();
+
+    TraceLog(LOG_INFO, "Playing back replay %s of %s (%zu ticks).", filePath, levelName.c_str(), ticks.size());
+
+    return true;
+}
+
+bool IsPlayingBack() {
+    return mode == REPLAY_PLAYING;
+}
+
+long PlaybackDivergedAt() {
+    return divergedAt;
+}
+
+unsigned long TickCount() {
+    return currentTick;
+}
+
+void LevelLoaded(const char *loadedLevelName) {
+
+    if (!isWaitingForLevel) return;
+
+    if (levelName != loadedLevelName) {
+        TraceLog(LOG_ERROR, "Replay expected level %s, but %s was loaded.", levelName.c_str(), loadedLevelName);
+        mode = REPLAY_IDLE;
+    }
+
+    isWaitingForLevel = false;
+    currentTick = 0;
+    continuedSinceLastTick = false;
+}
+
+void LevelLeft() {
+
+    // Still loading the level it's waiting for
+    if (isWaitingForLevel) return;
+
+    if (mode == REPLAY_RECORDING) {
+        RecordingStop();
+    }
+    else if (mode == REPLAY_PLAYING) {
+        TraceLog(LOG_INFO, "Replay playback left the level at tick %zu of %zu.", currentTick, ticks.size());
+        mode = REPLAY_IDLE;
+    }
+}
+
+void LevelContinued() {
+
+    if (mode == REPLAY_RECORDING && !isWaitingForLevel) continuedSinceLastTick = true;
+}
+
+bool PlaybackContinuesLevel() {
+
+    return mode == REPLAY_PLAYING && !isWaitingForLevel && currentTick < ticks.size() &&
+            (ticks[currentTick].input & INPUT_CONTINUE);
+}
+
+void TickInput(Input::InputState *input) {
+
+    if (isWaitingForLevel) return;
+
+    if (mode == REPLAY_RECORDING) {
+
+        uint8_t bits = packInput(input);
+        if (continuedSinceLastTick) bits |= INPUT_CONTINUE;
+        continuedSinceLastTick = false;
+
+        ticks.push_back({ bits, 0 });
+    }
+    else if (mode == REPLAY_PLAYING && currentTick < ticks.size()) {
+        unpackInput(ticks[currentTick].input, input);
+    }
+}
+
+void TickState(uint32_t stateHash) {
+
+    if (isWaitingForLevel) return;
+
+    if (mode == REPLAY_RECORDING) {
+        ticks[currentTick].stateHash = stateHash;
+        currentTick++;
+    }
+    else if (mode == REPLAY_PLAYING && currentTick < ticks.size()) {
+
+        if (divergedAt == -1 && ticks[currentTick].stateHash != stateHash) {
+            divergedAt = currentTick;
+            TraceLog(LOG_WARNING, "Replay playback diverged from the recording at tick %zu.", currentTick);
+            Render::PrintSysMessage("Replay divergiu da gravação");
+        }
+
+        currentTick++;
+
+        if (currentTick == ticks.size()) {
+            mode = REPLAY_IDLE;
+            TraceLog(LOG_INFO, "Replay playback finished (%zu ticks).", currentTick);
+            Render::PrintSysMessage("Replay terminado");
+        }
+    }
+}
+
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "input.hpp"
+
+
+// Where recordings are saved, relative to the working directory
+#define REPLAY_FILE_NAME        "replay.rpl"
+
+
+namespace Replay {
+
+
+/*
+    Records the gameplay input of each level tick, from the level's start, and plays it back tick by tick.
+
+    Along with the input, it records a hash of the level's state after each tick, and
+    checks the playback against it, so a playback that diverges from the recording is caught.
+
+    Recordings are binary files:
+
+        "JRPL" | version (1 byte) | level name length (2 bytes) | level name
+        then for each tick: input bits (1 byte) | state hash (4 bytes)
+
+    Continuing the level after the player died is done from the pause menu, between ticks, so it's
+    recorded as an input bit of the tick after it, and playing back does it before that tick.
+*/
+
+
+// Reloads the current level and records it from the start
+void RecordingStart();
+
+// Stops recording, saving it to REPLAY_FILE_NAME
+void RecordingStop();
+
+void RecordingToggle();
+
+bool IsRecording();
+
+// Loads a recording and its level, and plays it back. Returns 'false' if the recording couldn't be read.
+bool PlaybackStart(const char *filePath);
+
+bool IsPlayingBack();
+
+// The first tick in which the playback's state didn't match the recording's, or -1 if it didn't diverge
+long PlaybackDivergedAt();
+
+// How many ticks were recorded or played back so far
+unsigned long TickCount();
+
+// To be called once the level is loaded
+void LevelLoaded(const char *levelName);
+
+// To be called when the level is unloaded
+void LevelLeft();
+
+// To be called when the level continues after the player died
+void LevelContinued();
+
+// If the level is to continue after the player died, before the tick about to be played back
+bool PlaybackContinuesLevel();
+
+// Records the input for the tick about to run or, when playing back, replaces it with the recorded one
+void TickInput(Input::InputState *input);
+
+// Records the level's state after a tick or, when playing back, checks it against the recorded one
+void TickState(uint32_t stateHash);
+
+
+}
@@ -1,7 +1,7 @@
 #include <raylib.h>
 
 #include "sounds.hpp"
-#include "render.hpp"
+#include "assets.hpp"
 
 
 namespace Sounds {
@@ -10,6 +10,16 @@ namespace Sounds {
 SoundsState STATE;
 
 
+static Sound *soundOf(SoundId id) {
+
+    switch (id) {
+    case SOUND_JUMP:        return &SOUNDS->Jump;
+    case SOUND_TRACK_1:     return &SOUNDS->Track1;
+    }
+
+    return 0;
+}
+
 void Initialize() {
 
     STATE = SoundsState();
@@ -35,12 +45,12 @@ void Tick() {
         PlaySound(*STATE.trackPlaying);
 }
 
-void PlayEffect(Sound *sound) {
-    PlaySound(*sound);
+void PlayEffect(SoundId clip) {
+    PlaySound(*soundOf(clip));
 }
 
-void PlayMusic(Sound *track) {
-    STATE.trackPlaying = track;
+void PlayMusic(SoundId track) {
+    STATE.trackPlaying = soundOf(track);
 }
 
 void StopMusic() {
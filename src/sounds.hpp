@@ -6,6 +6,13 @@
 namespace Sounds {
 
 
+// The sounds the simulation plays, so it can refer to them without having them loaded
+typedef enum SoundId {
+    SOUND_JUMP,
+    SOUND_TRACK_1
+} SoundId;
+
+
 class SoundsState {
 
 public:
@@ -27,11 +34,14 @@ bool IsEnabled();
 
 void Tick();
 
+
+// Called by the simulation. The headless runner has no audio device, and stubs these out.
+
 // Plays an effect clip once
-void PlayEffect(Sound *clip);
+void PlayEffect(SoundId clip);
 
 // Plays a song continuously 
-void PlayMusic(Sound *track);
+void PlayMusic(SoundId track);
 
 // Stops the song being played
 void StopMusic();
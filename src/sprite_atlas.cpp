@@ -0,0 +1,213 @@
+#include <raylib.h>
+#include <algorithm>
+#include <vector>
+
+#include "sprite_atlas.hpp"
+
+
+namespace SpriteAtlas {
+
+
+typedef struct AtlasEntry {
+    Sprite *sprite;
+    std::string imagePath;
+    long modTime; // Of the image, when it was packed
+    int page;
+} AtlasEntry;
+
+typedef struct PageLayout {
+    int width;
+    int height;
+} PageLayout;
+
+
+static std::vector<AtlasEntry> entries;
+
+static std::vector<Texture2D> pages;
+
+
+// Reads an image as RGBA, the format of the pages
+static Image loadImage(const std::string &path) {
+
+    Image image = LoadImage(path.c_str());
+
+    if (!image.data) {
+        TraceLog(LOG_ERROR, "Sprite atlas couldn't read image %s.", path.c_str());
+        return image;
+    }
+
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    return image;
+}
+
+// Copies an image into dest with its top-left corner at (x, y), extruding its edges into the padding around it
+static void blitExtruded(Image *dest, const Image *image, int x, int y) {
+
+    if (!image->data || !image->width || !image->height) return;
+
+    Color *destPixels = (Color *) dest->data;
+    const Color *imagePixels = (const Color *) image->data;
+
+    for (int row = -ATLAS_PADDING; row < image->height + ATLAS_PADDING; row++) {
+
+        int imageRow = std::clamp(row, 0, image->height - 1);
+
+        for (int col = -ATLAS_PADDING; col < image->width + ATLAS_PADDING; col++) {
+
+            int imageCol = std::clamp(col, 0, image->width - 1);
+
+            destPixels[(y + row) * dest->width + (x + col)] = imagePixels[imageRow * image->width + imageCol];
+        }
+    }
+}
+
+void Add(Sprite *sprite, const std::string &imagePath) {
+
+    entries.push_back({ sprite, imagePath, 0, 0 });
+}
+
+void Build() {
+
+    std::vector<Image> images;
+    images.reserve(entries.size());
+    for (AtlasEntry &entry : entries) {
+        entry.modTime = GetFileModTime(entry.imagePath.c_str());
+        images.push_back(loadImage(entry.imagePath));
+    }
+
+    // Shelf packing, tallest images first, so each shelf wastes little height
+    std::vector<size_t> order(entries.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                        [&](size_t a, size_t b) { return images[a].height > images[b].height; });
+
+    std::vector<PageLayout> layouts;
+    std::vector<Vector2> positions(entries.size());
+    int shelfPage = -1; // The page the shelves are being laid in
+    int x = 0, y = 0, shelfHeight = 0;
+
+    for (size_t i : order) {
+
+        const int width = images[i].width + ATLAS_PADDING * 2;
+        const int height = images[i].height + ATLAS_PADDING * 2;
+
+        if (width > ATLAS_PAGE_SIDE || height > ATLAS_PAGE_SIDE) {
+            TraceLog(LOG_WARNING, "Image %s is larger than an atlas page, and got a page of its own.",
+                        entries[i].imagePath.c_str());
+            entries[i].page = layouts.size();
+            positions[i] = { ATLAS_PADDING, ATLAS_PADDING };
+            layouts.push_back({ width, height });
+            continue;
+        }
+
+        if (x + width > ATLAS_PAGE_SIDE) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        if (shelfPage == -1 || y + height > ATLAS_PAGE_SIDE) {
+            shelfPage = layouts.size();
+            layouts.push_back({ ATLAS_PAGE_SIDE, 0 });
+            x = 0;
+            y = 0;
+            shelfHeight = 0;
+        }
+
+        entries[i].page = shelfPage;
+        positions[i] = { (float) x + ATLAS_PADDING, (float) y + ATLAS_PADDING };
+        layouts[shelfPage].height = std::max(layouts[shelfPage].height, y + height);
+
+        x += width;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+
+    pages.clear();
+
+    for (size_t p = 0; p < layouts.size(); p++) {
+
+        Image canvas = GenImageColor(layouts[p].width, layouts[p].height, BLANK);
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].page == (int) p)
+                blitExtruded(&canvas, &images[i], positions[i].x, positions[i].y);
+        }
+
+        pages.push_back(LoadTextureFromImage(canvas));
+        UnloadImage(canvas);
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+
+        Sprite *sprite = entries[i].sprite;
+        sprite->atlas = pages[entries[i].page];
+        sprite->source = { positions[i].x, positions[i].y, (float) images[i].width, (float) images[i].height };
+
+        UnloadImage(images[i]);
+    }
+
+    TraceLog(LOG_INFO, "Sprite atlas built: %d sprites in %d pages.", (int) entries.size(), (int) pages.size());
+}
+
+void Reload() {
+
+    int reloadedCount = 0;
+
+    for (AtlasEntry &entry : entries) {
+
+        long modTime = GetFileModTime(entry.imagePath.c_str());
+        if (modTime == entry.modTime) continue;
+
+        Image image = loadImage(entry.imagePath);
+        if (!image.data) continue;
+
+        Sprite *sprite = entry.sprite;
+
+        if (image.width != (int) sprite->source.width || image.height != (int) sprite->source.height) {
+
+            UnloadImage(image);
+
+            TraceLog(LOG_INFO, "Image %s changed dimensions, rebuilding the sprite atlas...", entry.imagePath.c_str());
+            Unload();
+            Build();
+            return;
+        }
+
+        // The region, padding included
+        Rectangle region = {
+            sprite->source.x - ATLAS_PADDING,
+            sprite->source.y - ATLAS_PADDING,
+            sprite->source.width + ATLAS_PADDING * 2,
+            sprite->source.height + ATLAS_PADDING * 2
+        };
+
+        Image padded = GenImageColor(region.width, region.height, BLANK);
+        blitExtruded(&padded, &image, ATLAS_PADDING, ATLAS_PADDING);
+        UpdateTextureRec(pages[entry.page], region, padded.data);
+
+        UnloadImage(padded);
+        UnloadImage(image);
+
+        entry.modTime = modTime;
+        reloadedCount++;
+    }
+
+    TraceLog(LOG_INFO, "Sprite atlas reloaded %d images.", reloadedCount);
+}
+
+void Unload() {
+
+    for (Texture2D &page : pages) {
+        if (page.id) UnloadTexture(page);
+    }
+
+    pages.clear();
+}
+
+int PageCount() {
+    return pages.size();
+}
+
+
+} // namespace
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+#include "sprites.hpp"
+
+
+namespace SpriteAtlas {
+
+/*
+    Packs the sprites' images into a few large textures, the atlas pages, so sprites
+    that share a page can be drawn in the same batch. Each Sprite then points to
+    its page and to the region of the page that has its image.
+*/
+
+// The side of a page. Images larger than this get a page of their own.
+#define ATLAS_PAGE_SIDE     2048
+
+// The border around each image in a page, filled with the image's edge pixels
+// so scaled sprites don't sample their neighbours
+#define ATLAS_PADDING       1
+
+
+// Sets a sprite to be packed by Build(), from an image file
+void Add(Sprite *sprite, const std::string &imagePath);
+
+// Packs every sprite added and uploads the pages
+void Build();
+
+// Re-reads the images that changed on disk since they were packed, updating only their regions.
+// If an image's dimensions changed it no longer fits its region, and the whole atlas is rebuilt.
+void Reload();
+
+// Unloads the pages. The sprites are kept, to be packed again by Build().
+void Unload();
+
+int PageCount();
+
+} // namespace
@@ -0,0 +1,157 @@
+#include <raylib.h>
+#include <stdint.h>
+#include <string>
+
+#include "sprites.hpp"
+#include "files.hpp"
+
+
+struct SpriteBank *SPRITES = 0;
+
+
+// A PNG starts with its signature, followed by the IHDR chunk: its length, its type, and then
+// the image's width and height, big-endian
+#define PNG_SIGNATURE           "\x89PNG\r\n\x1a\n"
+#define PNG_WIDTH_OFFSET        16
+#define PNG_HEADER_SIZE         24
+
+
+static inline void normalSizeSprite(SpriteImageLoader loadImage, Sprite *sprite, std::string texturePath) {
+    sprite->scale = 1;
+    loadImage(sprite, texturePath);
+}
+
+static inline void doubleSizeSprite(SpriteImageLoader loadImage, Sprite *sprite, std::string texturePath) {
+    sprite->scale = 2;
+    loadImage(sprite, texturePath);
+}
+
+static uint32_t readBigEndian(const unsigned char *bytes) {
+    return ((uint32_t) bytes[0] << 24) | ((uint32_t) bytes[1] << 16) | ((uint32_t) bytes[2] << 8) | bytes[3];
+}
+
+// Reads only the image's dimensions, with no atlas to put it in
+static void loadImageDimensions(Sprite *sprite, const std::string &imagePath) {
+
+    const std::string data = Files::TextLoad(imagePath);
+    const unsigned char *bytes = (const unsigned char *) data.data();
+
+    sprite->atlas = { 0, 0, 0, 0, 0 };
+
+    if (data.size() < PNG_HEADER_SIZE || data.compare(0, 8, PNG_SIGNATURE) != 0) {
+        TraceLog(LOG_ERROR, "Couldn't read the dimensions of image %s.", imagePath.c_str());
+        sprite->source = { 0, 0, HEADLESS_SPRITE_SIDE, HEADLESS_SPRITE_SIDE };
+        return;
+    }
+
+    sprite->source = {
+        0,
+        0,
+        (float) readBigEndian(bytes + PNG_WIDTH_OFFSET),
+        (float) readBigEndian(bytes + PNG_WIDTH_OFFSET + 4)
+    };
+}
+
+void SpritesInitialize(SpriteImageLoader loadImage) {
+
+    SPRITES = (SpriteBank *) MemAlloc(sizeof(SpriteBank));
+
+    SpriteBank *sp = SPRITES;
+
+    // Editor
+    doubleSizeSprite(loadImage, &sp->Eraser, "../assets/eraser_1.png");
+
+    // In Level
+    doubleSizeSprite(loadImage, &sp->PlayerDefault, "../assets/player_default_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerWalking1, "../assets/player_walking_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerWalking2, "../assets/player_walking_2.png");
+    doubleSizeSprite(loadImage, &sp->PlayerRunning1, "../assets/player_running_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerRunning2, "../assets/player_running_2.png");
+    doubleSizeSprite(loadImage, &sp->PlayerSkidding, "../assets/player_skidding_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerJumpingUp, "../assets/player_jumping_up.png");
+    doubleSizeSprite(loadImage, &sp->PlayerJumpingDown, "../assets/player_jumping_down.png");
+    doubleSizeSprite(loadImage, &sp->PlayerGlideDefault1, "../assets/player_glide_default_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerGlideDefault2, "../assets/player_glide_default_2.png");
+    doubleSizeSprite(loadImage, &sp->PlayerGlideGliding1, "../assets/player_glide_gliding_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerGlideGliding2, "../assets/player_glide_gliding_2.png");
+    doubleSizeSprite(loadImage, &sp->PlayerSwinging, "../assets/player_swinging_1.png");
+    doubleSizeSprite(loadImage, &sp->PlayerSwingingForwards, "../assets/player_swinging_forwards.png");
+    doubleSizeSprite(loadImage, &sp->PlayerSwingingBackwards, "../assets/player_swinging_backwards.png");
+    doubleSizeSprite(loadImage, &sp->Enemy, "../assets/enemy_default_1.png");
+    doubleSizeSprite(loadImage, &sp->EnemyDummySpike, "../assets/enemy_dummy_spike_1.png");
+    doubleSizeSprite(loadImage, &sp->EnemyDummySpikePoppingOut1, "../assets/enemy_dummy_spike_popping_out_1.png");
+    doubleSizeSprite(loadImage, &sp->EnemyDummySpikePoppingOut2, "../assets/enemy_dummy_spike_popping_out_2.png");
+    doubleSizeSprite(loadImage, &sp->EnemyDummySpikePoppingOut3, "../assets/enemy_dummy_spike_popping_out_3.png");
+    doubleSizeSprite(loadImage, &sp->EnemyDummySpikePoppedOut, "../assets/enemy_dummy_spike_popped_out.png");
+    doubleSizeSprite(loadImage, &sp->LevelEndOrb, "../assets/level_end_orb_1.png");
+    doubleSizeSprite(loadImage, &sp->LevelCheckpointFlag, "../assets/player_child_1.png");
+    doubleSizeSprite(loadImage, &sp->LevelCheckpointPickup1, "../assets/egg_1.png");
+    doubleSizeSprite(loadImage, &sp->LevelCheckpointPickup2, "../assets/egg_2.png");
+    doubleSizeSprite(loadImage, &sp->LevelCheckpointPickup3, "../assets/egg_3.png");
+    normalSizeSprite(loadImage, &sp->MovingPlatform, "../assets/moving_platform.png");
+    normalSizeSprite(loadImage, &sp->Block1Side, "../assets/floor_tile_1_side.png");
+    normalSizeSprite(loadImage, &sp->Block0Sides, "../assets/floor_tile_0_sides.png");
+    normalSizeSprite(loadImage, &sp->Block2SidesOpp, "../assets/floor_tile_2_sides_opposite.png");
+    normalSizeSprite(loadImage, &sp->Block2SidesAdj, "../assets/floor_tile_2_sides_adjacent.png");
+    normalSizeSprite(loadImage, &sp->Block3Sides, "../assets/floor_tile_3_sides.png");
+    normalSizeSprite(loadImage, &sp->Block4Sides, "../assets/floor_tile_4_sides.png");
+    normalSizeSprite(loadImage, &sp->Acid, "../assets/acid_tile_1.png");
+    normalSizeSprite(loadImage, &sp->GlideItem, "../assets/glide_item.png");
+    normalSizeSprite(loadImage, &sp->TextboxButton, "../assets/textbox_button.png");
+    normalSizeSprite(loadImage, &sp->TextboxDevButton, "../assets/textbox_dev_button.png");
+    normalSizeSprite(loadImage, &sp->TextboxButtonPlaying, "../assets/textbox_button_playing.png");
+    doubleSizeSprite(loadImage, &sp->PrincessDefault1, "../assets/princess_default_1.png");
+    doubleSizeSprite(loadImage, &sp->PrincessEditorIcon, "../assets/princess_editor_icon.png");
+    normalSizeSprite(loadImage, &sp->Coin1, "../assets/coin_1.png");
+    normalSizeSprite(loadImage, &sp->Coin2, "../assets/coin_2.png");
+    normalSizeSprite(loadImage, &sp->Coin3, "../assets/coin_3.png");
+
+    // Overworld
+    doubleSizeSprite(loadImage, &sp->OverworldCursor, "../assets/cursor_default_1.png");
+    doubleSizeSprite(loadImage, &sp->LevelDot, "../assets/level_dot_1.png");
+    doubleSizeSprite(loadImage, &sp->PathTileJoin, "../assets/path_tile_join_vertical.png");
+    doubleSizeSprite(loadImage, &sp->PathTileStraight, "../assets/path_tile_straight_vertical.png");
+    doubleSizeSprite(loadImage, &sp->PathTileInL, "../assets/path_tile_L.png");
+
+    TraceLog(LOG_INFO, "Sprites initialized.");
+}
+
+void SpritesInitializeHeadless() {
+    SpritesInitialize(loadImageDimensions);
+}
+
+Dimensions SpriteScaledDimensions(Sprite *s) {
+    return {
+        s->source.width * s->scale,
+        s->source.height * s->scale
+    };
+}
+
+Vector2 SpritePosMiddlePoint(Vector2 pos, Sprite *sprite) {
+    Dimensions dimensions = SpriteScaledDimensions(sprite);
+
+    return {
+        pos.x + (dimensions.width / 2),
+        pos.y + (dimensions.height / 2),
+    };
+}
+
+Rectangle SpriteHitboxFromEdge(Sprite *sprite, Vector2 origin) {
+    Dimensions dimensions = SpriteScaledDimensions(sprite);
+    return {
+        origin.x,
+        origin.y,
+        dimensions.width,
+        dimensions.height
+    };
+}
+
+Rectangle SpriteHitboxFromMiddle(Sprite *sprite, Vector2 middlePoint) {
+    Dimensions dimensions = SpriteScaledDimensions(sprite);
+    return {
+        middlePoint.x - (dimensions.width / 2),
+        middlePoint.y - (dimensions.height / 2),
+        dimensions.width,
+        dimensions.height
+    };
+}
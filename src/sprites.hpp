@@ -0,0 +1,104 @@
+#pragma once
+
+#include <raylib.h>
+#include <string>
+
+#include "core.hpp"
+
+
+// The side of a sprite whose image couldn't be read, when loading the sprites without a window
+#define HEADLESS_SPRITE_SIDE    32
+
+
+typedef struct Sprite {
+    Texture2D atlas;    // The atlas page the sprite is in
+    Rectangle source;   // The sprite's region in the page
+    float scale;
+} Sprite;
+
+struct SpriteBank {
+
+    // TODO make it a hashmap
+
+    // Editor
+    Sprite Eraser;
+
+    // In Level
+    Sprite PlayerDefault;
+    Sprite PlayerWalking1;
+    Sprite PlayerWalking2;
+    Sprite PlayerRunning1;
+    Sprite PlayerRunning2;
+    Sprite PlayerSkidding;
+    Sprite PlayerJumpingUp;
+    Sprite PlayerJumpingDown;
+    Sprite PlayerGlideDefault1;
+    Sprite PlayerGlideDefault2;
+    Sprite PlayerGlideGliding1;
+    Sprite PlayerGlideGliding2;
+    Sprite PlayerSwinging;
+    Sprite PlayerSwingingForwards;
+    Sprite PlayerSwingingBackwards;
+    Sprite Enemy;
+    Sprite EnemyDummySpike;
+    Sprite EnemyDummySpikePoppingOut1;
+    Sprite EnemyDummySpikePoppingOut2;
+    Sprite EnemyDummySpikePoppingOut3;
+    Sprite EnemyDummySpikePoppedOut;
+    Sprite Block0Sides;
+    Sprite Block1Side;
+    Sprite Block2SidesOpp;
+    Sprite Block2SidesAdj;
+    Sprite Block3Sides;
+    Sprite Block4Sides;
+    Sprite Acid;
+    Sprite LevelEndOrb;
+    Sprite LevelCheckpointFlag;
+    Sprite LevelCheckpointPickup1;
+    Sprite LevelCheckpointPickup2;
+    Sprite LevelCheckpointPickup3;
+    Sprite MovingPlatform;
+    Sprite GlideItem;
+    Sprite TextboxButton;
+    Sprite TextboxDevButton;
+    Sprite TextboxButtonPlaying;
+    Sprite PrincessDefault1;
+    Sprite PrincessEditorIcon;
+    Sprite Coin1;
+    Sprite Coin2;
+    Sprite Coin3;
+
+    // Overworld
+    Sprite OverworldCursor;
+    Sprite LevelDot;
+    Sprite PathTileJoin;
+    Sprite PathTileStraight;
+    Sprite PathTileInL;
+
+};
+
+
+extern struct SpriteBank *SPRITES;
+
+
+// Takes in a sprite's image, filling in its atlas and source
+typedef void (*SpriteImageLoader)(Sprite *sprite, const std::string &imagePath);
+
+// Sets the scale of every sprite and hands its image to loadImage
+void SpritesInitialize(SpriteImageLoader loadImage);
+
+// Loads only the sprites' dimensions, read from their images' headers, without a window.
+// That's all the simulation needs of them, to make hitboxes.
+void SpritesInitializeHeadless();
+
+// Get a Sprite's dimensions, scaled
+Dimensions SpriteScaledDimensions(Sprite *sprite);
+
+// Get a sprite's middle point given its position
+Vector2 SpritePosMiddlePoint(Vector2 pos, Sprite *sprite);
+
+// Returns a hitbox in the shape of sprite.
+Rectangle SpriteHitboxFromEdge(Sprite *sprite, Vector2 origin);
+
+// Returns a hitbox in the shape of sprite, centered around middlePoint.
+Rectangle SpriteHitboxFromMiddle(Sprite *sprite, Vector2 middlePoint);
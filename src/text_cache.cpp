@@ -0,0 +1,133 @@
+#include <raylib.h>
+#include <algorithm>
+
+#include "text_cache.hpp"
+
+
+// The default font's glyph height, and the smallest size DrawText() draws in
+#define DEFAULT_FONT_SIZE   10
+
+
+namespace Render {
+
+
+TextRun TextLayout(std::string_view text, int fontSize) {
+
+    TextRun run = {};
+
+    Font font = GetFontDefault();
+    if (!font.texture.id) return run;
+
+    // The same as DrawText() and DrawTextEx()
+    if (fontSize < DEFAULT_FONT_SIZE) fontSize = DEFAULT_FONT_SIZE;
+    const float spacing = fontSize / DEFAULT_FONT_SIZE;
+    const float scaleFactor = (float) fontSize / font.baseSize;
+    const float padding = font.glyphPadding;
+
+    float offsetX = 0;
+    float offsetY = 0;
+    float width = 0;
+
+    run.glyphs.reserve(text.size());
+
+    for (size_t i = 0; i < text.size();) {
+
+        int byteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &byteCount);
+        int index = GetGlyphIndex(font, codepoint);
+
+        i += byteCount;
+
+        if (codepoint == '\n') {
+            offsetY += DRAW_TEXT_LINE_SPACING;
+            offsetX = 0;
+            continue;
+        }
+
+        if (codepoint != ' ' && codepoint != '\t') {
+
+            const Rectangle rec = font.recs[index];
+
+            run.glyphs.push_back({
+                { rec.x - padding, rec.y - padding, rec.width + 2 * padding, rec.height + 2 * padding },
+                {
+                    offsetX + font.glyphs[index].offsetX * scaleFactor - padding * scaleFactor,
+                    offsetY + font.glyphs[index].offsetY * scaleFactor - padding * scaleFactor,
+                    (rec.width + 2 * padding) * scaleFactor,
+                    (rec.height + 2 * padding) * scaleFactor
+                }
+            });
+        }
+
+        if (font.glyphs[index].advanceX == 0) offsetX += font.recs[index].width * scaleFactor + spacing;
+        else offsetX += font.glyphs[index].advanceX * scaleFactor + spacing;
+
+        width = std::max(width, offsetX - spacing);
+    }
+
+    run.size = { width, offsetY + fontSize };
+
+    return run;
+}
+
+void DrawTextRun(const TextRun &run, Vector2 pos, Color color) {
+
+    Texture2D texture = GetFontDefault().texture;
+
+    for (const GlyphQuad &glyph : run.glyphs) {
+
+        Rectangle dest = { pos.x + glyph.dest.x, pos.y + glyph.dest.y, glyph.dest.width, glyph.dest.height };
+
+        DrawTexturePro(texture, glyph.source, dest, { 0, 0 }, 0, color);
+    }
+}
+
+void TextCache::Draw(std::string_view text, int x, int y, int fontSize, Color color) {
+
+    DrawTextRun(Get(text, fontSize), { (float) x, (float) y }, color);
+}
+
+const TextRun &TextCache::Get(std::string_view text, int fontSize) {
+
+    TextMap &sized = texts[fontSize];
+
+    auto cached = sized.find(text);
+
+    if (cached == sized.end()) {
+        cached = sized.emplace(std::string(text), CachedText{ TextLayout(text, fontSize), frame }).first;
+        layoutCount++;
+    }
+
+    cached->second.lastUsedFrame = frame;
+
+    return cached->second.run;
+}
+
+void TextCache::EndFrame() {
+
+    frame++;
+
+    lastLayoutCount = layoutCount;
+    layoutCount = 0;
+
+    for (auto &[fontSize, sized] : texts) {
+        std::erase_if(sized, [&](const auto &entry) {
+            return frame - entry.second.lastUsedFrame > TEXT_CACHE_IDLE_FRAMES;
+        });
+    }
+}
+
+int TextCache::Count() {
+
+    int count = 0;
+    for (auto &[fontSize, sized] : texts) count += sized.size();
+
+    return count;
+}
+
+int TextCache::LastLayoutCount() {
+    return lastLayoutCount;
+}
+
+
+} // namespace
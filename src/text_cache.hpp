@@ -0,0 +1,90 @@
+#pragma once
+
+#include <raylib.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+// The space between lines of text, set with SetTextLineSpacing()
+#define DRAW_TEXT_LINE_SPACING  35
+
+// How many frames a text can go undrawn before it's dropped from the cache
+#define TEXT_CACHE_IDLE_FRAMES  120
+
+
+namespace Render {
+
+
+// A glyph of a laid out text: where it is in the font's texture, and where it's drawn relative to the text
+typedef struct GlyphQuad {
+    Rectangle source;
+    Rectangle dest;
+} GlyphQuad;
+
+// A text laid out in the default font, the same as DrawText() would, ready to be drawn
+typedef struct TextRun {
+    std::vector<GlyphQuad> glyphs;
+    Vector2 size;
+} TextRun;
+
+
+// Lays out the text in the font size. Without a window there's no font, and the text has no glyphs.
+TextRun TextLayout(std::string_view text, int fontSize);
+
+// Draws a laid out text with its top-left corner at pos
+void DrawTextRun(const TextRun &run, Vector2 pos, Color color);
+
+
+/*
+    Keeps the texts drawn recently already laid out, by content and font size, so drawing
+    a text that didn't change since the last frame doesn't lay it out again nor allocate.
+
+    The color isn't part of the key, as the glyphs are tinted when drawn.
+*/
+class TextCache {
+
+public:
+
+    // Draws the text like DrawText(), laying it out only if it's not in the cache
+    void Draw(std::string_view text, int x, int y, int fontSize, Color color);
+
+    // The text laid out, from the cache if it's there
+    const TextRun &Get(std::string_view text, int fontSize);
+
+    // Drops the texts that weren't drawn in a while. Called once per frame.
+    void EndFrame();
+
+    // How many texts are in the cache
+    int Count();
+
+    // How many texts had to be laid out in the last frame
+    int LastLayoutCount();
+
+private:
+
+    // So the texts can be looked up by a string_view, without making a string out of it
+    struct TextHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    typedef struct CachedText {
+        TextRun run;
+        long lastUsedFrame;
+    } CachedText;
+
+    typedef std::unordered_map<std::string, CachedText, TextHash, std::equal_to<>> TextMap;
+
+    // By font size
+    std::unordered_map<int, TextMap> texts;
+
+    long frame = 0;
+
+    int layoutCount = 0;
+    int lastLayoutCount = 0;
+};
+
+
+} // namespace